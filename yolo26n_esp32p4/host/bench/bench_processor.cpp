@@ -0,0 +1,201 @@
+// Host micro-benchmarks of the Yolo26Processor hot loops.
+//
+// Absolute numbers say nothing about the ESP32-P4; use them to compare variants of a loop
+// before flashing. Device timings come from the on-device benchmark mode (YOLO_BENCH records).
+
+#include "yolo_processor.hpp"
+#include "reference_decode.hpp"
+#include "synthetic_outputs.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+SyntheticOutputsConfig make_config(int size, dl::dtype_t dtype, float density) {
+    SyntheticOutputsConfig cfg;
+    cfg.input_size = size;
+    cfg.dtype = dtype;
+    cfg.density = density;
+    cfg.seed = 42;
+    if (dtype == dl::DATA_TYPE_INT16) {
+        int cls_exp[3] = {-11, -10, -12};
+        int box_exp[3] = {-12, -11, -10};
+        std::copy(cls_exp, cls_exp + 3, cfg.cls_exponent);
+        std::copy(box_exp, box_exp + 3, cfg.box_exponent);
+    }
+    return cfg;
+}
+
+// Density argument is in 1/1000 of the cells
+float density_arg(const benchmark::State& state) {
+    return state.range(0) / 1000.0f;
+}
+
+template <typename Processor, int Size, dl::dtype_t DType>
+void BM_Postprocess(benchmark::State& state) {
+    SyntheticOutputs s(make_config(Size, DType, density_arg(state)));
+    Processor processor;
+    processor.bind(s.get_inputs());
+    Detection out[YOLO_TARGET_K];
+    int n = 0;
+    for (auto _ : state) {
+        n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K);
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["dets"] = n;
+}
+
+// Threshold argument is in 1/100; 10% of cells hold a class logit
+void BM_PostprocessThreshold(benchmark::State& state) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.1f));
+    Yolo26Processor<512, 512, int8_t, 80> processor(YOLO_TARGET_K, state.range(0) / 100.0f);
+    processor.bind(s.get_inputs());
+    Detection out[YOLO_TARGET_K];
+    int n = 0;
+    for (auto _ : state) {
+        n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K);
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["dets"] = n;
+}
+
+// Scan split with the executor worker thread (host stand-in for the second core)
+void BM_PostprocessDualCore(benchmark::State& state) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, density_arg(state)));
+    Yolo26Executor executor;
+    executor.start();
+    Yolo26Processor<512, 512, int8_t, 80> processor;
+    processor.set_executor(&executor);
+    processor.bind(s.get_inputs());
+    Detection out[YOLO_TARGET_K];
+    int n = 0;
+    for (auto _ : state) {
+        n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K);
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["dets"] = n;
+}
+
+// With the duplicate suppression pass: cost should track K, not density
+void BM_PostprocessSuppress(benchmark::State& state) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, density_arg(state)));
+    Yolo26Processor<512, 512, int8_t, 80> processor;
+    processor.set_suppression(true);
+    processor.bind(s.get_inputs());
+    Detection out[YOLO_TARGET_K];
+    int n = 0;
+    for (auto _ : state) {
+        n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K);
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["dets"] = n;
+}
+
+void BM_PostprocessCompact(benchmark::State& state) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, density_arg(state)));
+    Yolo26Processor<512, 512, int8_t, 80> processor;
+    processor.bind(s.get_inputs());
+    DetectionQ out[YOLO_TARGET_K];
+    int n = 0;
+    for (auto _ : state) {
+        n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K);
+        benchmark::DoNotOptimize(out);
+    }
+    state.counters["dets"] = n;
+}
+
+void BM_PresenceQuery(benchmark::State& state) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, density_arg(state)));
+    Yolo26Processor<512, 512, int8_t, 80> processor;
+    processor.bind(s.get_inputs());
+    bool present = false;
+    for (auto _ : state) {
+        present = processor.query_presence(s.get_outputs());
+        benchmark::DoNotOptimize(present);
+    }
+    state.counters["present"] = present;
+    state.counters["cells"] = processor.get_last_scan_cells();
+}
+
+template <int Size, dl::dtype_t DType>
+void BM_PostprocessReference(benchmark::State& state) {
+    SyntheticOutputs s(make_config(Size, DType, density_arg(state)));
+    for (auto _ : state) {
+        auto dets = reference_postprocess(s.get_outputs(), Size, Size, YOLO_TARGET_K, YOLO_CONF_THRESH);
+        benchmark::DoNotOptimize(dets.data());
+    }
+}
+
+#define YOLO_BENCH_DENSITIES ->Arg(0)->Arg(1)->Arg(10)->Arg(100)
+
+BENCHMARK(BM_Postprocess<Yolo26Processor<>, 512, dl::DATA_TYPE_INT8>) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_Postprocess<Yolo26Processor<512, 512, int8_t, 80>, 512, dl::DATA_TYPE_INT8>) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_Postprocess<Yolo26Processor<>, 640, dl::DATA_TYPE_INT8>) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_Postprocess<Yolo26Processor<>, 320, dl::DATA_TYPE_INT8>) YOLO_BENCH_DENSITIES; // Generic loops
+BENCHMARK(BM_Postprocess<Yolo26Processor<>, 512, dl::DATA_TYPE_INT16>) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_PostprocessDualCore) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_PostprocessSuppress) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_PostprocessCompact) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_PresenceQuery) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_PostprocessThreshold)->ArgName("thresh%")->Arg(1)->Arg(10)->Arg(25)->Arg(50);
+BENCHMARK(BM_PostprocessReference<512, dl::DATA_TYPE_INT8>) YOLO_BENCH_DENSITIES;
+BENCHMARK(BM_PostprocessReference<512, dl::DATA_TYPE_INT16>) YOLO_BENCH_DENSITIES;
+
+void BM_Quantize(benchmark::State& state, Yolo26QuantizeFn fn) {
+    const size_t n = 512 * 512 * 3;
+    std::vector<uint8_t> src(n);
+    std::vector<int8_t> dst(n);
+    int8_t lut[256];
+    for (int p = 0; p < 256; p++) lut[p] = (int8_t)std::min(127, (int)std::round(p / 255.0f * 128.0f));
+    for (size_t i = 0; i < n; i++) src[i] = (uint8_t)(i * 167);
+    for (auto _ : state) {
+        fn(src.data(), dst.data(), n, lut);
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetBytesProcessed((int64_t)state.iterations() * n);
+}
+
+BENCHMARK_CAPTURE(BM_Quantize, lut, yolo26_quantize_lut);
+BENCHMARK_CAPTURE(BM_Quantize, swar, yolo26_quantize_swar);
+
+void BM_PreprocessRegion(benchmark::State& state) {
+    bool letterbox = state.range(0);
+    const int w = 1920, h = 1080;
+    std::vector<uint8_t> pixels((size_t)w * h * 3, 100);
+    dl::image::img_t frame = {pixels.data(), (uint16_t)w, (uint16_t)h, dl::image::DL_IMAGE_PIX_TYPE_RGB888};
+    dl::TensorBase input({1, 512, 512, 3}, nullptr, -7, dl::DATA_TYPE_INT8);
+    std::map<std::string, dl::TensorBase*> inputs{{"images", &input}};
+    Yolo26Processor<> processor;
+    processor.set_resize_mode(letterbox ? YOLO_RESIZE_LETTERBOX : YOLO_RESIZE_STRETCH);
+    for (auto _ : state) {
+        processor.preprocess_region(frame, {0, 0, w, h}, inputs);
+        benchmark::DoNotOptimize(input.data);
+    }
+}
+
+BENCHMARK(BM_PreprocessRegion)->ArgName("letterbox")->Arg(0)->Arg(1);
+
+// Same 1920x1080 -> 512 letterbox from a native camera frame (compare with BM_PreprocessRegion/1)
+void BM_PreprocessCamera(benchmark::State& state) {
+    const int w = 1920, h = 1080;
+    std::vector<uint8_t> bytes((size_t)w * h * 2);
+    for (size_t i = 0; i < bytes.size(); i++) bytes[i] = (uint8_t)(i * 167);
+    Yolo26CameraFrame frame;
+    frame.data = bytes.data();
+    frame.width = w;
+    frame.height = h;
+    frame.format = (Yolo26PixelFormat)state.range(0);
+    dl::TensorBase input({1, 512, 512, 3}, nullptr, -7, dl::DATA_TYPE_INT8);
+    std::map<std::string, dl::TensorBase*> inputs{{"images", &input}};
+    Yolo26Processor<> processor;
+    processor.set_resize_mode(YOLO_RESIZE_LETTERBOX);
+    for (auto _ : state) {
+        processor.preprocess(frame, inputs);
+        benchmark::DoNotOptimize(input.data);
+    }
+}
+
+BENCHMARK(BM_PreprocessCamera)->ArgName("format")->Arg(YOLO_PIX_RGB565_LE)->Arg(YOLO_PIX_UYVY);
+
+} // namespace
+
+BENCHMARK_MAIN();
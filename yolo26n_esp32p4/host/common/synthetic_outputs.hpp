@@ -0,0 +1,99 @@
+#pragma once
+#include "dl_tensor_base.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Seeded stand-ins for the six one2one_p*_box / one2one_p*_cls model outputs.
+//
+// Background cells hold logits in [-12, -4]. A `density` fraction of the cells gets one
+// foreground class in [-3, 8] and, half of the time, a runner-up class just below it.
+// Logits stay far from float sigmoid saturation so every distinct raw value keeps a distinct
+// score, which is what makes a bit-exact comparison against the reference decode meaningful.
+
+struct SyntheticOutputsConfig {
+    int input_size = 512;                   // Model input width = height
+    dl::dtype_t dtype = dl::DATA_TYPE_INT8;
+    int num_classes = 80;
+    float density = 0.01f;                  // Fraction of cells with a foreground class
+    uint32_t seed = 1;
+    int cls_exponent[3] = {-4, -3, -4};     // Per layer, as the quantizer might pick them
+    int box_exponent[3] = {-4, -3, -2};
+};
+
+class SyntheticOutputs {
+private:
+    std::vector<std::unique_ptr<dl::TensorBase>> owned;
+    std::map<std::string, dl::TensorBase*> outputs;
+    std::unique_ptr<dl::TensorBase> input;
+    std::map<std::string, dl::TensorBase*> inputs;
+    uint32_t rng;
+
+    uint32_t next() {
+        // xorshift32
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    float uniform(float lo, float hi) { return lo + (hi - lo) * (next() >> 8) * (1.0f / (1 << 24)); }
+
+    template <typename T>
+    static T quantize(float v, int exponent) {
+        float q = std::round(std::ldexp(v, -exponent));
+        q = std::min((float)std::numeric_limits<T>::max(), std::max((float)std::numeric_limits<T>::min(), q));
+        return (T)q;
+    }
+
+    template <typename T>
+    void fill(const SyntheticOutputsConfig& cfg) {
+        static const char* layer_names[3] = {"p3", "p4", "p5"};
+        static const int strides[3] = {8, 16, 32};
+        dl::dtype_t dtype = sizeof(T) == 1 ? dl::DATA_TYPE_INT8 : dl::DATA_TYPE_INT16;
+        uint32_t hit_below = (uint32_t)(cfg.density * 65536.0f);
+
+        for (int l = 0; l < 3; l++) {
+            int g = cfg.input_size / strides[l];
+            int nc = cfg.num_classes;
+            auto* box = new dl::TensorBase({1, g, g, 4}, nullptr, cfg.box_exponent[l], dtype);
+            auto* cls = new dl::TensorBase({1, g, g, nc}, nullptr, cfg.cls_exponent[l], dtype);
+            owned.emplace_back(box);
+            owned.emplace_back(cls);
+            outputs[std::string("one2one_") + layer_names[l] + "_box"] = box;
+            outputs[std::string("one2one_") + layer_names[l] + "_cls"] = cls;
+
+            T* b = (T*)box->data;
+            T* c = (T*)cls->data;
+            for (int i = 0; i < g * g; i++) {
+                for (int k = 0; k < nc; k++) c[i * nc + k] = quantize<T>(uniform(-12.0f, -4.0f), cls->exponent);
+                if ((next() & 0xFFFF) < hit_below) {
+                    int best = next() % nc;
+                    float logit = uniform(-3.0f, 8.0f);
+                    c[i * nc + best] = quantize<T>(logit, cls->exponent);
+                    if (next() & 1) c[i * nc + (best + 1 + next() % (nc - 1)) % nc] = quantize<T>(logit - 0.5f, cls->exponent);
+                }
+                for (int k = 0; k < 4; k++) b[i * 4 + k] = quantize<T>(uniform(0.0f, 6.0f), box->exponent);
+            }
+        }
+    }
+
+public:
+    explicit SyntheticOutputs(const SyntheticOutputsConfig& cfg) : rng(cfg.seed ? cfg.seed : 1) {
+        if (cfg.dtype == dl::DATA_TYPE_INT16) {
+            fill<int16_t>(cfg);
+        } else {
+            fill<int8_t>(cfg);
+        }
+        input.reset(new dl::TensorBase({1, cfg.input_size, cfg.input_size, 3}, nullptr, -7, dl::DATA_TYPE_INT8));
+        inputs["images"] = input.get();
+    }
+
+    const std::map<std::string, dl::TensorBase*>& get_outputs() const { return outputs; }
+    const std::map<std::string, dl::TensorBase*>& get_inputs() const { return inputs; }
+};
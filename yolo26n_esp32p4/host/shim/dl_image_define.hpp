@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Host shim: esp-dl image descriptors.
+
+namespace dl {
+namespace image {
+
+typedef enum {
+    DL_IMAGE_PIX_TYPE_RGB888 = 0,
+    DL_IMAGE_PIX_TYPE_BGR888,
+    DL_IMAGE_PIX_TYPE_RGB565LE,
+    DL_IMAGE_PIX_TYPE_RGB565BE,
+    DL_IMAGE_PIX_TYPE_GRAY,
+} pix_type_t;
+
+typedef struct {
+    void* data;
+    uint16_t width;
+    uint16_t height;
+    pix_type_t pix_type;
+} img_t;
+
+typedef struct {
+    void* data;
+    size_t data_len;
+} jpeg_img_t;
+
+inline size_t get_pix_byte_size(pix_type_t type) {
+    switch (type) {
+        case DL_IMAGE_PIX_TYPE_GRAY: return 1;
+        case DL_IMAGE_PIX_TYPE_RGB888:
+        case DL_IMAGE_PIX_TYPE_BGR888: return 3;
+        default: return 2;
+    }
+}
+
+inline size_t get_img_byte_size(const img_t& img) {
+    return (size_t)img.width * img.height * get_pix_byte_size(img.pix_type);
+}
+
+} // namespace image
+} // namespace dl
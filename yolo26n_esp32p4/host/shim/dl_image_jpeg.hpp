@@ -0,0 +1,15 @@
+#pragma once
+#include "dl_image_define.hpp"
+
+// Host shim: no JPEG decoder on the host. Decoding returns an empty image, which the
+// processor treats as a decode failure.
+
+namespace dl {
+namespace image {
+
+inline img_t sw_decode_jpeg(const jpeg_img_t&, pix_type_t type) {
+    return img_t{nullptr, 0, 0, type};
+}
+
+} // namespace image
+} // namespace dl
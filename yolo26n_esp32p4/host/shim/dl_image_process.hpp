@@ -0,0 +1,54 @@
+#pragma once
+#include "dl_image_define.hpp"
+#include <cstring>
+#include <vector>
+
+// Host shim: nearest-neighbour ImageTransformer (RGB888 only), enough for resize() on the host.
+// Not pixel-identical to esp-dl's implementation.
+
+namespace dl {
+namespace image {
+
+class ImageTransformer {
+private:
+    img_t src{};
+    img_t dst{};
+    std::vector<int> crop;
+
+public:
+    ImageTransformer& set_src_img(const img_t& img) {
+        src = img;
+        return *this;
+    }
+    ImageTransformer& set_dst_img(const img_t& img) {
+        dst = img;
+        return *this;
+    }
+    ImageTransformer& set_src_img_crop_area(const std::vector<int>& area) {
+        crop = area;
+        return *this;
+    }
+
+    int transform() {
+        int x0 = 0, y0 = 0, x1 = src.width, y1 = src.height;
+        if (crop.size() == 4) {
+            x0 = crop[0];
+            y0 = crop[1];
+            x1 = crop[2];
+            y1 = crop[3];
+        }
+        const uint8_t* s = (const uint8_t*)src.data;
+        uint8_t* d = (uint8_t*)dst.data;
+        for (int y = 0; y < dst.height; y++) {
+            int sy = y0 + y * (y1 - y0) / dst.height;
+            for (int x = 0; x < dst.width; x++) {
+                int sx = x0 + x * (x1 - x0) / dst.width;
+                memcpy(d + ((size_t)y * dst.width + x) * 3, s + ((size_t)sy * src.width + sx) * 3, 3);
+            }
+        }
+        return 0;
+    }
+};
+
+} // namespace image
+} // namespace dl
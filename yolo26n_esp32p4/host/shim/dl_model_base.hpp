@@ -0,0 +1,26 @@
+#pragma once
+#include "dl_tensor_base.hpp"
+#include <map>
+#include <string>
+
+// Host shim: the dl::Model calls made by Yolo26Pipeline. There is no network to load; tests
+// fill `inputs` / `outputs` with their own tensors and override run() (virtual here only) to
+// stand in for inference.
+
+namespace dl {
+
+class Model {
+public:
+    std::map<std::string, TensorBase*> inputs;
+    std::map<std::string, TensorBase*> outputs;
+
+    virtual ~Model() = default;
+
+    virtual void run(TensorBase* input) { (void)input; }
+    void run() { run(nullptr); } // On the tensors already in `inputs`
+
+    std::map<std::string, TensorBase*>& get_inputs() { return inputs; }
+    std::map<std::string, TensorBase*>& get_outputs() { return outputs; }
+};
+
+} // namespace dl
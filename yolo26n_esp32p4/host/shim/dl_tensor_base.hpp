@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Host shim: the subset of esp-dl's dl::TensorBase used by the YOLO26 headers.
+// Same member names and constructor signature; data is 16-byte aligned like on the device.
+
+namespace dl {
+
+typedef enum {
+    DATA_TYPE_FLOAT = 0,
+    DATA_TYPE_INT8,
+    DATA_TYPE_INT16,
+    DATA_TYPE_INT32,
+    DATA_TYPE_UINT8,
+} dtype_t;
+
+class TensorBase {
+public:
+    int size = 0;
+    std::vector<int> shape;
+    dtype_t dtype = DATA_TYPE_FLOAT;
+    int exponent = 0;
+    bool auto_free = true;
+    void* data = nullptr;
+    uint32_t caps = 0;
+
+    TensorBase() = default;
+
+    TensorBase(std::vector<int> shape_, const void* element, int exponent_ = 0, dtype_t dtype_ = DATA_TYPE_FLOAT,
+               bool deep = true, uint32_t caps_ = 0)
+        : shape(shape_), dtype(dtype_), exponent(exponent_), caps(caps_) {
+        size = 1;
+        for (int s : shape) size *= s;
+        if (!deep && element) {
+            data = (void*)element;
+            auto_free = false;
+            return;
+        }
+        size_t bytes = (size_t)get_bytes();
+        data = std::aligned_alloc(16, (bytes + 15) / 16 * 16);
+        if (element) {
+            memcpy(data, element, bytes);
+        } else {
+            memset(data, 0, bytes);
+        }
+    }
+
+    virtual ~TensorBase() {
+        if (auto_free) std::free(data);
+    }
+
+    TensorBase(const TensorBase&) = delete;
+    TensorBase& operator=(const TensorBase&) = delete;
+
+    int get_size() { return size; }
+    int get_dtype_bytes() {
+        switch (dtype) {
+            case DATA_TYPE_INT16: return 2;
+            case DATA_TYPE_FLOAT:
+            case DATA_TYPE_INT32: return 4;
+            default: return 1;
+        }
+    }
+    int get_bytes() { return size * get_dtype_bytes(); }
+    std::vector<int> get_shape() { return shape; }
+    dtype_t get_dtype() { return dtype; }
+    int get_exponent() { return exponent; }
+
+    template <typename T>
+    T* get_element_ptr() {
+        return (T*)data;
+    }
+};
+
+} // namespace dl
@@ -0,0 +1,13 @@
+#pragma once
+#include "esp_err.h"
+#include <cstddef>
+#include <cstdint>
+
+// Host shim: the UART driver calls of yolo_dump.hpp. Nothing is installed and writes fail.
+
+typedef int uart_port_t;
+
+inline bool uart_is_driver_installed(uart_port_t) { return false; }
+inline esp_err_t uart_driver_install(uart_port_t, int, int, int, void*, int) { return ESP_FAIL; }
+inline esp_err_t uart_set_baudrate(uart_port_t, uint32_t) { return ESP_FAIL; }
+inline int uart_write_bytes(uart_port_t, const void*, size_t) { return -1; }
@@ -0,0 +1,18 @@
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <cstdint>
+
+// Host shim: the USB-Serial-JTAG driver calls of yolo_dump.hpp. Nothing is installed and writes fail.
+
+typedef struct {
+    uint32_t tx_buffer_size;
+    uint32_t rx_buffer_size;
+} usb_serial_jtag_driver_config_t;
+
+#define USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT() {256, 256}
+
+inline bool usb_serial_jtag_is_driver_installed(void) { return false; }
+inline esp_err_t usb_serial_jtag_driver_install(usb_serial_jtag_driver_config_t*) { return ESP_FAIL; }
+inline int usb_serial_jtag_write_bytes(const void*, size_t, TickType_t) { return -1; }
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// Host shim: heap_caps_* on top of the C allocator. Capabilities are ignored and the
+// heap statistics read as zero.
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+#define MALLOC_CAP_CACHE_ALIGNED (1 << 14)
+
+typedef struct {
+    size_t total_free_bytes;
+    size_t total_allocated_bytes;
+    size_t largest_free_block;
+    size_t minimum_free_bytes;
+    size_t allocated_blocks;
+    size_t free_blocks;
+    size_t total_blocks;
+} multi_heap_info_t;
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return std::malloc(size); }
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t) { return std::calloc(n, size); }
+inline void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t) {
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+inline void* heap_caps_aligned_calloc(size_t alignment, size_t n, size_t size, uint32_t caps) {
+    void* p = heap_caps_aligned_alloc(alignment, n * size, caps);
+    if (p) memset(p, 0, n * size);
+    return p;
+}
+inline void heap_caps_free(void* p) { std::free(p); }
+
+inline size_t heap_caps_get_free_size(uint32_t) { return 0; }
+inline size_t heap_caps_get_minimum_free_size(uint32_t) { return 0; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 0; }
+inline size_t heap_caps_get_total_size(uint32_t) { return 0; }
+inline void heap_caps_get_info(multi_heap_info_t* info, uint32_t) { *info = multi_heap_info_t(); }
+inline int heap_caps_monitor_local_minimum_free_size_start(void) { return 0; }
+inline int heap_caps_monitor_local_minimum_free_size_stop(void) { return 0; }
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+// Host shim: esp_new_jpeg decoder API. Every open fails, so decode_preprocess_jpeg()
+// reports an error instead of decoding.
+
+typedef enum {
+    JPEG_ERR_OK = 0,
+    JPEG_ERR_FAIL = -1,
+} jpeg_error_t;
+
+typedef enum {
+    JPEG_PIXEL_FORMAT_GRAY = 0,
+    JPEG_PIXEL_FORMAT_RGB888,
+    JPEG_PIXEL_FORMAT_RGB565_LE,
+} jpeg_pixel_format_t;
+
+typedef enum {
+    JPEG_ROTATE_0D = 0,
+} jpeg_rotate_t;
+
+typedef struct {
+    jpeg_pixel_format_t output_type;
+    jpeg_rotate_t rotate;
+    bool block_enable;
+} jpeg_dec_config_t;
+
+#define DEFAULT_JPEG_DEC_CONFIG() {JPEG_PIXEL_FORMAT_RGB565_LE, JPEG_ROTATE_0D, false}
+
+typedef struct {
+    int width;
+    int height;
+} jpeg_dec_header_info_t;
+
+typedef struct {
+    uint8_t* inbuf;
+    int inbuf_len;
+    int inbuf_remain;
+    uint8_t* outbuf;
+    int out_size;
+} jpeg_dec_io_t;
+
+typedef void* jpeg_dec_handle_t;
+
+inline jpeg_error_t jpeg_dec_open(jpeg_dec_config_t*, jpeg_dec_handle_t*) { return JPEG_ERR_FAIL; }
+inline jpeg_error_t jpeg_dec_parse_header(jpeg_dec_handle_t, jpeg_dec_io_t*, jpeg_dec_header_info_t*) { return JPEG_ERR_FAIL; }
+inline jpeg_error_t jpeg_dec_get_outbuf_len(jpeg_dec_handle_t, int*) { return JPEG_ERR_FAIL; }
+inline jpeg_error_t jpeg_dec_get_process_count(jpeg_dec_handle_t, int*) { return JPEG_ERR_FAIL; }
+inline jpeg_error_t jpeg_dec_process(jpeg_dec_handle_t, jpeg_dec_io_t*) { return JPEG_ERR_FAIL; }
+inline jpeg_error_t jpeg_dec_close(jpeg_dec_handle_t) { return JPEG_ERR_OK; }
+
+inline void* jpeg_calloc_align(size_t size, int aligned) {
+    void* p = std::aligned_alloc(aligned, (size + aligned - 1) / aligned * aligned);
+    if (p) memset(p, 0, size);
+    return p;
+}
+inline void jpeg_free_align(void* p) { std::free(p); }
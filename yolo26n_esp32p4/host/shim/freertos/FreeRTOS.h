@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Host shim: the FreeRTOS types and macros used by the YOLO26 headers. Tasks are std::threads
+// and queues are mutex/condition-variable rings (queue.h), so the pipeline runs unmodified.
+// One tick is one millisecond.
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+typedef void* TaskHandle_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY ((TickType_t)0xffffffffu)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY 0x7fffffff
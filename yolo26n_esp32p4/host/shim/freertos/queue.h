@@ -0,0 +1,73 @@
+#pragma once
+#include "FreeRTOS.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// Host shim: FreeRTOS queues copying fixed-size items, with blocking timeouts. An item size
+// of 0 makes a semaphore (semphr.h), as in FreeRTOS itself.
+
+struct QueueDefinition {
+    std::mutex lock;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::vector<uint8_t> ring;
+    UBaseType_t capacity;
+    UBaseType_t item_size;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+};
+typedef QueueDefinition* QueueHandle_t;
+
+// Waits on `cv` until `ready()` or `ticks` elapse (portMAX_DELAY: forever)
+template <typename Ready>
+inline bool yolo26_shim_wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lk, TickType_t ticks, Ready ready) {
+    if (ticks == portMAX_DELAY) {
+        while (!ready()) cv.wait_for(lk, std::chrono::seconds(1)); // Timed waits only: no newer libstdc++ symbols
+        return true;
+    }
+    return cv.wait_for(lk, std::chrono::milliseconds(ticks), ready);
+}
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    QueueHandle_t q = new QueueDefinition;
+    q->capacity = length;
+    q->item_size = item_size;
+    q->ring.resize((size_t)length * item_size);
+    return q;
+}
+
+inline void vQueueDelete(QueueHandle_t q) { delete q; }
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lk(q->lock);
+    if (!yolo26_shim_wait(q->not_full, lk, ticks, [q] { return q->count < q->capacity; })) return pdFALSE;
+    if (q->item_size && item) {
+        memcpy(&q->ring[(size_t)((q->head + q->count) % q->capacity) * q->item_size], item, q->item_size);
+    }
+    q->count++;
+    q->not_empty.notify_one();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lk(q->lock);
+    if (!yolo26_shim_wait(q->not_empty, lk, ticks, [q] { return q->count > 0; })) return pdFALSE;
+    if (q->item_size && item) memcpy(item, &q->ring[(size_t)q->head * q->item_size], q->item_size);
+    q->head = (q->head + 1) % q->capacity;
+    q->count--;
+    q->not_full.notify_one();
+    return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> lk(q->lock);
+    return q->count;
+}
+
+inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) {
+    std::lock_guard<std::mutex> lk(q->lock);
+    return q->capacity - q->count;
+}
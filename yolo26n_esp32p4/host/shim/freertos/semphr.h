@@ -0,0 +1,18 @@
+#pragma once
+#include "queue.h"
+
+// Host shim: semaphores are item-less queues; the count is the number of queued items.
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return xQueueCreate(1, 0); }
+
+inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial) {
+    SemaphoreHandle_t s = xQueueCreate(max_count, 0);
+    s->count = initial;
+    return s;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) { return xQueueReceive(s, nullptr, ticks); }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { return xQueueSend(s, nullptr, 0); }
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { vQueueDelete(s); }
@@ -0,0 +1,18 @@
+#pragma once
+#include "FreeRTOS.h"
+#include <chrono>
+#include <thread>
+
+// Host shim: every task is a detached std::thread. Core affinity, priority and stack size are
+// ignored. A task ends when its function returns, so vTaskDelete(nullptr) has nothing to do.
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* arg, UBaseType_t,
+                                          TaskHandle_t* handle, BaseType_t) {
+    std::thread(fn, arg).detach();
+    if (handle) *handle = nullptr;
+    return pdPASS;
+}
+
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
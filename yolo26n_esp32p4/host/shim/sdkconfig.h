@@ -0,0 +1,3 @@
+#pragma once
+// Host build: no ESP-IDF target, so target-only paths (PIE kernels) compile out.
+#define CONFIG_YOLO_INPUT_SIZE 512
@@ -0,0 +1,82 @@
+#pragma once
+#include "dl_tensor_base.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+// Reference decode for the regression tests: the original, unoptimized postprocess() loop
+// (per-class sigmoid, float argmax, full sort). Yolo26Processor must reproduce it bit for bit.
+// Keep this file frozen; it is the spec, not an implementation to tune.
+
+struct ReferenceDetection {
+    float x1, y1, x2, y2;
+    float score;
+    int class_id;
+};
+
+inline std::vector<ReferenceDetection> reference_postprocess(const std::map<std::string, dl::TensorBase*>& outputs,
+                                                             int input_w, int input_h, int target_k, float conf_thresh) {
+    static const int strides[3] = {8, 16, 32};
+    static const char* layer_names[3] = {"p3", "p4", "p5"};
+    auto sigmoid = [](float x) { return 1.0f / (1.0f + std::exp(-x)); };
+
+    std::vector<ReferenceDetection> candidates;
+    float raw_thresh_float = -std::log(1.0f / conf_thresh - 1.0f);
+
+    for (int i = 0; i < 3; i++) {
+        dl::TensorBase* box = outputs.at(std::string("one2one_") + layer_names[i] + "_box");
+        dl::TensorBase* cls = outputs.at(std::string("one2one_") + layer_names[i] + "_cls");
+        int stride = strides[i];
+        int grid_h = input_h / stride;
+        int grid_w = input_w / stride;
+        int num_classes = cls->shape[3];
+        bool is_int8 = box->dtype == dl::DATA_TYPE_INT8;
+
+        float box_scale = std::pow(2.0f, box->exponent);
+        float cls_scale = std::pow(2.0f, cls->exponent);
+        int8_t cls_thresh_int8 = (int8_t)std::floor(raw_thresh_float / cls_scale);
+
+        for (int h = 0; h < grid_h; h++) {
+            for (int w = 0; w < grid_w; w++) {
+                int pixel_idx = h * grid_w + w;
+                int cls_offset = pixel_idx * num_classes;
+
+                float max_score = -1.0f;
+                int best_cls_id = -1;
+                for (int c = 0; c < num_classes; c++) {
+                    float raw_val;
+                    if (is_int8) {
+                        int8_t raw = ((int8_t*)cls->data)[cls_offset + c];
+                        if (raw <= cls_thresh_int8) continue;
+                        raw_val = raw * cls_scale;
+                    } else {
+                        raw_val = ((int16_t*)cls->data)[cls_offset + c] * cls_scale;
+                    }
+                    float score = sigmoid(raw_val);
+                    if (score > max_score) {
+                        max_score = score;
+                        best_cls_id = c;
+                    }
+                }
+                if (max_score < conf_thresh) continue;
+
+                float d[4];
+                for (int k = 0; k < 4; k++) {
+                    d[k] = is_int8 ? ((int8_t*)box->data)[pixel_idx * 4 + k] * box_scale
+                                   : ((int16_t*)box->data)[pixel_idx * 4 + k] * box_scale;
+                }
+                float cx = w + 0.5f;
+                float cy = h + 0.5f;
+                candidates.push_back({(cx - d[0]) * stride, (cy - d[1]) * stride, (cx + d[2]) * stride,
+                                      (cy + d[3]) * stride, max_score, best_cls_id});
+            }
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const ReferenceDetection& a, const ReferenceDetection& b) { return a.score > b.score; });
+    if ((int)candidates.size() > target_k) candidates.resize(std::max(target_k, 0));
+    return candidates;
+}
@@ -0,0 +1,73 @@
+// Yolo26Escalation: when the switching demo moves between the 512 and 640 models.
+
+#include "yolo_escalation.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+Detection det(float score) {
+    return {0.0f, 0.0f, 10.0f, 10.0f, score, 0};
+}
+
+TEST(Escalation, CertainFramesStayLow) {
+    Yolo26Escalation esc;
+    Detection sure[] = {det(0.90f), det(0.60f)};
+    EXPECT_FALSE(esc.update(sure, 2));
+    EXPECT_FALSE(esc.update(nullptr, 0)); // Empty scene
+    EXPECT_EQ(esc.get_level(), 0);
+}
+
+TEST(Escalation, UncertainDetectionEscalatesAndHolds) {
+    Yolo26EscalationConfig cfg;
+    cfg.decision_thresh = 0.30f;
+    cfg.margin = 0.10f;
+    cfg.hold_frames = 3;
+    Yolo26Escalation esc(cfg);
+    Detection borderline[] = {det(0.90f), det(0.27f)};
+    Detection sure[] = {det(0.90f)};
+
+    EXPECT_TRUE(esc.update(borderline, 2)); // Re-run this frame at level 1
+    EXPECT_EQ(esc.get_level(), 1);
+    EXPECT_FALSE(esc.update(borderline, 2)); // Already high: no re-run
+    EXPECT_FALSE(esc.update(sure, 1));
+    EXPECT_FALSE(esc.update(sure, 1));
+    EXPECT_EQ(esc.get_level(), 1);
+    EXPECT_FALSE(esc.update(borderline, 2)); // Uncertain again: hold restarts
+    EXPECT_FALSE(esc.update(sure, 1));
+    EXPECT_FALSE(esc.update(sure, 1));
+    EXPECT_EQ(esc.get_level(), 1);
+    EXPECT_FALSE(esc.update(sure, 1));
+    EXPECT_EQ(esc.get_level(), 0);
+}
+
+TEST(Escalation, MarginBoundary) {
+    Yolo26EscalationConfig cfg;
+    cfg.decision_thresh = 0.50f;
+    cfg.margin = 0.25f;
+    Yolo26Escalation esc(cfg);
+    Detection at_edge[] = {det(0.75f)};
+    Detection below_edge[] = {det(0.7499f)};
+    Detection band_floor[] = {det(0.25f)};
+    Detection under_floor[] = {det(0.2499f)};
+    EXPECT_FALSE(esc.is_uncertain(at_edge, 1));
+    EXPECT_TRUE(esc.is_uncertain(below_edge, 1));
+    EXPECT_TRUE(esc.is_uncertain(band_floor, 1));
+    EXPECT_FALSE(esc.is_uncertain(under_floor, 1));
+}
+
+TEST(Escalation, TopKTailDoesNotEscalate) {
+    // What the demo's top-32 list looks like at YOLO_CONF_THRESH 0.10: a few confident
+    // detections, the rest a tail of weak scores just above the floor
+    std::vector<Detection> top_k = {det(0.91f), det(0.84f), det(0.62f)};
+    for (int i = 0; (int)top_k.size() < 32; i++) top_k.push_back(det(0.19f - 0.003f * i));
+    ASSERT_GE(top_k.back().score, 0.10f);
+
+    Yolo26Escalation esc;
+    for (int f = 0; f < 20; f++) {
+        EXPECT_FALSE(esc.update(top_k.data(), (int)top_k.size()));
+        EXPECT_EQ(esc.get_level(), 0);
+    }
+}
+
+} // namespace
@@ -0,0 +1,104 @@
+// Streaming pipeline shutdown: stop() must return while gated frames fill the bounded queues.
+// Runs the real Yolo26PipelineT on the host FreeRTOS shim with a stand-in processor and model.
+
+#include "yolo_pipeline.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <thread>
+
+namespace {
+
+// Every frame has the same luma signature, so the motion gate lets only the first through.
+struct StaticSceneProcessor {
+    dl::image::img_t decode_jpeg(const uint8_t*, size_t) { return {}; }
+    dl::image::img_t resize(dl::image::img_t&, const std::map<std::string, dl::TensorBase*>&, Yolo26Transform* = nullptr) { return {}; }
+    void preprocess(const dl::image::img_t&, const std::map<std::string, dl::TensorBase*>&) {}
+    bool decode_preprocess_jpeg(const uint8_t*, size_t, const std::map<std::string, dl::TensorBase*>&, Yolo26Transform*,
+                                Yolo26LumaSignature* motion) {
+        if (motion) {
+            memset(motion->luma, 128, sizeof(motion->luma));
+            motion->valid = true;
+        }
+        return true;
+    }
+    std::vector<Detection> postprocess(const std::map<std::string, dl::TensorBase*>&, const Yolo26Transform* = nullptr) { return {}; }
+};
+
+struct SlowModel : dl::Model {
+    dl::TensorBase input{{1, 8, 8, 3}, nullptr, 0, dl::DATA_TYPE_INT8};
+    std::atomic<int> runs{0};
+
+    SlowModel() { inputs["images"] = &input; }
+
+    void run(dl::TensorBase*) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        runs++;
+    }
+};
+
+struct Harness {
+    const uint8_t jpg[4] = {0xFF, 0xD8, 0xFF, 0xD9};
+    std::atomic<int> published{0};
+    std::atomic<int> cached{0};
+};
+
+bool capture(Yolo26CapturedFrame* frame, void* ctx) {
+    Harness* h = static_cast<Harness*>(ctx);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    *frame = {h->jpg, sizeof(h->jpg), nullptr};
+    return true;
+}
+
+// A slow consumer (e.g. a network link) so the queues behind postprocess fill up
+void publish(const Yolo26PipelineResult& result, void* ctx) {
+    Harness* h = static_cast<Harness*>(ctx);
+    h->published++;
+    if (result.cached) h->cached++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+}
+
+// stop() hangs forever on a deadlock: run it on its own thread and give up after `ms`
+template <typename Pipeline>
+bool stops_within(Pipeline& pipeline, int ms) {
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> stopped = done->get_future();
+    std::thread([&pipeline, done] {
+        pipeline.stop();
+        done->set_value();
+    }).detach();
+    return stopped.wait_for(std::chrono::milliseconds(ms)) == std::future_status::ready;
+}
+
+} // namespace
+
+TEST(Pipeline, StopWhileGated) {
+    SlowModel model;
+    StaticSceneProcessor processor;
+    Harness harness;
+    Yolo26PipelineConfig cfg;
+    cfg.capture = capture;
+    cfg.publish = publish;
+    cfg.user_ctx = &harness;
+    cfg.motion_gate = true;
+    cfg.motion.max_stale_ms = 0;
+
+    Yolo26PipelineT<StaticSceneProcessor> pipeline(&model, processor, cfg);
+    for (int round = 0; round < 2; round++) {
+        ASSERT_TRUE(pipeline.start());
+        std::this_thread::sleep_for(std::chrono::milliseconds(600));
+        if (!stops_within(pipeline, 5000)) {
+            // The stage tasks still reference the pipeline: it cannot be destroyed
+            fprintf(stderr, "stop() did not return (round %d)\n", round);
+            fflush(stderr);
+            std::_Exit(1);
+        }
+        EXPECT_FALSE(pipeline.is_running());
+    }
+
+    EXPECT_EQ(model.runs.load(), 1);   // Only the first frame differs from the (empty) reference
+    EXPECT_GT(harness.cached.load(), 0);
+    Yolo26PipelineStats stats = pipeline.get_stats();
+    EXPECT_GT(stats.motion_skipped, (uint32_t)YOLO_PIPELINE_INPUT_BUFFERS + 1); // Enough to fill infer_q and post_q
+}
@@ -0,0 +1,613 @@
+// Bit-exact regression of Yolo26Processor::postprocess() against the reference decode.
+
+#include "yolo_processor.hpp"
+#include "reference_decode.hpp"
+#include "synthetic_outputs.hpp"
+#include <gtest/gtest.h>
+#include <tuple>
+
+namespace {
+
+bool same_detection(const Detection& a, const ReferenceDetection& b) {
+    return a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2 && a.score == b.score && a.class_id == b.class_id;
+}
+
+/**
+ * Equal scores may be ranked differently (heap vs stable sort), so at the K-th score the two
+ * may keep different cells. Everything else must match exactly: count, score at every rank,
+ * and every returned detection must be one the reference decoded, field for field.
+ */
+void expect_matches_reference(const std::vector<Detection>& got, const std::map<std::string, dl::TensorBase*>& outputs,
+                              int input_size, int k, float thresh) {
+    std::vector<ReferenceDetection> all = reference_postprocess(outputs, input_size, input_size, 1 << 30, thresh);
+    size_t expected = std::min(all.size(), (size_t)std::max(k, 0));
+    ASSERT_EQ(got.size(), expected);
+    for (size_t i = 0; i < got.size(); i++) {
+        ASSERT_EQ(got[i].score, all[i].score) << "rank " << i;
+        bool found = false;
+        for (const ReferenceDetection& r : all) {
+            if (r.score == got[i].score && same_detection(got[i], r)) {
+                found = true;
+                break;
+            }
+        }
+        ASSERT_TRUE(found) << "rank " << i << " class " << got[i].class_id << " not decoded by the reference";
+    }
+}
+
+template <typename Processor>
+std::vector<Detection> run(Processor& processor, const SyntheticOutputs& s) {
+    EXPECT_TRUE(processor.bind(s.get_inputs()));
+    return processor.postprocess(s.get_outputs());
+}
+
+SyntheticOutputsConfig make_config(int size, dl::dtype_t dtype, float density, uint32_t seed) {
+    SyntheticOutputsConfig cfg;
+    cfg.input_size = size;
+    cfg.dtype = dtype;
+    cfg.density = density;
+    cfg.seed = seed;
+    if (dtype == dl::DATA_TYPE_INT16) {
+        int cls_exp[3] = {-11, -10, -12};
+        int box_exp[3] = {-12, -11, -10};
+        std::copy(cls_exp, cls_exp + 3, cfg.cls_exponent);
+        std::copy(box_exp, box_exp + 3, cfg.box_exponent);
+    }
+    return cfg;
+}
+
+// size, dtype, K, threshold, density
+using DecodeParam = std::tuple<int, dl::dtype_t, int, float, float>;
+
+class PostprocessReference : public ::testing::TestWithParam<DecodeParam> {};
+
+TEST_P(PostprocessReference, FacadeMatchesReference) {
+    auto [size, dtype, k, thresh, density] = GetParam();
+    for (uint32_t seed = 1; seed <= 3; seed++) {
+        SyntheticOutputs s(make_config(size, dtype, density, seed));
+        Yolo26Processor<> processor(k, thresh);
+        expect_matches_reference(run(processor, s), s.get_outputs(), size, k, thresh);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Shapes, PostprocessReference,
+    ::testing::Combine(::testing::Values(512, 640, 320), // 320: generic (non-specialized) loops
+                       ::testing::Values(dl::DATA_TYPE_INT8, dl::DATA_TYPE_INT16),
+                       ::testing::Values(1, 3, 32, 300),
+                       ::testing::Values(0.10f, 0.45f),
+                       ::testing::Values(0.0f, 0.01f, 0.2f)));
+
+TEST(Postprocess, StaticSpecializationMatchesFacade) {
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        SyntheticOutputs s512(make_config(512, dl::DATA_TYPE_INT8, 0.05f, seed));
+        Yolo26Processor<> facade512;
+        Yolo26Processor<512, 512, int8_t, 80> static512;
+        auto a = run(facade512, s512);
+        auto b = run(static512, s512);
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); i++) ASSERT_EQ(0, memcmp(&a[i], &b[i], sizeof(Detection)));
+
+        SyntheticOutputs s640(make_config(640, dl::DATA_TYPE_INT16, 0.05f, seed));
+        Yolo26Processor<> facade640;
+        Yolo26Processor<640, 640, int16_t, 80> static640;
+        a = run(facade640, s640);
+        b = run(static640, s640);
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); i++) ASSERT_EQ(0, memcmp(&a[i], &b[i], sizeof(Detection)));
+    }
+}
+
+TEST(Postprocess, NonCocoClassCount) {
+    SyntheticOutputsConfig cfg = make_config(512, dl::DATA_TYPE_INT8, 0.05f, 7);
+    cfg.num_classes = 21; // Not a multiple of the SWAR group: exercises the scalar tail
+    SyntheticOutputs s(cfg);
+    Yolo26Processor<> processor(32, 0.10f);
+    expect_matches_reference(run(processor, s), s.get_outputs(), 512, 32, 0.10f);
+}
+
+TEST(Postprocess, WideExponentSpreadMatchesReference) {
+    // Class exponents 10 apart do not fit 32-bit keys: the int8 scan falls back to 64-bit keys
+    SyntheticOutputsConfig cfg = make_config(512, dl::DATA_TYPE_INT8, 0.05f, 9);
+    int cls_exp[3] = {-2, -12, -5};
+    std::copy(cls_exp, cls_exp + 3, cfg.cls_exponent);
+    SyntheticOutputs s(cfg);
+    for (int k : {1, 32, 300}) {
+        for (float thresh : {0.10f, 0.45f}) {
+            Yolo26Processor<> processor(k, thresh);
+            expect_matches_reference(run(processor, s), s.get_outputs(), 512, k, thresh);
+        }
+    }
+}
+
+TEST(Postprocess, CandidateKeysOrderAndRoundTrip) {
+    // Higher score first; on equal scores the earlier anchor (layer, then cell) wins
+    EXPECT_GT(yolo26_key32(5, 2, 399), yolo26_key32(4, 0, 0));
+    EXPECT_GT(yolo26_key32(-3, 0, 10), yolo26_key32(-4, 0, 10));
+    EXPECT_GT(yolo26_key32(7, 0, 4095), yolo26_key32(7, 1, 0));
+    EXPECT_GT(yolo26_key32(7, 1, 3), yolo26_key32(7, 1, 4));
+    uint32_t k32 = yolo26_key32(-128 << 8, 2, (1 << YOLO_KEY_CELL_BITS) - 1);
+    EXPECT_EQ(yolo26_key32_norm(k32), -128 << 8);
+    EXPECT_EQ(yolo26_key32_layer(k32), 2);
+    EXPECT_EQ(yolo26_key32_cell(k32), (1 << YOLO_KEY_CELL_BITS) - 1);
+
+    EXPECT_GT(yolo26_key64(0.25f, 2, 0), yolo26_key64(-0.25f, 0, 0));
+    EXPECT_GT(yolo26_key64(-0.25f, 2, 0), yolo26_key64(-0.5f, 0, 0));
+    EXPECT_GT(yolo26_key64(3.0f, 0, 100000), yolo26_key64(3.0f, 1, 0));
+    uint64_t k64 = yolo26_key64(-1.375f, 1, 123456);
+    EXPECT_EQ(yolo26_key64_logit(k64), -1.375f);
+    EXPECT_EQ(yolo26_key64_layer(k64), 1);
+    EXPECT_EQ(yolo26_key64_cell(k64), 123456);
+}
+
+TEST(Postprocess, LowerThresholdKeepsSameTopK) {
+    // Dense frame: more than K cells clear both thresholds, so the K best are the same
+    SyntheticOutputs s(make_config(640, dl::DATA_TYPE_INT8, 0.2f, 4));
+    Yolo26Processor<> strict(32, 0.45f);
+    Yolo26Processor<> loose(32, 0.01f);
+    auto a = run(strict, s);
+    auto b = run(loose, s);
+    ASSERT_EQ(a.size(), 32u);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) EXPECT_EQ(0, memcmp(&a[i], &b[i], sizeof(Detection)));
+}
+
+// Brute force of the class-rule semantics: a cell's candidate is its best allowed class,
+// kept if that class clears its own threshold. Int8 only.
+std::vector<ReferenceDetection> reference_class_rules(const std::map<std::string, dl::TensorBase*>& outputs, int size,
+                                                      int k, const std::vector<float>& conf, const std::vector<int>& allowed) {
+    static const int strides[3] = {8, 16, 32};
+    static const char* names[3] = {"p3", "p4", "p5"};
+    std::vector<ReferenceDetection> all;
+    for (int l = 0; l < 3; l++) {
+        dl::TensorBase* box = outputs.at(std::string("one2one_") + names[l] + "_box");
+        dl::TensorBase* cls = outputs.at(std::string("one2one_") + names[l] + "_cls");
+        float box_scale = std::pow(2.0f, box->exponent);
+        float cls_scale = std::pow(2.0f, cls->exponent);
+        int grid = size / strides[l];
+        int nc = cls->shape[3];
+        for (int cell = 0; cell < grid * grid; cell++) {
+            const int8_t* row = (const int8_t*)cls->data + cell * nc;
+            int best = allowed[0];
+            for (int c : allowed) {
+                if (row[c] > row[best]) best = c;
+            }
+            float t = std::floor(-std::log(1.0f / conf[best] - 1.0f) / cls_scale);
+            float score = 1.0f / (1.0f + std::exp(-(row[best] * cls_scale)));
+            if (row[best] <= t || score < conf[best]) continue;
+            const int8_t* d = (const int8_t*)box->data + cell * 4;
+            float cx = cell % grid + 0.5f, cy = cell / grid + 0.5f;
+            int s = strides[l];
+            all.push_back({(cx - d[0] * box_scale) * s, (cy - d[1] * box_scale) * s, (cx + d[2] * box_scale) * s,
+                           (cy + d[3] * box_scale) * s, score, best});
+        }
+    }
+    std::stable_sort(all.begin(), all.end(), [](const ReferenceDetection& a, const ReferenceDetection& b) { return a.score > b.score; });
+    if ((int)all.size() > k) all.resize(k);
+    return all;
+}
+
+void expect_same(const std::vector<Detection>& got, const std::vector<ReferenceDetection>& ref) {
+    ASSERT_EQ(got.size(), ref.size());
+    for (size_t i = 0; i < got.size(); i++) {
+        EXPECT_TRUE(same_detection(got[i], ref[i])) << "rank " << i << " class " << got[i].class_id << " vs " << ref[i].class_id;
+    }
+}
+
+TEST(Postprocess, UniformClassThresholdsMatchGlobal) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 2));
+    Yolo26Processor<> plain(32, 0.2f);
+    Yolo26Processor<> ruled(32, 0.2f);
+    std::vector<float> conf(80, 0.2f);
+    ruled.set_class_thresholds(conf.data(), (int)conf.size());
+    auto a = run(plain, s);
+    auto b = run(ruled, s);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) EXPECT_EQ(0, memcmp(&a[i], &b[i], sizeof(Detection)));
+}
+
+TEST(Postprocess, ClassRulesMatchBruteForce) {
+    const int person = 0, bicycle = 1, car = 2;
+    for (int size : {512, 320}) {
+        for (float density : {0.01f, 0.2f}) {
+            SyntheticOutputs s(make_config(size, dl::DATA_TYPE_INT8, density, 6));
+            for (int k : {3, 32, 300}) {
+                SCOPED_TRACE("size " + std::to_string(size) + " density " + std::to_string(density) + " k " + std::to_string(k));
+                Yolo26Processor<> processor(k, 0.10f);
+
+                // Few allowed classes: sparse scan
+                std::vector<int> few = {person, bicycle, car};
+                std::vector<float> conf(80, 0.10f);
+                conf[person] = 0.99f; // Above most person cells: they must not crowd out weaker bicycles
+                conf[car] = 0.9f;
+                processor.set_allowed_classes(few.data(), (int)few.size());
+                processor.set_class_threshold(person, 0.99f);
+                processor.set_class_threshold(car, 0.9f);
+                expect_same(run(processor, s), reference_class_rules(s.get_outputs(), size, k, conf, few));
+
+                // Many allowed classes: SWAR lanes with per-class thresholds
+                std::vector<int> many;
+                for (int c = 0; c < 80; c += 2) many.push_back(c);
+                processor.set_allowed_classes(many.data(), (int)many.size());
+                expect_same(run(processor, s), reference_class_rules(s.get_outputs(), size, k, conf, many));
+
+                // Cleared: back to the plain decode
+                processor.clear_class_rules();
+                expect_matches_reference(run(processor, s), s.get_outputs(), size, k, 0.10f);
+            }
+        }
+    }
+}
+
+TEST(Postprocess, EmptyAllowListReportsNothing) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.2f, 3));
+    Yolo26Processor<> processor;
+    int bogus = -1;
+    processor.set_allowed_classes(&bogus, 1);
+    EXPECT_TRUE(run(processor, s).empty());
+}
+
+TEST(Postprocess, ClassRulesInt16) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT16, 0.05f, 8));
+    Yolo26Processor<> processor(32, 0.10f);
+    int ids[] = {0, 2, 5, 7};
+    processor.set_allowed_classes(ids, 4);
+    processor.set_class_threshold(2, 0.6f);
+    auto got = run(processor, s);
+    ASSERT_FALSE(got.empty());
+    for (const Detection& d : got) {
+        EXPECT_TRUE(d.class_id == 0 || d.class_id == 2 || d.class_id == 5 || d.class_id == 7);
+        EXPECT_GE(d.score, d.class_id == 2 ? 0.6f : 0.10f);
+    }
+    for (size_t i = 1; i < got.size(); i++) EXPECT_GE(got[i - 1].score, got[i].score);
+}
+
+void expect_identical(const std::vector<Detection>& a, const std::vector<Detection>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) EXPECT_EQ(0, memcmp(&a[i], &b[i], sizeof(Detection))) << "rank " << i;
+}
+
+// Per-core partial heaps merged after the scan: the same K keys, so the same output, rank for rank
+TEST(Postprocess, DualCoreMatchesSingleCore) {
+    Yolo26Executor executor;
+    ASSERT_TRUE(executor.start());
+    for (int size : {512, 640, 320}) {
+        for (dl::dtype_t dtype : {dl::DATA_TYPE_INT8, dl::DATA_TYPE_INT16}) {
+            for (float density : {0.0f, 0.01f, 0.2f}) {
+                SyntheticOutputs s(make_config(size, dtype, density, 4));
+                for (int k : {1, 32, 300}) {
+                    SCOPED_TRACE("size " + std::to_string(size) + " density " + std::to_string(density) + " k " + std::to_string(k));
+                    Yolo26Processor<> single(k, 0.10f);
+                    Yolo26Processor<> dual(k, 0.10f);
+                    dual.set_executor(&executor);
+                    expect_identical(run(single, s), run(dual, s));
+
+                    int ids[] = {0, 1, 2};
+                    single.set_allowed_classes(ids, 3);
+                    dual.set_allowed_classes(ids, 3);
+                    single.set_class_threshold(0, 0.6f);
+                    dual.set_class_threshold(0, 0.6f);
+                    expect_identical(run(single, s), run(dual, s));
+                }
+            }
+        }
+    }
+}
+
+TEST(Postprocess, DualCoreStaticSpecialization) {
+    Yolo26Executor executor;
+    ASSERT_TRUE(executor.start());
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 9));
+    Yolo26Processor<512, 512, int8_t, 80> single(32, 0.10f);
+    Yolo26Processor<512, 512, int8_t, 80> dual(32, 0.10f);
+    dual.set_executor(&executor);
+    auto a = run(single, s);
+    ASSERT_EQ((int)a.size(), 32);
+    expect_identical(a, run(dual, s));
+    executor.stop(); // A stopped executor runs both parts on the caller
+    expect_identical(a, run(dual, s));
+}
+
+// Float greedy suppression over the same integer-rounded boxes, the obvious O(K^2) way
+std::vector<Detection> reference_suppress(const std::vector<Detection>& dets, float iou) {
+    std::vector<Detection> kept;
+    for (const Detection& d : dets) {
+        bool dup = false;
+        for (const Detection& k : kept) {
+            if (k.class_id != d.class_id) continue;
+            float ax1 = std::lround(k.x1), ay1 = std::lround(k.y1), ax2 = std::lround(k.x2), ay2 = std::lround(k.y2);
+            float bx1 = std::lround(d.x1), by1 = std::lround(d.y1), bx2 = std::lround(d.x2), by2 = std::lround(d.y2);
+            float iw = std::min(ax2, bx2) - std::max(ax1, bx1), ih = std::min(ay2, by2) - std::max(ay1, by1);
+            if (iw <= 0 || ih <= 0) continue;
+            double inter = (double)iw * ih;
+            double uni = (double)(ax2 - ax1) * (ay2 - ay1) + (double)(bx2 - bx1) * (by2 - by1) - inter;
+            if (inter > iou * uni) {
+                dup = true;
+                break;
+            }
+        }
+        if (!dup) kept.push_back(d);
+    }
+    return kept;
+}
+
+TEST(Suppress, HandBuiltDuplicates) {
+    Detection dets[] = {
+        {10, 10, 110, 110, 0.9f, 0},  // kept
+        {12, 12, 112, 112, 0.8f, 0},  // duplicate of the first
+        {12, 12, 112, 112, 0.7f, 1},  // same place, other class: kept
+        {200, 10, 300, 110, 0.6f, 0}, // elsewhere: kept
+        {60, 10, 160, 110, 0.5f, 0},  // IoU 1/3 with the first: kept
+    };
+    Yolo26SuppressorT<Detection> sup;
+    sup.reserve(8);
+    int n = sup.run(dets, 5, yolo26_suppress_iou_num(0.5f));
+    ASSERT_EQ(n, 4);
+    EXPECT_EQ(dets[0].score, 0.9f);
+    EXPECT_EQ(dets[1].score, 0.7f);
+    EXPECT_EQ(dets[2].score, 0.6f);
+    EXPECT_EQ(dets[3].score, 0.5f);
+}
+
+TEST(Suppress, ChainKeepsThirdBox) {
+    // B overlaps A and C, A and C do not overlap: B is removed by A, so C survives
+    Detection dets[] = {{0, 0, 100, 100, 0.9f, 0}, {20, 0, 120, 100, 0.8f, 0}, {40, 0, 140, 100, 0.7f, 0}};
+    Yolo26SuppressorT<Detection> sup;
+    sup.reserve(3);
+    EXPECT_EQ(sup.run(dets, 3, yolo26_suppress_iou_num(0.6f)), 2);
+    EXPECT_EQ(dets[1].score, 0.7f);
+}
+
+TEST(Postprocess, SuppressionMatchesFloatReference) {
+    for (float density : {0.01f, 0.2f}) {
+        SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, density, 12));
+        for (int k : {32, 300}) {
+            for (float iou : {0.3f, 0.7f}) {
+                Yolo26Processor<> plain(k, 0.10f), suppressed(k, 0.10f);
+                suppressed.set_suppression(true, iou);
+                std::vector<Detection> all = run(plain, s);
+                std::vector<Detection> got = run(suppressed, s);
+                expect_identical(got, reference_suppress(all, yolo26_suppress_iou_num(iou) / (float)YOLO_SUPPRESS_IOU_DEN));
+
+                suppressed.set_suppression(false); // Runtime toggle: back to the plain list
+                expect_identical(run(suppressed, s), all);
+            }
+        }
+    }
+}
+
+TEST(Postprocess, IntoIsPrefixOfVector) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 3));
+    Yolo26Processor<> processor;
+    auto full = run(processor, s);
+    ASSERT_EQ((int)full.size(), YOLO_TARGET_K);
+
+    Detection out[5];
+    int n = processor.postprocess_into(s.get_outputs(), out, 5);
+    ASSERT_EQ(n, 5);
+    for (int i = 0; i < n; i++) EXPECT_EQ(0, memcmp(&out[i], &full[i], sizeof(Detection)));
+}
+
+TEST(Postprocess, BatchMatchesPerFrameThresholds) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 11));
+    Yolo26Processor<> batch;
+    ASSERT_TRUE(batch.bind(s.get_inputs()));
+    ASSERT_TRUE(batch.begin_batch(s.get_outputs()));
+
+    for (float conf : {0.10f, 0.35f, 0.60f}) {
+        Yolo26Processor<> single(YOLO_TARGET_K, conf);
+        auto expected = run(single, s);
+        Detection out[YOLO_TARGET_K];
+        int n = batch.postprocess_batch_into(batch.batch_thresholds(conf), out, YOLO_TARGET_K);
+        ASSERT_EQ(n, (int)expected.size()) << "conf " << conf;
+        for (int i = 0; i < n; i++) EXPECT_EQ(0, memcmp(&out[i], &expected[i], sizeof(Detection)));
+    }
+
+    batch.end_batch();
+    Detection out[1];
+    EXPECT_EQ(batch.postprocess_batch_into(batch.batch_thresholds(0.1f), out, 1), 0);
+}
+
+TEST(Postprocess, PlanFollowsThresholdAndOutputs) {
+    SyntheticOutputs a(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 21));
+    SyntheticOutputs b(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 22));
+    Yolo26Processor<> processor;
+    run(processor, a);
+
+    processor.set_conf_thresh(0.40f);
+    Yolo26Processor<> fresh(YOLO_TARGET_K, 0.40f);
+    auto raised = processor.postprocess(a.get_outputs());
+    ASSERT_FALSE(raised.empty());
+    expect_identical(raised, run(fresh, a));
+
+    // Another output map of the same shape, no bind(): the plan is re-resolved
+    Yolo26Processor<> fresh_b(YOLO_TARGET_K, 0.40f);
+    expect_identical(processor.postprocess(b.get_outputs()), run(fresh_b, b));
+
+    // Same tensors, new class exponent (e.g. a rebuilt model at the same address)
+    b.get_outputs().at("one2one_p4_cls")->exponent += 1;
+    Yolo26Processor<> fresh_exp(YOLO_TARGET_K, 0.40f);
+    expect_identical(processor.postprocess(b.get_outputs()), run(fresh_exp, b));
+}
+
+TEST(Postprocess, TransformMapsToSourcePixels) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 5));
+    Yolo26Processor<> processor;
+    auto model_px = run(processor, s);
+    Yolo26Transform xf = yolo26_make_transform(1920, 1080, 512, 512, YOLO_RESIZE_LETTERBOX);
+    auto source_px = processor.postprocess(s.get_outputs(), &xf);
+    ASSERT_EQ(model_px.size(), source_px.size());
+    for (size_t i = 0; i < model_px.size(); i++) {
+        Detection d = model_px[i];
+        yolo26_unmap_box(xf, d.x1, d.y1, d.x2, d.y2);
+        EXPECT_EQ(0, memcmp(&d, &source_px[i], sizeof(Detection)));
+        EXPECT_GE(source_px[i].x1, 0.0f);
+        EXPECT_LE(source_px[i].x2, 1920.0f);
+        EXPECT_GE(source_px[i].y1, 0.0f);
+        EXPECT_LE(source_px[i].y2, 1080.0f);
+    }
+}
+
+TEST(Postprocess, CompactMatchesQuantizedFloat) {
+    // The integer box decode is exact, so it equals the float boxes rounded to 1/4 px
+    for (dl::dtype_t dtype : {dl::DATA_TYPE_INT8, dl::DATA_TYPE_INT16}) {
+        SyntheticOutputs s(make_config(640, dtype, 0.05f, 31));
+        Yolo26Processor<> processor;
+        auto full = run(processor, s);
+        ASSERT_FALSE(full.empty());
+        DetectionQ out[YOLO_TARGET_K];
+        int n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K);
+        ASSERT_EQ(n, (int)full.size());
+        for (int i = 0; i < n; i++) {
+            DetectionQ q = yolo26_quantize_detection(full[i]);
+            EXPECT_EQ(0, memcmp(&q, &out[i], sizeof(DetectionQ))) << "rank " << i;
+        }
+    }
+}
+
+TEST(Postprocess, CompactTransformAndRoundTrip) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 5));
+    Yolo26Processor<512, 512, int8_t, 80> processor;
+    ASSERT_TRUE(processor.bind(s.get_inputs()));
+    Yolo26Transform xf = yolo26_make_transform(1920, 1080, 512, 512, YOLO_RESIZE_LETTERBOX);
+    auto source_px = processor.postprocess(s.get_outputs(), &xf);
+    DetectionQ out[YOLO_TARGET_K];
+    int n = processor.postprocess_into(s.get_outputs(), out, YOLO_TARGET_K, &xf);
+    ASSERT_EQ(n, (int)source_px.size());
+    for (int i = 0; i < n; i++) {
+        // Each corner is rounded twice (model then source pixels): within one step per scale
+        Detection d = yolo26_dequantize_detection(out[i]);
+        EXPECT_NEAR(d.x1, source_px[i].x1, 0.5f);
+        EXPECT_NEAR(d.y2, source_px[i].y2, 0.5f);
+        EXPECT_NEAR(d.score, source_px[i].score, 0.5f / 255);
+        EXPECT_EQ(d.class_id, source_px[i].class_id);
+        DetectionQ back = yolo26_quantize_detection(d);
+        EXPECT_EQ(0, memcmp(&back, &out[i], sizeof(DetectionQ)));
+    }
+}
+
+TEST(Postprocess, EarlyExitKeepsCoarseLayerResults) {
+    Yolo26Executor executor;
+    ASSERT_TRUE(executor.start());
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 41));
+    std::vector<ReferenceDetection> all = reference_postprocess(s.get_outputs(), 512, 512, 1 << 30, YOLO_CONF_THRESH);
+    for (bool dual : {false, true}) {
+        Yolo26Processor<> full;
+        Yolo26Processor<> early;
+        if (dual) early.set_executor(&executor);
+        auto expected = run(full, s);
+        EXPECT_EQ(full.get_last_scan_cells(), 64 * 64 + 32 * 32 + 16 * 16);
+
+        // Never satisfied: every layer is scanned, coarse to fine, with the same result
+        early.set_early_exit(1 << 20);
+        expect_identical(run(early, s), expected);
+        EXPECT_EQ(early.get_last_scan_cells(), 64 * 64 + 32 * 32 + 16 * 16);
+
+        // Satisfied by p5: only its detections, each one the full decode also produces
+        early.set_early_exit(1);
+        auto coarse = early.postprocess(s.get_outputs());
+        EXPECT_EQ(early.get_last_scan_cells(), 16 * 16);
+        ASSERT_FALSE(coarse.empty());
+        for (size_t i = 0; i < coarse.size(); i++) {
+            if (i > 0) {
+                EXPECT_LE(coarse[i].score, coarse[i - 1].score);
+            }
+            bool found = false;
+            for (const ReferenceDetection& r : all) found = found || same_detection(coarse[i], r);
+            EXPECT_TRUE(found) << "rank " << i;
+        }
+    }
+}
+
+// K + 2 cells in every layer share one score. On a tie the full scan ranks p3 first, so it keeps
+// p3 cells only; coarse to fine must keep the same ones although p5 fills the heap first.
+TEST(Postprocess, EarlyExitKeepsTiesAtKthScore) {
+    const int k = 8;
+    const char* names[3] = {"one2one_p3_cls", "one2one_p4_cls", "one2one_p5_cls"};
+    int allowed[60];
+    for (int i = 0; i < 60; i++) allowed[i] = i;
+    Yolo26Executor executor;
+    ASSERT_TRUE(executor.start());
+    for (dl::dtype_t dtype : {dl::DATA_TYPE_INT8, dl::DATA_TYPE_INT16}) {
+        SyntheticOutputs s(make_config(512, dtype, 0.0f, 43));
+        for (const char* name : names) {
+            dl::TensorBase* cls = s.get_outputs().at(name);
+            int raw = (int)std::ldexp(2.0f, -cls->exponent); // Logit 2.0 in every layer
+            int nc = cls->shape[3];
+            for (int i = 0; i < k + 2; i++) {
+                int idx = (i * 3 + 1) * nc + i % 5;
+                if (dtype == dl::DATA_TYPE_INT8) {
+                    ((int8_t*)cls->data)[idx] = (int8_t)raw;
+                } else {
+                    ((int16_t*)cls->data)[idx] = (int16_t)raw;
+                }
+            }
+        }
+        // No rule, a sparse allow-list and a dense one (SWAR lanes)
+        for (int n_allowed : {0, 5, 60}) {
+            for (bool dual : {false, true}) {
+                Yolo26Processor<> full(k);
+                Yolo26Processor<> early(k);
+                if (n_allowed) {
+                    full.set_allowed_classes(allowed, n_allowed);
+                    early.set_allowed_classes(allowed, n_allowed);
+                }
+                if (dual) early.set_executor(&executor);
+                early.set_early_exit(1 << 20);
+                auto expected = run(full, s);
+                ASSERT_EQ(expected.size(), (size_t)k);
+                SCOPED_TRACE(::testing::Message() << "dtype " << dtype << " allowed " << n_allowed << " dual " << dual);
+                expect_identical(run(early, s), expected);
+            }
+        }
+    }
+}
+
+TEST(Postprocess, PresenceQuery) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 41));
+    std::vector<ReferenceDetection> all = reference_postprocess(s.get_outputs(), 512, 512, 1 << 30, YOLO_CONF_THRESH);
+    Yolo26Processor<> processor;
+    ASSERT_TRUE(processor.bind(s.get_inputs()));
+    Detection hit;
+    ASSERT_TRUE(processor.query_presence(s.get_outputs(), &hit));
+    EXPECT_EQ(processor.get_last_scan_cells(), 16 * 16);
+    bool found = false;
+    for (const ReferenceDetection& r : all) found = found || same_detection(hit, r);
+    EXPECT_TRUE(found);
+
+    // Background only: every layer is read, nothing found
+    SyntheticOutputs empty(make_config(512, dl::DATA_TYPE_INT8, 0.0f, 41));
+    Yolo26Processor<> background;
+    ASSERT_TRUE(background.bind(empty.get_inputs()));
+    EXPECT_FALSE(background.query_presence(empty.get_outputs()));
+    EXPECT_EQ(background.get_last_scan_cells(), 64 * 64 + 32 * 32 + 16 * 16);
+
+    // Class rules: the hit is an allowed class above its own threshold
+    int ids[] = {3, 7};
+    processor.set_allowed_classes(ids, 2);
+    processor.set_class_threshold(7, 0.5f);
+    if (processor.query_presence(s.get_outputs(), &hit)) {
+        EXPECT_TRUE(hit.class_id == 3 || hit.class_id == 7);
+        EXPECT_GE(hit.score, hit.class_id == 7 ? 0.5f : YOLO_CONF_THRESH);
+    }
+    EXPECT_EQ(!processor.postprocess(s.get_outputs()).empty(), processor.query_presence(s.get_outputs()));
+}
+
+TEST(Postprocess, RequiresBoundInput) {
+    SyntheticOutputs s(make_config(512, dl::DATA_TYPE_INT8, 0.05f, 1));
+    Yolo26Processor<> processor;
+    EXPECT_TRUE(processor.postprocess(s.get_outputs()).empty());
+}
+
+TEST(Postprocess, StaticRejectsMismatchedModel) {
+    SyntheticOutputs s(make_config(640, dl::DATA_TYPE_INT8, 0.05f, 1));
+    Yolo26Processor<512, 512, int8_t, 80> wrong_shape;
+    EXPECT_FALSE(wrong_shape.bind(s.get_inputs()));
+
+    SyntheticOutputs s16(make_config(512, dl::DATA_TYPE_INT16, 0.05f, 1));
+    Yolo26Processor<512, 512, int8_t, 80> wrong_dtype;
+    ASSERT_TRUE(wrong_dtype.bind(s16.get_inputs()));
+    EXPECT_TRUE(wrong_dtype.postprocess(s16.get_outputs()).empty());
+}
+
+} // namespace
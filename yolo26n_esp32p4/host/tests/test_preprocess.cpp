@@ -0,0 +1,377 @@
+// Input quantization kernels, preprocess paths and source <-> model geometry.
+
+#include "yolo_processor.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+struct Frame {
+    std::vector<uint8_t> pixels;
+    dl::image::img_t img;
+
+    Frame(int w, int h, uint32_t seed) : pixels((size_t)w * h * 3) {
+        for (size_t i = 0; i < pixels.size(); i++) {
+            seed = seed * 1664525u + 1013904223u;
+            pixels[i] = (uint8_t)(seed >> 24);
+        }
+        img = {pixels.data(), (uint16_t)w, (uint16_t)h, dl::image::DL_IMAGE_PIX_TYPE_RGB888};
+    }
+};
+
+struct Input {
+    dl::TensorBase tensor;
+    std::map<std::string, dl::TensorBase*> map;
+
+    Input(int w, int h) : tensor({1, h, w, 3}, nullptr, -7, dl::DATA_TYPE_INT8) { map["images"] = &tensor; }
+    const int8_t* data() const { return (const int8_t*)tensor.data; }
+};
+
+int8_t lut_value(int p) {
+    return (int8_t)std::min(127, (int)std::round(p / 255.0f * 128.0f));
+}
+
+TEST(Quantize, KernelsMatchLut) {
+    int8_t lut[256];
+    for (int p = 0; p < 256; p++) lut[p] = lut_value(p);
+    EXPECT_TRUE(yolo26_quant_self_test(yolo26_quantize_lut, lut));
+    EXPECT_TRUE(yolo26_quant_self_test(yolo26_quantize_swar, lut));
+    for (uint32_t p = 0; p < 256; p++) {
+        uint32_t word = p * 0x01010101u;
+        uint32_t q = yolo26_quantize_word(word);
+        EXPECT_EQ((int8_t)(q & 0xFF), lut[p]) << p;
+        EXPECT_EQ(q, (q & 0xFF) * 0x01010101u) << p; // No carry between lanes
+    }
+}
+
+TEST(Preprocess, MatchesLutFormula) {
+    Frame frame(512, 512, 3);
+    Input input(512, 512);
+    Yolo26Processor<> processor;
+    processor.preprocess(frame.img, input.map);
+    for (size_t i = 0; i < frame.pixels.size(); i++) {
+        ASSERT_EQ(input.data()[i], lut_value(frame.pixels[i])) << i;
+    }
+}
+
+TEST(Preprocess, DoubleBufferedInputsStayValidated) {
+    // The pipeline alternates two input tensors: both stay bound, and a tensor whose
+    // exponent changes is checked again
+    Frame frame(96, 96, 4);
+    Input a(96, 96), b(96, 96), c(96, 96);
+    Yolo26Rect all{0, 0, 96, 96};
+    Yolo26Processor<> processor;
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(processor.preprocess_region(frame.img, all, a.map));
+        ASSERT_TRUE(processor.preprocess_region(frame.img, all, b.map));
+    }
+    for (size_t i = 0; i < frame.pixels.size(); i++) {
+        ASSERT_EQ(b.data()[i], lut_value(frame.pixels[i])) << i;
+    }
+
+    b.tensor.exponent = -6;
+    EXPECT_FALSE(processor.preprocess_region(frame.img, all, b.map));
+    EXPECT_TRUE(processor.preprocess_region(frame.img, all, a.map));
+    b.tensor.exponent = -7;
+    EXPECT_TRUE(processor.preprocess_region(frame.img, all, b.map));
+
+    // A third tensor takes a slot; the evicted one is validated again on its next frame
+    c.tensor.exponent = -6;
+    EXPECT_FALSE(processor.preprocess_region(frame.img, all, c.map));
+    c.tensor.exponent = -7;
+    EXPECT_TRUE(processor.preprocess_region(frame.img, all, c.map));
+    a.tensor.exponent = -6;
+    EXPECT_FALSE(processor.preprocess_region(frame.img, all, a.map));
+}
+
+TEST(Preprocess, DualCoreMatchesSingleCore) {
+    Yolo26Executor executor;
+    ASSERT_TRUE(executor.start());
+    for (int size : {512, 320, 96}) {
+        Frame frame(size, size, 11);
+        Input single(size, size);
+        Input dual(size, size);
+        Yolo26Processor<> a;
+        Yolo26Processor<> b;
+        b.set_executor(&executor);
+        a.preprocess(frame.img, single.map);
+        b.preprocess(frame.img, dual.map);
+        ASSERT_EQ(0, memcmp(single.data(), dual.data(), frame.pixels.size())) << size;
+    }
+}
+
+TEST(Preprocess, RegionStretchMatchesCrop) {
+    Frame frame(800, 600, 9);
+    Yolo26Rect region{100, 50, 512, 512}; // 1:1, so the result is a plain crop
+    Input input(512, 512);
+    Yolo26Processor<> processor;
+    Yolo26Transform xf;
+    ASSERT_TRUE(processor.preprocess_region(frame.img, region, input.map, &xf));
+    for (int y = 0; y < 512; y++) {
+        for (int x = 0; x < 512 * 3; x++) {
+            uint8_t p = frame.pixels[((size_t)(region.y + y) * 800 + region.x) * 3 + x];
+            ASSERT_EQ(input.data()[(size_t)y * 512 * 3 + x], lut_value(p)) << x << "," << y;
+        }
+    }
+    EXPECT_EQ(xf.src_x, 100);
+    EXPECT_EQ(xf.src_y, 50);
+}
+
+TEST(Preprocess, RegionLetterboxPadsBorder) {
+    Frame frame(1024, 576, 4); // 16:9 -> 512x288 image band, 112 pad rows above and below
+    Input input(512, 512);
+    Yolo26Processor<> processor;
+    processor.set_resize_mode(YOLO_RESIZE_LETTERBOX);
+    Yolo26Transform xf;
+    ASSERT_TRUE(processor.preprocess_region(frame.img, {0, 0, 1024, 576}, input.map, &xf));
+    EXPECT_EQ(xf.roi_x, 0);
+    EXPECT_EQ(xf.roi_y, 112);
+    EXPECT_EQ(xf.roi_w, 512);
+    EXPECT_EQ(xf.roi_h, 288);
+
+    int8_t pad = lut_value(YOLO_LETTERBOX_PAD);
+    for (int y = 0; y < 512; y++) {
+        bool in_roi = y >= xf.roi_y && y < xf.roi_y + xf.roi_h;
+        for (int x = 0; x < 512 * 3; x++) {
+            int8_t v = input.data()[(size_t)y * 512 * 3 + x];
+            if (!in_roi) {
+                ASSERT_EQ(v, pad) << x << "," << y;
+            } else {
+                int sy = (y - xf.roi_y) * 576 / xf.roi_h;
+                int sx = (x / 3) * 1024 / xf.roi_w;
+                ASSERT_EQ(v, lut_value(frame.pixels[((size_t)sy * 1024 + sx) * 3 + x % 3])) << x << "," << y;
+            }
+        }
+    }
+}
+
+TEST(Preprocess, RejectsRegionOutsideFrame) {
+    Frame frame(640, 480, 1);
+    Input input(512, 512);
+    Yolo26Processor<> processor;
+    EXPECT_FALSE(processor.preprocess_region(frame.img, {200, 0, 512, 512}, input.map));
+}
+
+// Camera frame with every 16-bit value reachable: RGB565 from the seeded RGB888 frame, or
+// packed YUV422 with random Y and chroma.
+struct CameraFrame {
+    std::vector<uint8_t> bytes;
+    Yolo26CameraFrame frame;
+
+    CameraFrame(int w, int h, Yolo26PixelFormat fmt, uint32_t seed) : bytes((size_t)w * h * 2) {
+        for (size_t i = 0; i < bytes.size(); i++) {
+            seed = seed * 1664525u + 1013904223u;
+            bytes[i] = (uint8_t)(seed >> 24);
+        }
+        frame.data = bytes.data();
+        frame.width = w;
+        frame.height = h;
+        frame.format = fmt;
+    }
+
+    // Reference conversion in float, as a separate full-frame pass
+    void to_rgb888(int x, int y, uint8_t rgb[3]) const {
+        const uint8_t* row = bytes.data() + (size_t)y * frame.width * 2;
+        if (frame.format == YOLO_PIX_RGB565_LE || frame.format == YOLO_PIX_RGB565_BE) {
+            const uint8_t* px = row + x * 2;
+            uint16_t p = frame.format == YOLO_PIX_RGB565_LE ? (px[1] << 8 | px[0]) : (px[0] << 8 | px[1]);
+            int r = p >> 11, g = (p >> 5) & 63, b = p & 31;
+            rgb[0] = (uint8_t)(r << 3 | r >> 2);
+            rgb[1] = (uint8_t)(g << 2 | g >> 4);
+            rgb[2] = (uint8_t)(b << 3 | b >> 2);
+            return;
+        }
+        const uint8_t* pair = row + (x & ~1) * 2;
+        bool yuyv = frame.format == YOLO_PIX_YUYV;
+        float yv = row[x * 2 + (yuyv ? 0 : 1)];
+        float u = pair[yuyv ? 1 : 0] - 128.0f;
+        float v = pair[yuyv ? 3 : 2] - 128.0f;
+        rgb[0] = (uint8_t)std::clamp((int)std::lround(yv + 1.402f * v), 0, 255);
+        rgb[1] = (uint8_t)std::clamp((int)std::lround(yv - 0.344136f * u - 0.714136f * v), 0, 255);
+        rgb[2] = (uint8_t)std::clamp((int)std::lround(yv + 1.772f * u), 0, 255);
+    }
+};
+
+TEST(Preprocess, Rgb565MatchesConvertedFrame) {
+    for (Yolo26PixelFormat fmt : {YOLO_PIX_RGB565_LE, YOLO_PIX_RGB565_BE}) {
+        CameraFrame cam(512, 512, fmt, 8);
+        Input input(512, 512);
+        Yolo26Processor<> processor;
+        ASSERT_TRUE(processor.preprocess(cam.frame, input.map));
+        for (int y = 0; y < 512; y++) {
+            for (int x = 0; x < 512; x++) {
+                uint8_t rgb[3];
+                cam.to_rgb888(x, y, rgb);
+                for (int c = 0; c < 3; c++) {
+                    ASSERT_EQ(input.data()[((size_t)y * 512 + x) * 3 + c], lut_value(rgb[c])) << fmt << " " << x << "," << y;
+                }
+            }
+        }
+    }
+}
+
+TEST(Preprocess, Rgb565ImageForwardsToCameraPath) {
+    CameraFrame cam(640, 480, YOLO_PIX_RGB565_LE, 9);
+    Input a(512, 512), b(512, 512);
+    Yolo26Processor<> processor;
+    ASSERT_TRUE(processor.preprocess(cam.frame, a.map));
+    dl::image::img_t img = {cam.bytes.data(), 640, 480, dl::image::DL_IMAGE_PIX_TYPE_RGB565LE};
+    processor.preprocess(img, b.map);
+    EXPECT_EQ(memcmp(a.data(), b.data(), (size_t)512 * 512 * 3), 0);
+}
+
+TEST(Preprocess, Yuv422LetterboxWithinOneLevel) {
+    for (Yolo26PixelFormat fmt : {YOLO_PIX_YUYV, YOLO_PIX_UYVY}) {
+        CameraFrame cam(1024, 576, fmt, 10);
+        Input input(512, 512);
+        Yolo26Processor<> processor;
+        processor.set_resize_mode(YOLO_RESIZE_LETTERBOX);
+        Yolo26Transform xf;
+        ASSERT_TRUE(processor.preprocess(cam.frame, input.map, &xf));
+        EXPECT_EQ(xf.roi_y, 112);
+        EXPECT_EQ(xf.roi_h, 288);
+
+        int8_t pad = lut_value(YOLO_LETTERBOX_PAD);
+        for (int y = 0; y < 512; y++) {
+            bool in_roi = y >= xf.roi_y && y < xf.roi_y + xf.roi_h;
+            for (int x = 0; x < 512; x++) {
+                const int8_t* px = input.data() + ((size_t)y * 512 + x) * 3;
+                uint8_t rgb[3] = {YOLO_LETTERBOX_PAD, YOLO_LETTERBOX_PAD, YOLO_LETTERBOX_PAD};
+                if (in_roi) cam.to_rgb888(x * 1024 / xf.roi_w, (y - xf.roi_y) * 576 / xf.roi_h, rgb);
+                for (int c = 0; c < 3; c++) {
+                    // Integer chroma terms round separately: at most one 8-bit level off
+                    if (!in_roi) {
+                        ASSERT_EQ(px[c], pad);
+                    }
+                    ASSERT_LE(std::abs(px[c] - lut_value(rgb[c])), 1) << fmt << " " << x << "," << y;
+                }
+            }
+        }
+    }
+}
+
+TEST(Preprocess, CameraFrameDualCoreMatchesSingleCore) {
+    CameraFrame cam(800, 600, YOLO_PIX_UYVY, 11);
+    Input single(512, 512), dual(512, 512);
+    Yolo26Processor<> processor;
+    processor.set_resize_mode(YOLO_RESIZE_LETTERBOX);
+    ASSERT_TRUE(processor.preprocess(cam.frame, single.map));
+
+    Yolo26Executor executor;
+    ASSERT_TRUE(executor.start());
+    processor.set_executor(&executor);
+    ASSERT_TRUE(processor.preprocess(cam.frame, dual.map));
+    EXPECT_EQ(memcmp(single.data(), dual.data(), (size_t)512 * 512 * 3), 0);
+}
+
+TEST(Preprocess, RejectsOddYuvWidth) {
+    CameraFrame cam(511, 512, YOLO_PIX_YUYV, 12);
+    Input input(512, 512);
+    Yolo26Processor<> processor;
+    EXPECT_FALSE(processor.preprocess(cam.frame, input.map));
+}
+
+TEST(Geometry, LetterboxRoundTrip) {
+    Yolo26Transform xf = yolo26_make_transform(1920, 1080, 640, 640, YOLO_RESIZE_LETTERBOX);
+    EXPECT_EQ(xf.roi_w, 640);
+    EXPECT_EQ(xf.roi_h, 360);
+    EXPECT_EQ(xf.roi_y, 140);
+
+    // Source box -> model -> back
+    float x1 = 300 * xf.scale_x + xf.roi_x, y1 = 200 * xf.scale_y + xf.roi_y;
+    float x2 = 900 * xf.scale_x + xf.roi_x, y2 = 1000 * xf.scale_y + xf.roi_y;
+    yolo26_unmap_box(xf, x1, y1, x2, y2);
+    EXPECT_NEAR(x1, 300.0f, 1e-3f);
+    EXPECT_NEAR(y1, 200.0f, 1e-3f);
+    EXPECT_NEAR(x2, 900.0f, 1e-3f);
+    EXPECT_NEAR(y2, 1000.0f, 1e-3f);
+
+    // Boxes reaching into the padding are clipped to the frame
+    x1 = -20.0f, y1 = 0.0f, x2 = 700.0f, y2 = 640.0f;
+    yolo26_unmap_box(xf, x1, y1, x2, y2);
+    EXPECT_EQ(x1, 0.0f);
+    EXPECT_EQ(y1, 0.0f);
+    EXPECT_EQ(x2, 1920.0f);
+    EXPECT_EQ(y2, 1080.0f);
+}
+
+TEST(Geometry, PpaTransformUsesSixteenthSteps) {
+    // 1920x1080 -> 512: exact letterbox scale 0.2667, the PPA takes 4/16
+    Yolo26Transform xf = yolo26_make_ppa_transform(1920, 1080, 512, 512, YOLO_RESIZE_LETTERBOX);
+    EXPECT_EQ(xf.scale_x, 0.25f);
+    EXPECT_EQ(xf.scale_y, 0.25f);
+    EXPECT_EQ(xf.roi_w, 480);
+    EXPECT_EQ(xf.roi_h, 270);
+    EXPECT_EQ(xf.roi_x, 16);
+    EXPECT_EQ(xf.roi_y, 121);
+
+    // Stretch keeps separate axes; the roi never exceeds the model input
+    xf = yolo26_make_ppa_transform(640, 480, 512, 512, YOLO_RESIZE_STRETCH);
+    EXPECT_EQ(xf.scale_x, 12 / 16.0f);
+    EXPECT_EQ(xf.scale_y, 17 / 16.0f);
+    EXPECT_EQ(xf.roi_w, 480);
+    EXPECT_EQ(xf.roi_h, 510);
+
+    float x1 = 100 * xf.scale_x + xf.roi_x, y1 = 50 * xf.scale_y + xf.roi_y;
+    float x2 = 600 * xf.scale_x + xf.roi_x, y2 = 400 * xf.scale_y + xf.roi_y;
+    yolo26_unmap_box(xf, x1, y1, x2, y2);
+    EXPECT_NEAR(x1, 100.0f, 1e-3f);
+    EXPECT_NEAR(y1, 50.0f, 1e-3f);
+    EXPECT_NEAR(x2, 600.0f, 1e-3f);
+    EXPECT_NEAR(y2, 400.0f, 1e-3f);
+
+    // Below 1/16 the PPA cannot scale: software path
+    EXPECT_EQ(yolo26_make_ppa_transform(9000, 480, 512, 512, YOLO_RESIZE_STRETCH).roi_w, 0);
+}
+
+TEST(Preprocess, AccelWithoutHardwareFallsBack) {
+    Frame frame(1024, 576, 5);
+    Yolo26Accel accel;
+    EXPECT_FALSE(accel.init()); // Host: no PPA or JPEG codec
+    EXPECT_EQ(accel.get_alignment(), 0u);
+
+    Yolo26Processor<> plain, accelerated;
+    plain.set_resize_mode(YOLO_RESIZE_LETTERBOX);
+    accelerated.set_resize_mode(YOLO_RESIZE_LETTERBOX);
+    accelerated.set_accel(&accel);
+
+    Input input(512, 512);
+    Yolo26Transform xf_a, xf_b;
+    dl::image::img_t a = plain.resize(frame.img, input.map, &xf_a);
+    dl::image::img_t b = accelerated.resize(frame.img, input.map, &xf_b);
+    ASSERT_TRUE(a.data && b.data);
+    EXPECT_EQ(xf_a.roi_h, xf_b.roi_h);
+    EXPECT_EQ(xf_a.scale_x, xf_b.scale_x);
+    EXPECT_EQ(memcmp(a.data, b.data, (size_t)512 * 512 * 3), 0);
+    heap_caps_free(a.data);
+    heap_caps_free(b.data);
+}
+
+TEST(Memory, FramesFillWholeCacheLines) {
+    size_t bytes = 1000;
+    void* p = yolo26_alloc_frame(bytes);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ((uintptr_t)p % YOLO_MEM_CACHE_LINE, 0u);
+    EXPECT_EQ(bytes, (size_t)(1000 + YOLO_MEM_CACHE_LINE - 1) / YOLO_MEM_CACHE_LINE * YOLO_MEM_CACHE_LINE);
+    heap_caps_free(p);
+
+    Frame frame(320, 200, 9);
+    Yolo26Processor<> processor;
+    Input input(96, 64);
+    dl::image::img_t resized = processor.resize(frame.img, input.map);
+    ASSERT_NE(resized.data, nullptr);
+    EXPECT_EQ((uintptr_t)resized.data % YOLO_MEM_CACHE_LINE, 0u);
+    heap_caps_free(resized.data);
+}
+
+TEST(Geometry, RegionOffsetsAfterClip) {
+    Yolo26Transform xf = yolo26_make_region_transform({1000, 500, 512, 512}, 512, 512, YOLO_RESIZE_STRETCH);
+    float x1 = -5.0f, y1 = 10.0f, x2 = 100.0f, y2 = 600.0f;
+    yolo26_unmap_box(xf, x1, y1, x2, y2);
+    EXPECT_EQ(x1, 1000.0f);
+    EXPECT_EQ(y1, 510.0f);
+    EXPECT_EQ(x2, 1100.0f);
+    EXPECT_EQ(y2, 1012.0f);
+}
+
+} // namespace
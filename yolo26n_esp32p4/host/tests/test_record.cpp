@@ -0,0 +1,220 @@
+// .y26t recordings: round trip, framed captures, and replay of device captures against the
+// reference decode.
+//
+// Set YOLO26_RECORDINGS to a directory of .y26t files to replay real device outputs.
+
+#include "yolo_processor.hpp"
+#include "yolo_record.hpp"
+#include "reference_decode.hpp"
+#include "synthetic_outputs.hpp"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <filesystem>
+
+namespace {
+
+int input_size_of(const std::map<std::string, dl::TensorBase*>& outputs) {
+    return outputs.at("one2one_p3_cls")->shape[2] * 8;
+}
+
+void expect_same_tensors(const std::map<std::string, dl::TensorBase*>& a, const std::map<std::string, dl::TensorBase*>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (const auto& kv : a) {
+        auto it = b.find(kv.first);
+        ASSERT_NE(it, b.end()) << kv.first;
+        dl::TensorBase* x = kv.second;
+        dl::TensorBase* y = it->second;
+        EXPECT_EQ(x->shape, y->shape) << kv.first;
+        EXPECT_EQ(x->dtype, y->dtype) << kv.first;
+        EXPECT_EQ(x->exponent, y->exponent) << kv.first;
+        ASSERT_EQ(x->get_bytes(), y->get_bytes()) << kv.first;
+        EXPECT_EQ(0, memcmp(x->data, y->data, x->get_bytes())) << kv.first;
+    }
+}
+
+TEST(Record, RoundTripSeveralRecords) {
+    FILE* f = tmpfile();
+    ASSERT_NE(f, nullptr);
+    SyntheticOutputsConfig cfg;
+    cfg.seed = 11;
+    SyntheticOutputs a(cfg);
+    cfg.dtype = dl::DATA_TYPE_INT16;
+    cfg.input_size = 640;
+    cfg.seed = 12;
+    SyntheticOutputs b(cfg);
+    ASSERT_TRUE(yolo26_record_write(f, a.get_outputs()));
+    ASSERT_TRUE(yolo26_record_write(f, b.get_outputs()));
+    rewind(f);
+
+    Yolo26Recording rec;
+    ASSERT_TRUE(rec.read(f));
+    expect_same_tensors(a.get_outputs(), rec.get());
+    ASSERT_TRUE(rec.read(f));
+    expect_same_tensors(b.get_outputs(), rec.get());
+    EXPECT_FALSE(rec.read(f));
+    EXPECT_TRUE(rec.empty());
+    fclose(f);
+}
+
+TEST(Record, ReplayDecodesLikeLive) {
+    FILE* f = tmpfile();
+    ASSERT_NE(f, nullptr);
+    SyntheticOutputsConfig cfg;
+    cfg.density = 0.05f;
+    SyntheticOutputs live(cfg);
+    ASSERT_TRUE(yolo26_record_write(f, live.get_outputs()));
+    rewind(f);
+    Yolo26Recording rec;
+    ASSERT_TRUE(rec.read(f));
+    fclose(f);
+
+    Yolo26Processor<> processor;
+    ASSERT_TRUE(processor.bind(live.get_inputs()));
+    auto expected = processor.postprocess(live.get_outputs());
+    auto replayed = processor.postprocess(rec.get());
+    ASSERT_EQ(expected.size(), replayed.size());
+    for (size_t i = 0; i < expected.size(); i++) EXPECT_EQ(0, memcmp(&expected[i], &replayed[i], sizeof(Detection)));
+}
+
+TEST(Record, RejectsTruncatedRecord) {
+    FILE* f = tmpfile();
+    ASSERT_NE(f, nullptr);
+    SyntheticOutputs s{SyntheticOutputsConfig()};
+    ASSERT_TRUE(yolo26_record_write(f, s.get_outputs()));
+    long size = ftell(f);
+    std::vector<uint8_t> bytes(size);
+    rewind(f);
+    ASSERT_EQ(fread(bytes.data(), 1, size, f), (size_t)size);
+    fclose(f);
+
+    FILE* cut = tmpfile();
+    fwrite(bytes.data(), 1, size / 2, cut);
+    rewind(cut);
+    Yolo26Recording rec;
+    EXPECT_FALSE(rec.read(cut));
+    EXPECT_TRUE(rec.empty());
+    fclose(cut);
+
+    FILE* bad = tmpfile();
+    bytes[0] = 'X';
+    fwrite(bytes.data(), 1, size, bad);
+    rewind(bad);
+    EXPECT_FALSE(rec.read(bad));
+    fclose(bad);
+}
+
+// One complete frame as Yolo26TensorDump's writer emits it
+std::vector<uint8_t> make_frame(const Yolo26TensorMap& outputs, const Yolo26TensorMap* extra, uint32_t seq) {
+    size_t len = yolo26_record_size(outputs, extra);
+    std::vector<uint8_t> buf(sizeof(Yolo26FrameHeader) + len + 4);
+    EXPECT_EQ(yolo26_record_serialize(outputs, extra, buf.data() + sizeof(Yolo26FrameHeader), len), len);
+    EXPECT_EQ(yolo26_frame_finish(buf.data(), len, seq, 1000 + seq), buf.size());
+    return buf;
+}
+
+TEST(Record, Crc32MatchesZlib) {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(yolo26_crc32(0, check, sizeof(check)), 0xCBF43926u);
+    EXPECT_EQ(yolo26_crc32(yolo26_crc32(0, check, 4), check + 4, 5), 0xCBF43926u);
+}
+
+TEST(Record, SerializeMatchesFileWrite) {
+    SyntheticOutputs s{SyntheticOutputsConfig()};
+    size_t len = yolo26_record_size(s.get_outputs(), &s.get_inputs());
+    ASSERT_GT(len, yolo26_record_size(s.get_outputs()));
+    std::vector<uint8_t> mem(len);
+    ASSERT_EQ(yolo26_record_serialize(s.get_outputs(), &s.get_inputs(), mem.data(), len), len);
+    EXPECT_EQ(yolo26_record_serialize(s.get_outputs(), &s.get_inputs(), mem.data(), len - 1), 0u);
+
+    FILE* f = tmpfile();
+    ASSERT_TRUE(yolo26_record_write(f, s.get_outputs(), &s.get_inputs()));
+    ASSERT_EQ((size_t)ftell(f), len);
+    std::vector<uint8_t> disk(len);
+    rewind(f);
+    ASSERT_EQ(fread(disk.data(), 1, len, f), len);
+    fclose(f);
+    EXPECT_EQ(mem, disk);
+
+    Yolo26Recording rec;
+    ASSERT_TRUE(rec.read(mem.data(), mem.size()));
+    EXPECT_EQ(rec.get().size(), s.get_outputs().size() + 1);
+    EXPECT_EQ(rec.get().count("images"), 1u);
+}
+
+TEST(Record, FramesSurviveInterleavedLogText) {
+    SyntheticOutputsConfig cfg;
+    cfg.density = 0.05f;
+    SyntheticOutputs a(cfg);
+    cfg.seed = 99;
+    SyntheticOutputs b(cfg);
+
+    FILE* f = tmpfile();
+    const char* log = "I (1234) YOLO26: boot\nY26 Y26F not a frame\n";
+    fputs(log, f);
+    auto fa = make_frame(a.get_outputs(), nullptr, 7);
+    fwrite(fa.data(), 1, fa.size(), f);
+    fputs("Det 1: person (91.00%) | Box: [1.0, 2.0, 3.0, 4.0]\n", f);
+    auto fb = make_frame(b.get_outputs(), &b.get_inputs(), 8);
+    fwrite(fb.data(), 1, fb.size(), f);
+    rewind(f);
+
+    Yolo26Recording rec;
+    ASSERT_TRUE(rec.read_frame(f));
+    EXPECT_EQ(rec.get_frame_seq(), 7u);
+    EXPECT_EQ(rec.get_frame_time_ms(), 1007u);
+    expect_same_tensors(a.get_outputs(), rec.get());
+    ASSERT_TRUE(rec.read_frame(f));
+    EXPECT_EQ(rec.get_frame_seq(), 8u);
+    EXPECT_EQ(rec.get().size(), b.get_outputs().size() + 1);
+    EXPECT_FALSE(rec.read_frame(f));
+    fclose(f);
+}
+
+TEST(Record, SkipsFramesWithBadCrc) {
+    SyntheticOutputs a{SyntheticOutputsConfig()};
+    auto broken = make_frame(a.get_outputs(), nullptr, 1);
+    broken[sizeof(Yolo26FrameHeader) + 40] ^= 0x55;
+    auto good = make_frame(a.get_outputs(), nullptr, 2);
+
+    FILE* f = tmpfile();
+    fwrite(broken.data(), 1, broken.size(), f);
+    fwrite(good.data(), 1, good.size(), f);
+    rewind(f);
+    Yolo26Recording rec;
+    ASSERT_TRUE(rec.read_frame(f));
+    EXPECT_EQ(rec.get_frame_seq(), 2u);
+    expect_same_tensors(a.get_outputs(), rec.get());
+    EXPECT_FALSE(rec.read_frame(f));
+    fclose(f);
+}
+
+TEST(Record, DeviceRecordingsMatchReference) {
+    const char* dir = std::getenv("YOLO26_RECORDINGS");
+    if (!dir) GTEST_SKIP() << "YOLO26_RECORDINGS not set";
+
+    int records = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() != ".y26t") continue;
+        FILE* f = fopen(entry.path().c_str(), "rb");
+        ASSERT_NE(f, nullptr) << entry.path();
+        Yolo26Recording rec;
+        while (rec.read(f)) {
+            SCOPED_TRACE(entry.path().string() + " record " + std::to_string(records));
+            int size = input_size_of(rec.get());
+            dl::TensorBase input({1, size, size, 3}, nullptr, -7, dl::DATA_TYPE_INT8);
+            std::map<std::string, dl::TensorBase*> inputs{{"images", &input}};
+
+            Yolo26Processor<> processor;
+            ASSERT_TRUE(processor.bind(inputs));
+            auto got = processor.postprocess(rec.get());
+            auto ref = reference_postprocess(rec.get(), size, size, YOLO_TARGET_K, YOLO_CONF_THRESH);
+            ASSERT_EQ(got.size(), ref.size());
+            for (size_t i = 0; i < got.size(); i++) EXPECT_EQ(got[i].score, ref[i].score) << "rank " << i;
+            records++;
+        }
+        fclose(f);
+    }
+    EXPECT_GT(records, 0) << "no .y26t records in " << dir;
+}
+
+} // namespace
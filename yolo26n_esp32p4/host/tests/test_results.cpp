@@ -0,0 +1,108 @@
+// Detection result packets: in-place build from postprocess_into(), parse, and rejection of
+// damaged packets.
+
+#include "yolo_processor.hpp"
+#include "yolo_result_packet.hpp"
+#include "synthetic_outputs.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+SyntheticOutputs make_outputs() {
+    SyntheticOutputsConfig cfg;
+    cfg.density = 0.05f;
+    cfg.seed = 17;
+    return SyntheticOutputs(cfg);
+}
+
+// Header, `count` detections from the processor, then a thumbnail of `thumb` bytes
+std::vector<uint8_t> build_packet(Yolo26Processor<>& processor, const SyntheticOutputs& s, int capacity,
+                                  const std::vector<uint8_t>& thumb, int* count) {
+    std::vector<uint8_t> packet(yolo26_result_packet_size(capacity, thumb.size()));
+    *count = processor.postprocess_into(s.get_outputs(), yolo26_result_detections(packet.data()), capacity);
+    memcpy(packet.data() + sizeof(Yolo26ResultHeader) + *count * sizeof(DetectionQ), thumb.data(), thumb.size());
+
+    Yolo26ResultHeader h = {};
+    h.count = (uint16_t)*count;
+    h.seq = 42;
+    h.time_ms = 1234;
+    h.frame_w = 512;
+    h.frame_h = 512;
+    h.thumb_format = thumb.empty() ? YOLO_THUMB_NONE : YOLO_THUMB_RGB565;
+    h.thumb_w = thumb.empty() ? 0 : 4;
+    h.thumb_h = thumb.empty() ? 0 : 2;
+    h.thumb_bytes = (uint32_t)thumb.size();
+    packet.resize(yolo26_result_finish(packet.data(), h));
+    return packet;
+}
+
+} // namespace
+
+TEST(Results, PacketCarriesPostprocessOutput) {
+    SyntheticOutputs s = make_outputs();
+    Yolo26Processor<> processor;
+    ASSERT_TRUE(processor.bind(s.get_inputs()));
+    auto expected = processor.postprocess(s.get_outputs());
+    ASSERT_FALSE(expected.empty());
+
+    std::vector<uint8_t> thumb(4 * 2 * 2);
+    for (size_t i = 0; i < thumb.size(); i++) thumb[i] = (uint8_t)(i * 31);
+    int count;
+    std::vector<uint8_t> packet = build_packet(processor, s, YOLO_TARGET_K, thumb, &count);
+    EXPECT_EQ(packet.size(), yolo26_result_packet_size(count, thumb.size()));
+
+    Yolo26ResultView view;
+    ASSERT_TRUE(yolo26_result_parse(packet.data(), packet.size(), &view));
+    EXPECT_EQ(view.header.seq, 42u);
+    EXPECT_EQ(view.header.version, YOLO_RESULT_VERSION);
+    ASSERT_EQ(view.header.count, expected.size());
+    for (int i = 0; i < count; i++) {
+        DetectionQ q = yolo26_quantize_detection(expected[i]);
+        EXPECT_EQ(0, memcmp(&q, &view.detections[i], sizeof(DetectionQ))) << "rank " << i;
+    }
+    ASSERT_NE(view.thumbnail, nullptr);
+    EXPECT_EQ(0, memcmp(view.thumbnail, thumb.data(), thumb.size()));
+}
+
+TEST(Results, RejectsDamagedPackets) {
+    SyntheticOutputs s = make_outputs();
+    Yolo26Processor<> processor;
+    ASSERT_TRUE(processor.bind(s.get_inputs()));
+    int count;
+    std::vector<uint8_t> packet = build_packet(processor, s, 8, {}, &count);
+    Yolo26ResultView view;
+    ASSERT_TRUE(yolo26_result_parse(packet.data(), packet.size(), &view));
+    EXPECT_EQ(view.thumbnail, nullptr);
+
+    EXPECT_FALSE(yolo26_result_parse(packet.data(), packet.size() - 1, &view));  // Truncated
+    EXPECT_FALSE(yolo26_result_parse(packet.data(), 12, &view));
+    std::vector<uint8_t> longer = packet;
+    longer.push_back(0);
+    EXPECT_FALSE(yolo26_result_parse(longer.data(), longer.size(), &view));       // Trailing bytes
+    for (size_t at : {(size_t)0, (size_t)4, sizeof(Yolo26ResultHeader) + 3, packet.size() - 2}) {
+        std::vector<uint8_t> bad = packet;
+        bad[at] ^= 0x10;
+        EXPECT_FALSE(yolo26_result_parse(bad.data(), bad.size(), &view)) << "byte " << at;
+    }
+}
+
+TEST(Results, ThumbnailSamplesNearest) {
+    // 4x2 RGB888 source: left half red, right half blue
+    uint8_t pixels[4 * 2 * 3] = {};
+    for (int i = 0; i < 8; i++) {
+        pixels[i * 3 + ((i % 4) < 2 ? 0 : 2)] = 255;
+    }
+    dl::image::img_t src = {};
+    src.data = pixels;
+    src.width = 4;
+    src.height = 2;
+    src.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
+    uint8_t thumb[2 * 1 * 2];
+    ASSERT_EQ(yolo26_make_thumbnail(src, thumb, 2, 1), sizeof(thumb));
+    EXPECT_EQ(thumb[0] | thumb[1] << 8, 0xF800); // RGB565 red
+    EXPECT_EQ(thumb[2] | thumb[3] << 8, 0x001F); // RGB565 blue
+
+    src.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB565LE;
+    EXPECT_EQ(yolo26_make_thumbnail(src, thumb, 2, 1), 0u);
+}
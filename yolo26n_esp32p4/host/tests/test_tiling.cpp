@@ -0,0 +1,190 @@
+// Yolo26Tiler: grid placement, cross-tile seam merge and the per-frame inference budget.
+// Runs the real Yolo26TilerT with a stand-in processor that replays scripted detections per tile.
+
+#include "yolo_tiling.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace {
+
+constexpr int kTile = 64;
+
+// Detections are scripted in frame pixels, keyed by the x of the tile that reports them.
+struct ScriptedProcessor {
+    std::map<int, std::vector<Detection>> script;
+    std::vector<int> ran; // Tile x per preprocess_region() call
+    int current = -1;
+
+    int get_target_k() const { return 8; }
+
+    bool preprocess_region(const dl::image::img_t&, const Yolo26Rect& region, const std::map<std::string, dl::TensorBase*>&,
+                           Yolo26Transform* = nullptr) {
+        current = region.x;
+        ran.push_back(region.x);
+        return true;
+    }
+
+    int postprocess_into(const std::map<std::string, dl::TensorBase*>&, Detection* out, int capacity, const Yolo26Transform* = nullptr) {
+        const std::vector<Detection>& dets = script[current];
+        int n = std::min((int)dets.size(), capacity);
+        for (int i = 0; i < n; i++) out[i] = dets[i];
+        return n;
+    }
+};
+
+struct TileModel : dl::Model {
+    dl::TensorBase input{{1, kTile, kTile, 3}, nullptr, 0, dl::DATA_TYPE_INT8};
+
+    TileModel() { inputs["images"] = &input; }
+};
+
+struct Frame {
+    std::vector<uint8_t> pixels;
+    dl::image::img_t img;
+
+    Frame(int w, int h, uint8_t luma = 100) : pixels((size_t)w * h * 3, luma) {
+        img = {pixels.data(), (uint16_t)w, (uint16_t)h, dl::image::DL_IMAGE_PIX_TYPE_RGB888};
+    }
+
+    // Grey pixels: luma equals the channel value
+    void fill(int x0, int x1, uint8_t luma) {
+        for (int y = 0; y < img.height; y++) {
+            memset(&pixels[((size_t)y * img.width + x0) * 3], luma, (size_t)(x1 - x0) * 3);
+        }
+    }
+};
+
+Yolo26TilerConfig tiles_of(int size, float overlap) {
+    Yolo26TilerConfig cfg;
+    cfg.tile_w = size;
+    cfg.tile_h = size;
+    cfg.overlap = overlap;
+    return cfg;
+}
+
+} // namespace
+
+TEST(Tiling, GridCoversFrameEdgeToEdge) {
+    TileModel model;
+    ScriptedProcessor processor;
+    Yolo26TilerConfig cfg;
+    cfg.tile_w = 320;
+    cfg.tile_h = 320;
+    Yolo26TilerT<ScriptedProcessor> tiler(&model, processor, cfg);
+
+    const int w = 1000, h = 600;
+    ASSERT_TRUE(tiler.set_grid(w, h));
+    ASSERT_GT(tiler.get_tile_count(), 1);
+    int min_x = w, min_y = h, max_x = 0, max_y = 0;
+    for (int i = 0; i < tiler.get_tile_count(); i++) {
+        const Yolo26Rect& r = tiler.get_tile(i);
+        EXPECT_EQ(r.w, 320);
+        EXPECT_EQ(r.h, 320);
+        EXPECT_GE(r.x, 0);
+        EXPECT_GE(r.y, 0);
+        EXPECT_LE(r.x + r.w, w);
+        EXPECT_LE(r.y + r.h, h);
+        min_x = std::min(min_x, r.x);
+        min_y = std::min(min_y, r.y);
+        max_x = std::max(max_x, r.x + r.w);
+        max_y = std::max(max_y, r.y + r.h);
+        // Row-major: each tile overlaps its right-hand neighbour, so no column of pixels is missed
+        if (i + 1 < tiler.get_tile_count() && tiler.get_tile(i + 1).y == r.y) {
+            EXPECT_LT(tiler.get_tile(i + 1).x, r.x + r.w);
+        }
+    }
+    EXPECT_EQ(min_x, 0);
+    EXPECT_EQ(min_y, 0);
+    EXPECT_EQ(max_x, w);
+    EXPECT_EQ(max_y, h);
+
+    // A frame smaller than a tile is one tile clipped to the frame
+    ASSERT_TRUE(tiler.set_grid(200, 100));
+    ASSERT_EQ(tiler.get_tile_count(), 1);
+    EXPECT_EQ(tiler.get_tile(0).w, 200);
+    EXPECT_EQ(tiler.get_tile(0).h, 100);
+}
+
+TEST(Tiling, SeamCutObjectMergesIntoUnion) {
+    // 96 px wide, 64 px tiles at 50% overlap: tiles at x = 0 and x = 32 share [32, 64)
+    TileModel model;
+    ScriptedProcessor processor;
+    Yolo26TilerT<ScriptedProcessor> tiler(&model, processor, tiles_of(kTile, 0.5f));
+    ASSERT_TRUE(tiler.set_grid(96, kTile));
+    ASSERT_EQ(tiler.get_tile_count(), 2);
+    ASSERT_EQ(tiler.get_tile(1).x, 32);
+
+    // An object spanning [20, 80) is cut by both tile edges; a different class in the same place stays separate
+    processor.script[0] = {{20, 10, 64, 50, 0.8f, 0}, {20, 10, 64, 50, 0.6f, 1}};
+    processor.script[32] = {{32, 10, 80, 52, 0.9f, 0}};
+
+    Frame frame(96, kTile);
+    Detection out[8];
+    ASSERT_EQ(tiler.process(frame.img, out, 8), 2);
+    EXPECT_EQ(tiler.get_tiles_run(), 2);
+    EXPECT_FLOAT_EQ(out[0].score, 0.9f);
+    EXPECT_EQ(out[0].class_id, 0);
+    EXPECT_FLOAT_EQ(out[0].x1, 20);
+    EXPECT_FLOAT_EQ(out[0].y1, 10);
+    EXPECT_FLOAT_EQ(out[0].x2, 80);
+    EXPECT_FLOAT_EQ(out[0].y2, 52);
+    EXPECT_EQ(out[1].class_id, 1);
+}
+
+TEST(Tiling, SameTileOverlapsAreLeftAlone) {
+    TileModel model;
+    ScriptedProcessor processor;
+    Yolo26TilerT<ScriptedProcessor> tiler(&model, processor, tiles_of(kTile, 0.5f));
+    ASSERT_TRUE(tiler.set_grid(96, kTile));
+
+    // Two people standing close together, both inside tile 0: the one-to-one head already separated them
+    processor.script[0] = {{4, 4, 24, 60, 0.9f, 0}, {6, 4, 26, 60, 0.8f, 0}};
+
+    Frame frame(96, kTile);
+    Detection out[8];
+    ASSERT_EQ(tiler.process(frame.img, out, 8), 2);
+    EXPECT_FLOAT_EQ(out[0].x1, 4);
+    EXPECT_FLOAT_EQ(out[0].x2, 24);
+    EXPECT_FLOAT_EQ(out[1].x1, 6);
+    EXPECT_FLOAT_EQ(out[1].x2, 26);
+}
+
+TEST(Tiling, BudgetRunsNeverRunThenStaleTilesFirst) {
+    // Three side-by-side tiles, one inference per frame
+    TileModel model;
+    ScriptedProcessor processor;
+    Yolo26TilerConfig cfg = tiles_of(kTile, 0.0f);
+    cfg.max_tiles_per_frame = 1;
+    cfg.max_stale_frames = 100;
+    Yolo26TilerT<ScriptedProcessor> tiler(&model, processor, cfg);
+    ASSERT_TRUE(tiler.set_grid(3 * kTile, kTile));
+    ASSERT_EQ(tiler.get_tile_count(), 3);
+
+    // Static scene: each frame spends its budget on a tile that has never run
+    Frame frame(3 * kTile, kTile);
+    Detection out[8];
+    for (int i = 0; i < 3; i++) {
+        tiler.process(frame.img, out, 8);
+        EXPECT_EQ(tiler.get_tiles_run(), 1);
+    }
+    std::vector<int> first = processor.ran;
+    ASSERT_EQ(first.size(), 3u);
+    std::sort(first.begin(), first.end());
+    EXPECT_EQ(first, (std::vector<int>{0, kTile, 2 * kTile}));
+
+    // Everything moves; the newest tile moves most, but the oldest has waited longest
+    int oldest = processor.ran[0];
+    int newest = processor.ran[2];
+    for (int x = 0; x < 3 * kTile; x += kTile) frame.fill(x, x + kTile, 110);
+    frame.fill(newest, newest + kTile, 250);
+    tiler.process(frame.img, out, 8);
+    EXPECT_EQ(tiler.get_tiles_run(), 1);
+    EXPECT_EQ(processor.ran.back(), oldest);
+
+    // Nothing changes from here: only the two moved tiles still differ from their reference
+    tiler.process(frame.img, out, 8);
+    tiler.process(frame.img, out, 8);
+    tiler.process(frame.img, out, 8);
+    EXPECT_EQ(tiler.get_tiles_run(), 0);
+    EXPECT_EQ(processor.ran.size(), 6u);
+}
@@ -0,0 +1,112 @@
+// Yolo26Tracker: IDs across inferences, prediction between them, ByteTrack low-score rescue.
+
+#include "yolo_tracker.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr int64_t kSecond = 1000000;
+
+Detection box(float cx, float cy, float score, int class_id = 0, float w = 60.0f, float h = 120.0f) {
+    return {cx - w / 2, cy - h / 2, cx + w / 2, cy + h / 2, score, class_id};
+}
+
+float centre_x(const Detection& d) {
+    return (d.x1 + d.x2) * 0.5f;
+}
+
+TEST(Tracker, ConfirmsAfterMinHitsAndKeepsId) {
+    Yolo26Tracker tracker;
+    Yolo26TrackedBox out[4];
+    EXPECT_EQ(tracker.update({box(100, 200, 0.9f)}, 0), 0); // Tentative
+    EXPECT_EQ(tracker.predict(0, out, 4), 0);
+    EXPECT_EQ(tracker.update({box(110, 200, 0.9f)}, 2 * kSecond), 1);
+    ASSERT_EQ(tracker.predict(2 * kSecond, out, 4), 1);
+    int id = out[0].track_id;
+    for (int i = 2; i < 6; i++) {
+        tracker.update({box(100 + 10 * i, 200, 0.9f)}, i * 2 * kSecond);
+        ASSERT_EQ(tracker.predict(i * 2 * kSecond, out, 4), 1);
+        EXPECT_EQ(out[0].track_id, id);
+    }
+}
+
+TEST(Tracker, PredictsBetweenInferences) {
+    // 20 px/s to the right, an inference every 2 s
+    Yolo26Tracker tracker;
+    for (int i = 0; i < 8; i++) tracker.update({box(100 + 40 * i, 200, 0.9f)}, i * 2 * kSecond);
+    Yolo26TrackedBox out[2];
+    int64_t last = 7 * 2 * kSecond;
+    ASSERT_EQ(tracker.predict(last + kSecond, out, 2), 1);
+    EXPECT_NEAR(centre_x(out[0].det), 100 + 40 * 7 + 20, 3.0f);
+    EXPECT_NEAR(out[0].vx, 20.0f, 2.0f);
+    EXPECT_NEAR(out[0].vy, 0.0f, 2.0f);
+
+    // predict() is const: the track is unchanged and rewinding gives the same box
+    Yolo26TrackedBox again[2];
+    tracker.predict(last + kSecond, again, 2);
+    EXPECT_EQ(centre_x(again[0].det), centre_x(out[0].det));
+
+    // Extrapolation stops at the horizon
+    Yolo26TrackedBox far[2], farther[2];
+    tracker.predict(last + 2 * kSecond, far, 2);
+    tracker.predict(last + 10 * kSecond, farther, 2);
+    EXPECT_EQ(centre_x(far[0].det), centre_x(farther[0].det));
+}
+
+TEST(Tracker, LowScoreDetectionKeepsTrackAlive) {
+    Yolo26TrackerConfig cfg;
+    cfg.max_lost = 0;
+    Yolo26Tracker tracker(cfg);
+    tracker.update({box(100, 200, 0.9f)}, 0);
+    tracker.update({box(100, 200, 0.9f)}, kSecond);
+    Yolo26TrackedBox out[2];
+    ASSERT_EQ(tracker.predict(kSecond, out, 2), 1);
+    int id = out[0].track_id;
+
+    // Occluded: only a weak detection, too weak to start a track but enough to rescue this one
+    EXPECT_EQ(tracker.update({box(102, 200, 0.2f)}, 2 * kSecond), 1);
+    ASSERT_EQ(tracker.predict(2 * kSecond, out, 2), 1);
+    EXPECT_EQ(out[0].track_id, id);
+    EXPECT_FLOAT_EQ(out[0].det.score, 0.2f);
+
+    EXPECT_EQ(tracker.update(nullptr, 0, 3 * kSecond), 0); // max_lost = 0: gone
+    EXPECT_EQ(tracker.get_active_count(), 0);
+}
+
+TEST(Tracker, CoastsThenFreesLostTracks) {
+    Yolo26Tracker tracker; // max_lost = 3
+    tracker.update({box(100, 200, 0.9f)}, 0);
+    tracker.update({box(100, 200, 0.9f)}, kSecond);
+    Yolo26TrackedBox out[2];
+    for (int i = 2; i < 5; i++) {
+        EXPECT_EQ(tracker.update(nullptr, 0, i * kSecond), 0);
+        EXPECT_EQ(tracker.predict(i * kSecond, out, 2), 1); // Coasting, still served
+    }
+    tracker.update(nullptr, 0, 5 * kSecond);
+    EXPECT_EQ(tracker.predict(5 * kSecond, out, 2), 0);
+    EXPECT_EQ(tracker.get_active_count(), 0);
+}
+
+TEST(Tracker, SeparatesClassesAndObjects) {
+    Yolo26Tracker tracker;
+    for (int i = 0; i < 3; i++) {
+        // Same place, different classes; and a second person far away
+        tracker.update({box(100, 200, 0.9f, 0), box(100, 200, 0.8f, 2), box(400, 200, 0.7f, 0)}, i * kSecond);
+    }
+    Yolo26TrackedBox out[8];
+    ASSERT_EQ(tracker.predict(2 * kSecond, out, 8), 3);
+    EXPECT_NE(out[0].track_id, out[1].track_id);
+    EXPECT_NE(out[1].track_id, out[2].track_id);
+    EXPECT_NE(out[0].track_id, out[2].track_id);
+}
+
+TEST(Tracker, PoolCapacityIsFixed) {
+    Yolo26TrackerT<4> tracker;
+    std::vector<Detection> dets;
+    for (int i = 0; i < 10; i++) dets.push_back(box(50.0f + 100 * i, 200, 0.9f));
+    tracker.update(dets, 0);
+    EXPECT_EQ(tracker.get_active_count(), 4);
+    EXPECT_EQ(tracker.update(dets, kSecond), 4); // The first four (best) detections are tracked
+}
+
+} // namespace
@@ -0,0 +1,72 @@
+// Replays .y26t output recordings through Yolo26Processor::postprocess() on the host.
+//
+// usage: yolo26_replay <file> [k] [conf_thresh]
+// <file> is a .y26t recording or a framed tensor dump (raw UART / USB / SD capture, log text
+// in between is skipped). Prints detections in the same format as the device log, one block
+// per record, so the output can be pasted into visualize_esp32_output.py.
+
+#include "yolo_processor.hpp"
+#include "yolo_record.hpp"
+#include <chrono>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("usage: %s <file.y26t | dump> [k] [conf_thresh]\n", argv[0]);
+        return 2;
+    }
+    int k = argc > 2 ? atoi(argv[2]) : YOLO_TARGET_K;
+    float thresh = argc > 3 ? (float)atof(argv[3]) : YOLO_CONF_THRESH;
+
+    FILE* f = fopen(argv[1], "rb");
+    if (!f) {
+        printf("Error: cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    // Plain recordings start with the record magic; anything else is scanned for frames.
+    char magic[4] = {};
+    bool framed = fread(magic, 1, 4, f) != 4 || memcmp(magic, YOLO_RECORD_MAGIC, 4) != 0;
+    rewind(f);
+
+    Yolo26Processor<> processor(k, thresh);
+    Yolo26Recording rec;
+    int index = 0;
+    while (framed ? rec.read_frame(f) : rec.read(f)) {
+        auto it = rec.get().find("one2one_p3_cls");
+        if (it == rec.get().end()) {
+            printf("Error: record %d has no one2one_p3_cls tensor\n", index);
+            fclose(f);
+            return 1;
+        }
+        // The input size follows from the stride-8 grid
+        int h = it->second->shape[1] * 8;
+        int w = it->second->shape[2] * 8;
+        dl::TensorBase input({1, h, w, 3}, nullptr, -7, dl::DATA_TYPE_INT8);
+        std::map<std::string, dl::TensorBase*> inputs{{"images", &input}};
+        if (!processor.bind(inputs)) {
+            fclose(f);
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto results = processor.postprocess(rec.get());
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        if (framed) {
+            printf("\n=== Frame %lu @ %lu ms (%dx%d, %lld us) ===\n", (unsigned long)rec.get_frame_seq(),
+                   (unsigned long)rec.get_frame_time_ms(), w, h, (long long)us);
+        } else {
+            printf("\n=== Record %d (%dx%d, %lld us) ===\n", index, w, h, (long long)us);
+        }
+        printf("--- Top Detections ---\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const Detection& d = results[i];
+            printf("Det %zu: %s (%.2f%%) | Box: [%.1f, %.1f, %.1f, %.1f]\n", i + 1,
+                   d.class_id < 80 ? coco_classes[d.class_id] : "?", d.score * 100.0f, d.x1, d.y1, d.x2, d.y2);
+        }
+        index++;
+    }
+    fclose(f);
+    return index > 0 ? 0 : 1;
+}
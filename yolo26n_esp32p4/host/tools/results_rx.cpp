@@ -0,0 +1,62 @@
+// Receives detection result packets (.y26r) streamed by Yolo26ResultStream over UDP.
+//
+// usage: yolo26_results [port] [count]
+// Prints every packet's detections in the same format as the device log. Gaps in the
+// sequence numbers are frames the device superseded (or the network lost). Stops after
+// `count` packets (0 = run until interrupted).
+
+#include "yolo_result_packet.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char** argv) {
+    int port = argc > 1 ? atoi(argv[1]) : 5626;
+    long limit = argc > 2 ? atol(argv[2]) : 0;
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (sock < 0 || bind(sock, (const sockaddr*)&addr, sizeof(addr)) != 0) {
+        printf("Error: cannot listen on UDP port %d\n", port);
+        return 1;
+    }
+    printf("Listening on UDP port %d\n", port);
+
+    std::vector<uint8_t> buf(65536);
+    long received = 0;
+    uint32_t bad = 0, missed = 0, next_seq = 0;
+    while (limit <= 0 || received < limit) {
+        ssize_t len = recv(sock, buf.data(), buf.size(), 0);
+        if (len < 0) break;
+        Yolo26ResultView view;
+        if (!yolo26_result_parse(buf.data(), (size_t)len, &view)) {
+            printf("Warning: %zd byte datagram is not a result packet (%u so far)\n", len, (unsigned)++bad);
+            continue;
+        }
+        const Yolo26ResultHeader& h = view.header;
+        if (received > 0 && h.seq > next_seq) missed += h.seq - next_seq;
+        next_seq = h.seq + 1;
+        received++;
+
+        printf("\n=== Packet %lu @ %lu ms (%ux%u, %u detections, %u missed", (unsigned long)h.seq,
+               (unsigned long)h.time_ms, h.frame_w, h.frame_h, h.count, (unsigned)missed);
+        if (view.thumbnail) printf(", %ux%u thumbnail", h.thumb_w, h.thumb_h);
+        printf(") ===\n");
+        for (int i = 0; i < h.count; i++) {
+            DetectionQ q;
+            memcpy(&q, view.detections + i, sizeof(q));
+            Detection d = yolo26_dequantize_detection(q);
+            printf("Det %d: %s (%.2f%%) | Box: [%.1f, %.1f, %.1f, %.1f]\n", i + 1,
+                   d.class_id < 80 ? coco_classes[d.class_id] : "?", d.score * 100.0f, d.x1, d.y1, d.x2, d.y2);
+        }
+        fflush(stdout);
+    }
+    close(sock);
+    return 0;
+}
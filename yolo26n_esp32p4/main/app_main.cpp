@@ -5,9 +5,78 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "yolo_processor.hpp" // New Refactored Processor
+#include "yolo_pipeline.hpp"
+#include "yolo_tiling.hpp"
+#include "yolo_profiler.hpp"
+#include "yolo_benchmark.hpp"
+#include "yolo_dump.hpp"
+#include "yolo_models.hpp"
+#include "yolo_escalation.hpp"
+#include "yolo_tracker.hpp"
+#include "yolo_batch.hpp"
+#include "yolo_startup.hpp"
+#include "yolo_model_ota.hpp"
+#include "yolo_result_stream.hpp"
+#include "nvs_flash.h"
+#include "esp_attr.h"
+#include <cstdlib>
 
-// Model binary
+// Demos beyond the single-image one are selected in menuconfig ("YOLO26n Inference" > "Demos")
+
+// Model binary (selected by CONFIG_YOLO_MODEL_512 / CONFIG_YOLO_MODEL_640)
+#if CONFIG_YOLO_MODEL_640
+#define YOLO_APP_MODEL_TAG "yolo26n_640"
+#else
+#define YOLO_APP_MODEL_TAG "yolo26n_512"
+#endif
+
+// The model is mapped from the active A/B slot partition, or embedded in the app image
+#if CONFIG_YOLO_MODEL_PARTITION
+static Yolo26ModelSlots model_slots; // Active slot picked from NVS by init_model_slots()
+#define YOLO_APP_MODEL_ADDRESS model_slots.get_active_label()
+#define YOLO_APP_MODEL_LOCATION fbs::MODEL_LOCATION_IN_FLASH_PARTITION
+#else
+#if CONFIG_YOLO_MODEL_640
+extern const uint8_t yolo26n_inference_espdl[] asm("_binary_yolo26n_640_espdl_start");
+#else
 extern const uint8_t yolo26n_inference_espdl[] asm("_binary_yolo26n_512_espdl_start");
+#endif
+#define YOLO_APP_MODEL_ADDRESS ((const char *)yolo26n_inference_espdl)
+#define YOLO_APP_MODEL_LOCATION fbs::MODEL_LOCATION_IN_FLASH_RODATA
+#endif
+
+// Internal SRAM esp-dl's memory planner may give the model's tensors (0 = all in PSRAM)
+#define YOLO_APP_MODEL_INTERNAL_SIZE (CONFIG_YOLO_MODEL_INTERNAL_KB * 1024)
+
+#if CONFIG_YOLO_MODEL_REGISTRY
+// The other resolution, embedded as well for the model switching demo
+#if CONFIG_YOLO_MODEL_640
+extern const uint8_t yolo26n_alt_espdl[] asm("_binary_yolo26n_512_espdl_start");
+#define YOLO_APP_ALT_MODEL_TAG "yolo26n_512"
+#else
+extern const uint8_t yolo26n_alt_espdl[] asm("_binary_yolo26n_640_espdl_start");
+#define YOLO_APP_ALT_MODEL_TAG "yolo26n_640"
+#endif
+#endif
+
+// Processor specialization matching the embedded model
+#if CONFIG_YOLO_STATIC_PROCESSOR
+using YoloAppProcessor = Yolo26Processor<CONFIG_YOLO_INPUT_SIZE, CONFIG_YOLO_INPUT_SIZE, int8_t, 80>;
+#else
+using YoloAppProcessor = Yolo26Processor<>;
+#endif
+
+#if CONFIG_YOLO_LETTERBOX
+#define YOLO_APP_RESIZE_MODE YOLO_RESIZE_LETTERBOX
+#else
+#define YOLO_APP_RESIZE_MODE YOLO_RESIZE_STRETCH
+#endif
+
+#if CONFIG_YOLO_DUMP_UART || CONFIG_YOLO_DUMP_USB_JTAG || CONFIG_YOLO_DUMP_FILE
+#define YOLO_APP_DUMP 1
+#else
+#define YOLO_APP_DUMP 0
+#endif
 
 // Test images
 extern const uint8_t bus_jpg_start[] asm("_binary_bus_jpg_start");
@@ -15,42 +84,109 @@ extern const uint8_t bus_jpg_end[] asm("_binary_bus_jpg_end");
 extern const uint8_t person_jpg_start[] asm("_binary_person_jpg_start");
 extern const uint8_t person_jpg_end[] asm("_binary_person_jpg_end");
 
-void test_single_image(dl::Model *model, Yolo26Processor& processor, const uint8_t *jpg_start, const uint8_t *jpg_end, const char *image_name)
+// --- Result Stream ---
+// One packet sender for the whole run (nullptr unless YOLO_RESULT_STREAM).
+Yolo26ResultStream* open_result_stream()
+{
+#if CONFIG_YOLO_RESULT_STREAM
+    static Yolo26ResultStream* stream = nullptr;
+    static Yolo26UdpSink sink;
+    if (stream) return stream;
+    if (sink.sock < 0 && !yolo26_udp_open(&sink, CONFIG_YOLO_RESULT_UDP_HOST, CONFIG_YOLO_RESULT_UDP_PORT)) return nullptr;
+
+    Yolo26ResultStreamConfig config;
+    config.send = yolo26_result_udp_send;
+    config.ctx = &sink;
+    // Widest thumbnail at the tallest supported aspect (3:4 portrait)
+    config.max_thumb_bytes = (size_t)CONFIG_YOLO_RESULT_THUMB_SIZE * (CONFIG_YOLO_RESULT_THUMB_SIZE * 4 / 3) * 2;
+    auto* s = new Yolo26ResultStream(config);
+    if (!s->init()) {
+        delete s;
+        return nullptr;
+    }
+    stream = s;
+    return stream;
+#else
+    return nullptr;
+#endif
+}
+
+// Packs the detections (source pixels) and an optional thumbnail of `img` straight into a packet slot.
+void stream_results(const std::vector<Detection>& results, const dl::image::img_t& img)
+{
+    Yolo26ResultStream* stream = open_result_stream();
+    Yolo26ResultSlot slot;
+    if (!stream || !stream->acquire(&slot)) return;
+    int n = std::min((int)results.size(), slot.capacity);
+    for (int i = 0; i < n; i++) slot.detections[i] = yolo26_quantize_detection(results[i]);
+
+    Yolo26ResultInfo info;
+    info.frame_w = img.width;
+    info.frame_h = img.height;
+#if CONFIG_YOLO_RESULT_STREAM
+    int tw = CONFIG_YOLO_RESULT_THUMB_SIZE;
+    int th = img.width > 0 ? std::min(tw * img.height / img.width, tw * 4 / 3) : 0;
+    if (tw > 0 && th > 0) {
+        info.thumb_format = YOLO_THUMB_RGB565;
+        info.thumb_w = tw;
+        info.thumb_h = th;
+        info.thumb_bytes = yolo26_make_thumbnail(img, slot.thumbnail, tw, th);
+    }
+#endif
+    stream->commit(slot, n, info);
+}
+
+void print_result_stream_stats()
+{
+    Yolo26ResultStream* stream = open_result_stream();
+    if (!stream) return;
+    Yolo26ResultStreamStats s = stream->get_stats();
+    printf("Result stream: %lu published | %lu sent | %lu superseded | %lu failed | %llu bytes\n",
+           (unsigned long)s.published, (unsigned long)s.sent, (unsigned long)s.superseded, (unsigned long)s.failed,
+           (unsigned long long)s.bytes);
+}
+
+void test_single_image(dl::Model *model, YoloAppProcessor& processor, Yolo26Profiler& profiler,
+                       const uint8_t *jpg_start, const uint8_t *jpg_end, const char *image_name)
 {
     printf("\n=== Testing: %s ===\n", image_name);
     
     // 1. Decode JPEG
+    profiler.begin(YOLO_STAGE_DECODE);
     auto img = processor.decode_jpeg(jpg_start, (size_t)(jpg_end - jpg_start));
+    uint32_t lat_dec = profiler.end(YOLO_STAGE_DECODE);
     
-    auto resized_img = processor.resize(img, model->get_inputs());
+    // 2. Resize / letterbox
+    Yolo26Transform xf;
+    profiler.begin(YOLO_STAGE_RESIZE);
+    auto resized_img = processor.resize(img, model->get_inputs(), &xf);
+    uint32_t lat_rsz = profiler.end(YOLO_STAGE_RESIZE);
     
-    // 2. Preprocess (Measure Time)
-    TickType_t start_pre = xTaskGetTickCount();
+    // 3. Preprocess
+    profiler.begin(YOLO_STAGE_PREPROCESS);
     processor.preprocess(resized_img, model->get_inputs());
-    TickType_t end_pre = xTaskGetTickCount();
+    uint32_t lat_pre = profiler.end(YOLO_STAGE_PREPROCESS);
     
-    // 3. Inference (Measure Time)
-    TickType_t start_inf = xTaskGetTickCount();
+    // 4. Inference
+    profiler.begin(YOLO_STAGE_INFERENCE);
     model->run();
-    TickType_t end_inf = xTaskGetTickCount();
-
-    // 4. Post-Process (Measure Time)
-    TickType_t start_post = xTaskGetTickCount();
-    auto results = processor.postprocess(model->get_outputs());
-    TickType_t end_post = xTaskGetTickCount();
+    uint32_t lat_inf = profiler.end(YOLO_STAGE_INFERENCE);
 
-    // Calculate Latencies
-    uint32_t lat_pre = (end_pre - start_pre) * portTICK_PERIOD_MS;
-    uint32_t lat_inf = (end_inf - start_inf) * portTICK_PERIOD_MS;
-    uint32_t lat_post = (end_post - start_post) * portTICK_PERIOD_MS;
+    // 5. Post-Process
+    profiler.begin(YOLO_STAGE_POSTPROCESS);
+    auto results = processor.postprocess(model->get_outputs(), &xf); // Boxes in source pixels
+    uint32_t lat_post = profiler.end(YOLO_STAGE_POSTPROCESS);
+    stream_results(results, img); // Before the console log: the packet leaves on the sender task
 
     printf("Timings:\n");
-    printf("  Pre-process:  %lu ms\n", (unsigned long)lat_pre);
-    printf("  Inference:    %lu ms\n", (unsigned long)lat_inf);
-    printf("  Post-process: %lu ms\n", (unsigned long)lat_post);
-    printf("  Total:        %lu ms\n", (unsigned long)(lat_pre + lat_inf + lat_post));
+    printf("  Decode:       %8.3f ms\n", lat_dec / 1000.0f);
+    printf("  Resize:       %8.3f ms\n", lat_rsz / 1000.0f);
+    printf("  Pre-process:  %8.3f ms\n", lat_pre / 1000.0f);
+    printf("  Inference:    %8.3f ms\n", lat_inf / 1000.0f);
+    printf("  Post-process: %8.3f ms\n", lat_post / 1000.0f);
+    printf("  Total:        %8.3f ms\n", (lat_dec + lat_rsz + lat_pre + lat_inf + lat_post) / 1000.0f);
 
-    printf("\n--- Top Detections ---\n");
+    printf("\n--- Top Detections (%dx%d source) ---\n", img.width, img.height);
     int count = 0;
     for (const auto& det : results) {
         if (count >= 5) break;
@@ -77,6 +213,307 @@ void test_single_image(dl::Model *model, Yolo26Processor& processor, const uint8
     heap_caps_free(img.data);
 }
 
+// --- Class Rules ---
+// Allow-list and per-class thresholds from menuconfig ("0,1,2" and "0:0.30,2:0.25").
+// Returns false if neither is set.
+bool apply_class_rules(YoloAppProcessor& processor)
+{
+    int ids[80];
+    int n_ids = 0;
+    for (const char* p = CONFIG_YOLO_CLASS_ALLOW_LIST; *p && n_ids < 80;) {
+        char* end;
+        long id = strtol(p, &end, 10);
+        if (end == p) break;
+        ids[n_ids++] = (int)id;
+        p = *end == ',' ? end + 1 : end;
+    }
+    processor.set_allowed_classes(ids, n_ids);
+
+    bool any_thresh = false;
+    for (const char* p = CONFIG_YOLO_CLASS_THRESHOLDS; *p;) {
+        char* end;
+        long id = strtol(p, &end, 10);
+        if (end == p || *end != ':') break;
+        p = end + 1;
+        float conf = strtof(p, &end);
+        if (end == p) break;
+        processor.set_class_threshold((int)id, conf);
+        any_thresh = true;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return n_ids > 0 || any_thresh;
+}
+
+// --- Duplicate Suppression ---
+// Re-decodes the last model outputs with the top-K suppression pass on, then turns it off again.
+void run_suppression_demo(dl::Model *model, YoloAppProcessor& processor)
+{
+#if CONFIG_YOLO_SUPPRESS_IOU > 0
+    printf("\n=== Duplicate Suppression (IoU > %d%%) ===\n", CONFIG_YOLO_SUPPRESS_IOU);
+    int64_t t0 = esp_timer_get_time();
+    auto plain = processor.postprocess(model->get_outputs());
+    int64_t t1 = esp_timer_get_time();
+    processor.set_suppression(true, CONFIG_YOLO_SUPPRESS_IOU / 100.0f);
+    auto results = processor.postprocess(model->get_outputs());
+    int64_t t2 = esp_timer_get_time();
+    processor.set_suppression(false);
+    printf("%d -> %d detections | post-process %.3f ms -> %.3f ms\n", (int)plain.size(), (int)results.size(),
+           (t1 - t0) / 1000.0f, (t2 - t1) / 1000.0f);
+#endif
+}
+
+// --- Compact Detections ---
+// Re-decodes the last model outputs as DetectionQ (integer box decode) and compares with the float list.
+void run_compact_demo(dl::Model *model, YoloAppProcessor& processor)
+{
+    printf("\n=== Compact Detections ===\n");
+    Detection full[YOLO_TARGET_K];
+    DetectionQ compact[YOLO_TARGET_K];
+    int64_t t0 = esp_timer_get_time();
+    int n = processor.postprocess_into(model->get_outputs(), full, YOLO_TARGET_K);
+    int64_t t1 = esp_timer_get_time();
+    int nq = processor.postprocess_into(model->get_outputs(), compact, YOLO_TARGET_K);
+    int64_t t2 = esp_timer_get_time();
+    int same = 0;
+    for (int i = 0; i < n && i < nq; i++) {
+        DetectionQ q = yolo26_quantize_detection(full[i]);
+        same += memcmp(&q, &compact[i], sizeof(DetectionQ)) == 0;
+    }
+    printf("%d detections: %u B -> %u B | post-process %.3f ms -> %.3f ms | %d/%d identical at 1/%d px\n", nq,
+           (unsigned)(n * sizeof(Detection)), (unsigned)(nq * sizeof(DetectionQ)), (t1 - t0) / 1000.0f,
+           (t2 - t1) / 1000.0f, same, n, 1 << YOLO_DETQ_FRAC_BITS);
+}
+
+// --- Early Exit ---
+// Answers "anything there?" from the last model outputs, then a coarse-to-fine postprocess().
+void run_early_exit_demo(dl::Model *model, YoloAppProcessor& processor)
+{
+    printf("\n=== Early Exit ===\n");
+    Detection hit;
+    int64_t t0 = esp_timer_get_time();
+    bool present = processor.query_presence(model->get_outputs(), &hit);
+    int64_t t1 = esp_timer_get_time();
+    if (present) {
+        printf("Presence: %s (%.2f%%) after %d cells (%.3f ms)\n", coco_classes[hit.class_id], hit.score * 100.0f,
+               processor.get_last_scan_cells(), (t1 - t0) / 1000.0f);
+    } else {
+        printf("Presence: none after %d cells (%.3f ms)\n", processor.get_last_scan_cells(), (t1 - t0) / 1000.0f);
+    }
+
+    processor.set_early_exit(1);
+    t0 = esp_timer_get_time();
+    auto results = processor.postprocess(model->get_outputs());
+    t1 = esp_timer_get_time();
+    printf("Early exit: %d detections from %d cells (%.3f ms)\n", (int)results.size(),
+           processor.get_last_scan_cells(), (t1 - t0) / 1000.0f);
+    processor.set_early_exit(0);
+}
+
+// Re-decodes the last model outputs under the class rules (boxes in model pixels).
+void run_class_rules_demo(dl::Model *model, YoloAppProcessor& processor)
+{
+    if (!apply_class_rules(processor)) return;
+    printf("\n=== Class Rules (allow: \"%s\", thresholds: \"%s\") ===\n",
+           CONFIG_YOLO_CLASS_ALLOW_LIST, CONFIG_YOLO_CLASS_THRESHOLDS);
+    int64_t t0 = esp_timer_get_time();
+    auto results = processor.postprocess(model->get_outputs());
+    printf("Post-process: %.3f ms\n", (esp_timer_get_time() - t0) / 1000.0f);
+    for (size_t i = 0; i < results.size() && i < 5; i++) {
+        const Detection& det = results[i];
+        printf("Det %d: %s (%.2f%%) | Box: [%.1f, %.1f, %.1f, %.1f]\n", (int)i + 1, coco_classes[det.class_id],
+               det.score * 100.0f, det.x1, det.y1, det.x2, det.y2);
+    }
+    processor.clear_class_rules();
+}
+
+// --- Raw Tensor Dump ---
+// One dump for the whole run, sized from the first model; every demo model has the same tensors.
+Yolo26TensorDump* open_tensor_dump(dl::Model *model)
+{
+#if YOLO_APP_DUMP
+    static Yolo26TensorDump* dump = nullptr;
+    if (dump) return dump;
+
+    Yolo26DumpConfig config;
+#if CONFIG_YOLO_DUMP_INPUT
+    config.include_input = true;
+#endif
+    config.every_n = CONFIG_YOLO_DUMP_EVERY_N;
+#if CONFIG_YOLO_DUMP_UART
+    if (!yolo26_dump_uart_init((uart_port_t)CONFIG_YOLO_DUMP_UART_PORT, CONFIG_YOLO_DUMP_UART_BAUD)) return nullptr;
+    config.write = yolo26_dump_uart_write;
+    config.ctx = (void*)(intptr_t)CONFIG_YOLO_DUMP_UART_PORT;
+#elif CONFIG_YOLO_DUMP_USB_JTAG
+    if (!yolo26_dump_usb_init()) return nullptr;
+    config.write = yolo26_dump_usb_write;
+#else
+    FILE* f = fopen(CONFIG_YOLO_DUMP_FILE_PATH, "ab");
+    if (!f) {
+        printf("Tensor dump: cannot open %s\n", CONFIG_YOLO_DUMP_FILE_PATH);
+        return nullptr;
+    }
+    config.write = yolo26_dump_file_write;
+    config.ctx = f;
+#endif
+    auto* d = new Yolo26TensorDump(config);
+    if (!d->init(model->get_outputs(), model->get_inputs())) {
+        delete d;
+        return nullptr;
+    }
+    dump = d;
+    return dump;
+#else
+    return nullptr;
+#endif
+}
+
+void print_dump_stats(Yolo26TensorDump* dump)
+{
+    if (!dump) return;
+    Yolo26DumpStats s = dump->get_stats();
+    printf("Tensor dump: %lu written | %lu dropped | %lu failed | %llu bytes\n", (unsigned long)s.written,
+           (unsigned long)s.dropped, (unsigned long)s.failed, (unsigned long long)s.bytes);
+}
+
+// --- Model Slots ---
+// Loads the A/B slot state, optionally checks the active image and installs a pending update
+// file. A model update never touches the firmware partition.
+void init_model_slots()
+{
+#if CONFIG_YOLO_MODEL_PARTITION
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        nvs_flash_erase();
+        err = nvs_flash_init();
+    }
+    if (err != ESP_OK || !model_slots.init()) {
+        printf("Model slots unavailable, using '%s'\n", model_slots.get_active_label());
+        return;
+    }
+#if CONFIG_YOLO_MODEL_VERIFY_ON_BOOT
+    if (!model_slots.verify(model_slots.get_active())) model_slots.rollback();
+#endif
+    const char* update_path = CONFIG_YOLO_MODEL_UPDATE_PATH;
+    FILE* f = *update_path ? fopen(update_path, "rb") : nullptr;
+    if (f) {
+        fclose(f);
+        uint32_t version = model_slots.get_info(model_slots.get_active()).version + 1;
+        printf("Installing model update %s into slot '%s'\n", update_path, model_slots.get_label(model_slots.get_active() ^ 1));
+        // This boot builds the model from the new slot: on trial straight away
+        if (yolo26_model_update_from_file(model_slots, update_path, version, true)) {
+            remove(update_path); // Installed: do not install again on the next boot
+        }
+    }
+    model_slots.print_summary();
+#endif
+}
+
+// Called once a model built from the active slot has produced detections.
+void confirm_model_slot()
+{
+#if CONFIG_YOLO_MODEL_PARTITION
+    model_slots.confirm();
+#endif
+}
+
+#if CONFIG_YOLO_FAST_STARTUP
+// --- Cold Start ---
+// Time to first detection as after a PIR wake-up: the model builds on core 1 while this task
+// brings up the "camera" (here: decoding bus.jpg stands in for sensor init and the first capture).
+RTC_DATA_ATTR static uint32_t boot_count; // Survives deep sleep
+
+void run_startup_demo(Yolo26StartupTimer& timer)
+{
+    printf("\n=== Cold Start (boot %lu, wake-up: %s) ===\n", (unsigned long)++boot_count, yolo26_wake_cause_name());
+#if CONFIG_YOLO_MODEL_PARTITION
+    if (!yolo26_find_model_partition(YOLO_APP_MODEL_ADDRESS)) return;
+#endif
+    Yolo26ModelLoaderConfig loader_config;
+    loader_config.max_internal_size = YOLO_APP_MODEL_INTERNAL_SIZE;
+    Yolo26ModelLoader loader(loader_config);
+    if (!loader.start(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION)) return;
+    timer.mark("loader_started");
+
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+    auto img = processor.decode_jpeg(bus_jpg_start, (size_t)(bus_jpg_end - bus_jpg_start));
+    timer.mark("first_frame");
+
+    dl::Model *model = loader.wait();
+    timer.mark("model_ready");
+    if (!model) {
+#if CONFIG_YOLO_MODEL_PARTITION
+        if (model_slots.rollback()) printf("Rolled back to model slot '%s'\n", model_slots.get_active_label());
+#endif
+        heap_caps_free(img.data);
+        return;
+    }
+
+    Yolo26Transform xf;
+    auto resized_img = processor.resize(img, model->get_inputs(), &xf);
+    processor.preprocess(resized_img, model->get_inputs());
+    model->run();
+    auto results = processor.postprocess(model->get_outputs(), &xf);
+    timer.mark("first_detection");
+    confirm_model_slot();
+
+    timer.print("Startup timeline");
+    int64_t wait_us = timer.get("model_ready") - timer.get("first_frame");
+    printf("Time to first detection: %.1f ms | model build %.1f ms, %.1f ms of it hidden behind the frame\n",
+           timer.get("first_detection") / 1000.0f, loader.get_build_us() / 1000.0f,
+           (loader.get_build_us() - wait_us) / 1000.0f);
+    if (!results.empty()) {
+        printf("First detection: %s (%.2f%%)\n", coco_classes[results.front().class_id], results.front().score * 100.0f);
+    }
+
+    if (resized_img.data != img.data) {
+        heap_caps_free(resized_img.data);
+    }
+    heap_caps_free(img.data);
+    delete model;
+}
+#endif
+
+// --- Dual-Core Processing ---
+// Splits quantization and the postprocess scan with a worker on core 1, which is free while
+// this task is not inside model->run(). The pipeline keeps its stages single-core: core 1 runs
+// inference there.
+void enable_dual_core(Yolo26Executor& executor, YoloAppProcessor& processor)
+{
+#if CONFIG_YOLO_DUAL_CORE
+    if (executor.start()) {
+        processor.set_executor(&executor);
+        printf("Pre/post-processing split across both cores\n");
+    }
+#endif
+}
+
+// --- Hardware Image Path ---
+// JPEG codec for decode and PPA for resize on the ESP32-P4: both run as 2D-DMA transactions
+// while this task sleeps. Whatever fails to open stays in software.
+void enable_accel(Yolo26Accel& accel, YoloAppProcessor& processor)
+{
+#if CONFIG_YOLO_HW_ACCEL
+    if (accel.init()) {
+        processor.set_accel(&accel);
+        printf("Hardware image path: JPEG %s, PPA resize %s\n", accel.has_jpeg() ? "on" : "off",
+               accel.has_ppa() ? "on" : "off");
+    }
+#endif
+}
+
+// --- Memory Placement ---
+// Where the processor's hot state and the model outputs postprocess() reads ended up. If the
+// p5 heads show PSRAM, raising CONFIG_YOLO_MODEL_INTERNAL_KB lets esp-dl plan them internally.
+void report_memory_placement(dl::Model* model, const YoloAppProcessor& processor)
+{
+    processor.print_memory_placement();
+    printf("Model outputs (internal budget %d KB):\n", CONFIG_YOLO_MODEL_INTERNAL_KB);
+    for (const auto& kv : model->get_outputs()) {
+        yolo26_print_placement(kv.first.c_str(), kv.second->data, kv.second->get_bytes());
+    }
+}
+
 void run_inference_demo()
 {
     printf("\n");
@@ -85,22 +522,512 @@ void run_inference_demo()
     printf("======================================================================\n");
     
     // Load Model
-    dl::Model *model = new dl::Model((const char *)yolo26n_inference_espdl, 
-                                     fbs::MODEL_LOCATION_IN_FLASH_RODATA);
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
     
     // Init Processor (Stateful config)
     // Using default K=300, Thresh=0.10, COCO classes
-    Yolo26Processor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    Yolo26Executor executor; // Declared first: outlive the processor that uses them
+    Yolo26Accel accel;
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+    enable_dual_core(executor, processor);
+    enable_accel(accel, processor);
+    printf("Quantize kernel: %s\n", processor.get_quant_kernel_name());
+    report_memory_placement(model, processor);
 
     // Run Tests
-    test_single_image(model, processor, bus_jpg_start, bus_jpg_end, "bus.jpg");
-    test_single_image(model, processor, person_jpg_start, person_jpg_end, "person.jpg");
+    static Yolo26Profiler profiler; // ~4 KB: kept off the main task stack
+    profiler.reset();
+    Yolo26TensorDump* dump = open_tensor_dump(model);
+    test_single_image(model, processor, profiler, bus_jpg_start, bus_jpg_end, "bus.jpg");
+    if (dump) dump->submit(model->get_outputs(), &model->get_inputs()); // Outputs still hold this frame
+    test_single_image(model, processor, profiler, person_jpg_start, person_jpg_end, "person.jpg");
+    if (dump) dump->submit(model->get_outputs(), &model->get_inputs());
+    run_suppression_demo(model, processor); // Outputs still hold person.jpg
+    run_compact_demo(model, processor);
+    run_early_exit_demo(model, processor);
+    run_class_rules_demo(model, processor);
+    confirm_model_slot();
+
+    printf("\n--- Profile ---\n");
+#if CONFIG_YOLO_PROFILE_LAYERS
+    profiler.capture_layers(model); // Runs the model once more
+#endif
+    profiler.print_summary();
+    profiler.print_json(YOLO_APP_MODEL_TAG);
+    print_result_stream_stats();
     
     delete model;
     printf("\n=== Test Complete ===\n");
 }
 
+#if CONFIG_YOLO_ARENA_DEMO
+// --- Zero-Allocation Demo ---
+// Decode, resize and postprocess all run out of a Yolo26Arena; after one warm-up frame
+// the heap must look exactly the same after CONFIG_YOLO_ARENA_DEMO_FRAMES more frames.
+void run_arena_demo()
+{
+    printf("\n=== Arena Steady State (%d frames) ===\n", CONFIG_YOLO_ARENA_DEMO_FRAMES);
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+
+    Yolo26Arena arena;
+    Yolo26ArenaConfig arena_config; // 2 x 1920x1080 slots: decoded frame + resized frame
+    if (!arena.init(arena_config) || !processor.use_arena(arena)) {
+        printf("Arena setup failed\n");
+        delete model;
+        return;
+    }
+    Detection* detections = (Detection*)arena.alloc_internal(sizeof(Detection) * YOLO_TARGET_K);
+    if (!detections) {
+        delete model;
+        return;
+    }
+    printf("Arena: %u / %u B internal, %d x %u B frames\n",
+           (unsigned)arena.get_internal_used(), (unsigned)arena.get_internal_size(),
+           arena.get_frame_slots(), (unsigned)arena.get_frame_bytes());
+
+    auto run_frame = [&](const uint8_t* jpg_start, const uint8_t* jpg_end) {
+        Yolo26Frame decoded = arena.acquire_frame();
+        Yolo26Frame resized = arena.acquire_frame();
+        if (!processor.decode_jpeg_into(jpg_start, (size_t)(jpg_end - jpg_start), decoded)) return -1;
+
+        Yolo26Transform xf;
+        dl::image::img_t input = processor.resize_into(decoded.img, resized, model->get_inputs(), &xf);
+        if (!input.data) return -1;
+        processor.preprocess(input, model->get_inputs());
+        model->run();
+        return processor.postprocess_into(model->get_outputs(), detections, YOLO_TARGET_K, &xf);
+    };
+
+    // Warm-up: first-run allocations inside esp-dl and the decoders are not steady state.
+    run_frame(bus_jpg_start, bus_jpg_end);
+
+    Yolo26HeapWatermark before = Yolo26HeapWatermark::capture();
+    for (int i = 0; i < CONFIG_YOLO_ARENA_DEMO_FRAMES; i++) {
+        bool bus = (i % 2) == 0;
+        int n = bus ? run_frame(bus_jpg_start, bus_jpg_end) : run_frame(person_jpg_start, person_jpg_end);
+        printf("Frame %d: %d detections (top: %s)\n", i, n, n > 0 ? coco_classes[detections[0].class_id] : "-");
+    }
+    before.check(Yolo26HeapWatermark::capture(), "arena steady state");
+
+    delete model;
+}
+#endif
+
+#if CONFIG_YOLO_TILING_DEMO
+// --- Tiled Inference Demo ---
+// bus.jpg at full resolution in model-sized tiles. The second frame is identical, so every
+// tile is skipped by the motion gate and the cached detections are re-emitted.
+void run_tiling_demo()
+{
+    printf("\n=== Tiled Inference (%d frames) ===\n", CONFIG_YOLO_TILING_DEMO_FRAMES);
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+
+    auto img = processor.decode_jpeg(bus_jpg_start, (size_t)(bus_jpg_end - bus_jpg_start));
+    Yolo26TilerT<YoloAppProcessor> tiler(model, processor);
+    std::vector<Detection> detections(YOLO_TARGET_K);
+    if (img.data && tiler.set_grid(img.width, img.height)) {
+        printf("%dx%d frame -> %d tiles\n", img.width, img.height, tiler.get_tile_count());
+        for (int f = 0; f < CONFIG_YOLO_TILING_DEMO_FRAMES; f++) {
+            int64_t t0 = esp_timer_get_time();
+            int n = tiler.process(img, detections.data(), (int)detections.size());
+            printf("Frame %d: %d tiles run, %d detections | %lld ms\n", f, tiler.get_tiles_run(), n,
+                   (long long)((esp_timer_get_time() - t0) / 1000));
+            for (int i = 0; i < n && i < 5; i++) {
+                const Detection& det = detections[i];
+                printf("  %s (%.2f%%) | Box: [%.1f, %.1f, %.1f, %.1f]\n", coco_classes[det.class_id],
+                       det.score * 100.0f, det.x1, det.y1, det.x2, det.y2);
+            }
+        }
+    }
+
+    heap_caps_free(img.data);
+    delete model;
+}
+#endif
+
+#if CONFIG_YOLO_CAMERA_FORMAT_DEMO
+// --- Native Camera Formats ---
+// A MIPI-CSI sensor delivers RGB565 or YUV422. bus.jpg is repacked into both as a stand-in,
+// then each frame is converted, letterboxed/stretched and quantized in a single preprocess().
+static void pack_camera_frame(const dl::image::img_t& rgb, uint8_t* out, Yolo26PixelFormat format)
+{
+    const uint8_t* px = (const uint8_t*)rgb.data;
+    size_t n = (size_t)rgb.width * rgb.height;
+    for (size_t i = 0; i < n; i++, px += 3) {
+        if (format == YOLO_PIX_RGB565_LE) {
+            uint16_t p = (uint16_t)((px[0] >> 3) << 11 | (px[1] >> 2) << 5 | (px[2] >> 3));
+            out[i * 2] = (uint8_t)p;
+            out[i * 2 + 1] = (uint8_t)(p >> 8);
+            continue;
+        }
+        // UYVY: BT.601 full range, chroma from the even pixel of each pair
+        int y = (77 * px[0] + 150 * px[1] + 29 * px[2]) >> 8;
+        out[i * 2 + 1] = (uint8_t)y;
+        if (i % 2 == 0) {
+            out[i * 2] = (uint8_t)std::clamp(128 + ((-43 * px[0] - 85 * px[1] + 128 * px[2]) >> 8), 0, 255);
+            out[i * 2 + 2] = (uint8_t)std::clamp(128 + ((128 * px[0] - 107 * px[1] - 21 * px[2]) >> 8), 0, 255);
+        }
+    }
+}
+
+void run_camera_format_demo()
+{
+    printf("\n=== Native Camera Formats ===\n");
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+
+    auto img = processor.decode_jpeg(bus_jpg_start, (size_t)(bus_jpg_end - bus_jpg_start));
+    uint8_t* packed = img.data ? (uint8_t*)heap_caps_malloc((size_t)img.width * img.height * 2, MALLOC_CAP_SPIRAM) : nullptr;
+    if (packed) {
+        const Yolo26PixelFormat formats[] = {YOLO_PIX_RGB565_LE, YOLO_PIX_UYVY};
+        const char* names[] = {"RGB565", "UYVY"};
+        for (int f = 0; f < 2; f++) {
+            pack_camera_frame(img, packed, formats[f]);
+            Yolo26CameraFrame frame;
+            frame.data = packed;
+            frame.width = img.width;
+            frame.height = img.height;
+            frame.format = formats[f];
+
+            Yolo26Transform xf;
+            int64_t t0 = esp_timer_get_time();
+            bool ok = processor.preprocess(frame, model->get_inputs(), &xf);
+            int64_t t1 = esp_timer_get_time();
+            if (!ok) continue;
+            model->run();
+            auto results = processor.postprocess(model->get_outputs(), &xf);
+            printf("%-6s %dx%d -> preprocess %.3f ms, %d detections\n", names[f], img.width, img.height,
+                   (t1 - t0) / 1000.0f, (int)results.size());
+            for (size_t i = 0; i < results.size() && i < 3; i++) {
+                const Detection& det = results[i];
+                printf("  %s (%.2f%%) | Box: [%.1f, %.1f, %.1f, %.1f]\n", coco_classes[det.class_id],
+                       det.score * 100.0f, det.x1, det.y1, det.x2, det.y2);
+            }
+        }
+    }
+
+    heap_caps_free(packed);
+    heap_caps_free(img.data);
+    delete model;
+}
+#endif
+
+#if CONFIG_YOLO_TRACKING_DEMO
+// --- Tracking Demo ---
+// A 640x640 window pans across bus.jpg by 2 px per camera frame. Inference runs on every
+// CONFIG_YOLO_TRACKING_INFER_EVERY-th frame (2 fps at 30 fps); every frame prints the boxes the tracker
+// predicts, in window coordinates, so the objects appear to move left at 60 px/s.
+void run_tracking_demo()
+{
+    printf("\n=== Tracking (%d frames, inference every %d) ===\n", CONFIG_YOLO_TRACKING_DEMO_FRAMES, CONFIG_YOLO_TRACKING_INFER_EVERY);
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+    static Yolo26Tracker tracker; // ~4 KB: kept off the main task stack
+    tracker.reset();
+
+    auto img = processor.decode_jpeg(bus_jpg_start, (size_t)(bus_jpg_end - bus_jpg_start));
+    const int win = std::min<int>(640, std::min(img.width, img.height));
+    const int step = 2;
+    const int64_t frame_us = 33333;
+    Yolo26TrackedBox boxes[8];
+    for (int f = 0; img.data && f < CONFIG_YOLO_TRACKING_DEMO_FRAMES; f++) {
+        int x0 = std::min(f * step, img.width - win);
+        int64_t t_us = f * frame_us;
+        if (f % CONFIG_YOLO_TRACKING_INFER_EVERY == 0) {
+            Yolo26Transform xf;
+            if (!processor.preprocess_region(img, {x0, 0, win, win}, model->get_inputs(), &xf)) break;
+            model->run();
+            auto results = processor.postprocess(model->get_outputs(), &xf);
+            for (auto& det : results) { // Full-frame -> window coordinates
+                det.x1 -= x0;
+                det.x2 -= x0;
+            }
+            int matched = tracker.update(results, t_us);
+            printf("Frame %2d: inference, %d detections, %d tracks matched\n", f, (int)results.size(), matched);
+        }
+        int n = tracker.predict(t_us, boxes, 8);
+        if (f % 5 != 0) continue; // Print every 5th frame
+        printf("Frame %2d: %d tracks\n", f, n);
+        for (int i = 0; i < n && i < 4; i++) {
+            const Yolo26TrackedBox& b = boxes[i];
+            printf("  #%d %s | Box: [%.1f, %.1f, %.1f, %.1f] | v: %.0f, %.0f px/s\n", b.track_id,
+                   coco_classes[b.det.class_id], b.det.x1, b.det.y1, b.det.x2, b.det.y2, b.vx, b.vy);
+        }
+    }
+
+    heap_caps_free(img.data);
+    delete model;
+}
+#endif
+
+#if CONFIG_YOLO_BATCH_DEMO
+// --- Multi-Stream Demo ---
+// Three "cameras" (bus.jpg, person.jpg, bus.jpg letterboxed) submit a frame every round, but
+// each round only has time for two: the scheduler rotates so every stream gets served, and a
+// frame left waiting is replaced by the stream's next one.
+static void batch_demo_publish(const Yolo26StreamResult& result, void*)
+{
+    const char* top = result.count > 0 ? coco_classes[result.detections[0].class_id] : "-";
+    printf("  stream %d: %d detections (top: %s)\n", result.stream, result.count, top);
+}
+
+void run_batch_demo()
+{
+    printf("\n=== Multi-Stream (%d rounds, 3 streams, 2 frames per round) ===\n", CONFIG_YOLO_BATCH_DEMO_ROUNDS);
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    Yolo26BatchConfig config;
+    config.publish = batch_demo_publish;
+    Yolo26StreamBatch<YoloAppProcessor> batch(model, processor, config);
+
+    Yolo26StreamConfig lobby; // Defaults: stretch, global threshold
+    Yolo26StreamConfig door;
+    door.conf_thresh = 0.30f;
+    door.max_detections = 8;
+    Yolo26StreamConfig street;
+    street.resize_mode = YOLO_RESIZE_LETTERBOX;
+    batch.add_stream(lobby);
+    batch.add_stream(door);
+    batch.add_stream(street);
+
+    Yolo26StreamFrame frames[3];
+    frames[0].jpg_data = frames[2].jpg_data = bus_jpg_start;
+    frames[0].jpg_len = frames[2].jpg_len = (size_t)(bus_jpg_end - bus_jpg_start);
+    frames[1].jpg_data = person_jpg_start;
+    frames[1].jpg_len = (size_t)(person_jpg_end - person_jpg_start);
+
+    for (int round = 0; round < CONFIG_YOLO_BATCH_DEMO_ROUNDS; round++) {
+        for (int s = 0; s < 3; s++) {
+            frames[s].capture_us = esp_timer_get_time();
+            batch.submit(s, frames[s]);
+        }
+        printf("Round %d:\n", round);
+        batch.run(2);
+    }
+    batch.run(); // Drain
+    for (int s = 0; s < batch.get_stream_count(); s++) {
+        Yolo26StreamStats st = batch.get_stats(s);
+        printf("Stream %d: %lu served, %lu replaced, %.1f ms per frame\n", s, (unsigned long)st.frames,
+               (unsigned long)st.replaced, st.frames ? st.total_us / 1000.0f / st.frames : 0.0f);
+    }
+    delete model;
+}
+#endif
+
+#if CONFIG_YOLO_PIPELINE_DEMO
+// --- Streaming Pipeline Demo ---
+// Feeds the two embedded JPEGs alternately, standing in for a camera.
+struct PipelineDemoSource {
+    std::atomic<int> captured{0};
+    std::atomic<int> published{0};
+};
+
+static bool demo_capture(Yolo26CapturedFrame* frame, void* ctx)
+{
+    auto* src = static_cast<PipelineDemoSource*>(ctx);
+    int n = src->captured;
+    if (n >= CONFIG_YOLO_PIPELINE_DEMO_FRAMES) return false;
+    src->captured = n + 1;
+
+    bool bus = (n / 2) % 2 == 0; // Each image twice: the repeat is gated out by the motion gate
+    frame->jpg_data = bus ? bus_jpg_start : person_jpg_start;
+    frame->jpg_len = bus ? (size_t)(bus_jpg_end - bus_jpg_start) : (size_t)(person_jpg_end - person_jpg_start);
+    frame->user_handle = nullptr;
+    return true;
+}
+
+static void demo_publish(const Yolo26PipelineResult& result, void* ctx)
+{
+    auto* src = static_cast<PipelineDemoSource*>(ctx);
+    const char* top = result.detections->empty() ? "-" : coco_classes[result.detections->front().class_id];
+    printf("Frame %lu: %u detections (top: %s)%s | latency %lld ms\n",
+           (unsigned long)result.frame_id, (unsigned)result.detections->size(), top,
+           result.cached ? " [cached]" : "", (long long)(result.latency_us / 1000));
+    if (Yolo26ResultStream* stream = open_result_stream()) {
+        stream->publish(result.detections->data(), (int)result.detections->size());
+    }
+    src->published++;
+}
+
+void run_pipeline_demo()
+{
+    printf("\n=== Streaming Pipeline (%d frames) ===\n", CONFIG_YOLO_PIPELINE_DEMO_FRAMES);
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+
+    PipelineDemoSource source;
+    Yolo26PipelineConfig config;
+    config.capture = demo_capture;
+    config.publish = demo_publish;
+    config.user_ctx = &source;
+    config.motion_gate = true;
+    config.dump = open_tensor_dump(model);
+
+    {
+        Yolo26PipelineT<YoloAppProcessor> pipeline(model, processor, config);
+        if (pipeline.start()) {
+            // Dropped frames are never published.
+            auto dropped = [&]() {
+                Yolo26PipelineStats s = pipeline.get_stats();
+                return (int)(s.decode.dropped + s.preprocess.dropped);
+            };
+            while (source.published + dropped() < CONFIG_YOLO_PIPELINE_DEMO_FRAMES) {
+                vTaskDelay(pdMS_TO_TICKS(100));
+            }
+            pipeline.print_stats();
+            pipeline.stop();
+            print_dump_stats(config.dump);
+            print_result_stream_stats();
+        }
+    }
+
+    delete model;
+    printf("\n=== Pipeline Complete ===\n");
+}
+#endif
+
+#if CONFIG_YOLO_MODEL_REGISTRY
+// --- Model Switching Demo ---
+// Both resolutions in one Yolo26ModelRegistry. Frames run on 512; a detection close to the
+// threshold re-runs the frame on 640, which is held until the scene is certain again.
+void run_model_switch_demo()
+{
+    printf("\n=== Model Switching (%d frames) ===\n", CONFIG_YOLO_MODEL_SWITCH_DEMO_FRAMES);
+
+    Yolo26ModelRegistryConfig reg_config;
+    reg_config.max_internal_size = YOLO_APP_MODEL_INTERNAL_SIZE;
+#if CONFIG_YOLO_MODEL_RESIDENT
+    reg_config.policy = YOLO_MODEL_RESIDENT;
+#endif
+#if !CONFIG_YOLO_MODEL_PARAM_COPY
+    reg_config.param_copy = false;
+#endif
+    Yolo26ModelRegistry registry(reg_config);
+    registry.add(YOLO_APP_MODEL_TAG, YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION);
+    registry.add(YOLO_APP_ALT_MODEL_TAG, (const char *)yolo26n_alt_espdl);
+    const int levels[2] = {registry.find("yolo26n_512"), registry.find("yolo26n_640")};
+
+    Yolo26Processor<> processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes); // Serves both shapes
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+    Yolo26EscalationConfig esc_config;
+    esc_config.decision_thresh = CONFIG_YOLO_ESCALATE_DECISION_PCT / 100.0f;
+    esc_config.margin = CONFIG_YOLO_ESCALATE_MARGIN_PCT / 100.0f;
+    Yolo26Escalation escalation(esc_config);
+    Detection detections[YOLO_TARGET_K];
+
+    // One frame at the current level: switch if needed, then decode -> infer -> postprocess
+    auto run_frame = [&](const uint8_t* jpg, size_t len, int& n) {
+        if (!registry.select(levels[escalation.get_level()])) return false;
+        dl::Model* model = registry.get();
+        Yolo26Transform xf; // decode_preprocess_jpeg() rebinds the processor to this model's shape
+        if (!processor.decode_preprocess_jpeg(jpg, len, model->get_inputs(), &xf)) return false;
+        model->run();
+        n = processor.postprocess_into(model->get_outputs(), detections, YOLO_TARGET_K, &xf);
+        return true;
+    };
+
+    for (int f = 0; f < CONFIG_YOLO_MODEL_SWITCH_DEMO_FRAMES; f++) {
+        const uint8_t* jpg = (f & 1) ? person_jpg_start : bus_jpg_start;
+        size_t len = (f & 1) ? (size_t)(person_jpg_end - person_jpg_start) : (size_t)(bus_jpg_end - bus_jpg_start);
+        int64_t t0 = esp_timer_get_time();
+        int n = 0;
+        if (!run_frame(jpg, len, n)) break;
+        bool rerun = escalation.update(detections, n);
+        if (rerun && !run_frame(jpg, len, n)) break;
+        printf("Frame %d: %s%s | %d detections | %lld ms\n", f, registry.get_tag(registry.get_active()),
+               rerun ? " (escalated)" : "", n, (long long)((esp_timer_get_time() - t0) / 1000));
+    }
+    registry.print_summary();
+}
+#endif
+
+#if CONFIG_YOLO_APP_BENCHMARK
+// --- Benchmark Suite ---
+// Repeatable workloads for firmware-to-firmware comparison: the embedded images, then seeded
+// synthetic frames from an empty scene to a crowded one.
+void run_benchmark()
+{
+    printf("\n=== Benchmark (%d warm-up + %d timed iterations) ===\n", CONFIG_YOLO_BENCH_WARMUP, CONFIG_YOLO_BENCH_ITERATIONS);
+
+    dl::Model *model = new dl::Model(YOLO_APP_MODEL_ADDRESS, YOLO_APP_MODEL_LOCATION, YOLO_APP_MODEL_INTERNAL_SIZE);
+    Yolo26Executor executor;
+    Yolo26Accel accel;
+    YoloAppProcessor processor(YOLO_TARGET_K, YOLO_CONF_THRESH, coco_classes);
+    processor.set_resize_mode(YOLO_APP_RESIZE_MODE);
+    enable_dual_core(executor, processor);
+    enable_accel(accel, processor);
+    printf("Model: %s | quantize kernel: %s\n", YOLO_APP_MODEL_TAG, processor.get_quant_kernel_name());
+
+    Yolo26BenchConfig config;
+    config.warmup = CONFIG_YOLO_BENCH_WARMUP;
+    config.iterations = CONFIG_YOLO_BENCH_ITERATIONS;
+    auto* bench = new Yolo26BenchmarkT<YoloAppProcessor>(model, processor, config); // Profiler is ~4 KB
+
+    bench->run_jpeg("bus", bus_jpg_start, (size_t)(bus_jpg_end - bus_jpg_start));
+    bench->run_jpeg("person", person_jpg_start, (size_t)(person_jpg_end - person_jpg_start));
+    bench->run_synthetic("synthetic_0", 0.0f);
+    bench->run_synthetic("synthetic_1pct", 0.01f);
+    bench->run_synthetic("synthetic_10pct", 0.10f);
+
+    confirm_model_slot();
+    delete bench;
+    delete model;
+    printf("\n=== Benchmark Complete ===\n");
+}
+#endif
+
 extern "C" void app_main(void)
 {
+#if CONFIG_YOLO_FAST_STARTUP
+    Yolo26StartupTimer timer;
+    timer.mark("app_main");
+#endif
+    init_model_slots();
+#if CONFIG_YOLO_APP_BENCHMARK
+    run_benchmark();
+    return;
+#endif
+#if CONFIG_YOLO_FAST_STARTUP
+    timer.mark("slots_ready");
+    run_startup_demo(timer);
+#if CONFIG_YOLO_PIR_WAKE_GPIO >= 0
+    yolo26_sleep_until_motion(CONFIG_YOLO_PIR_WAKE_GPIO); // PIR devices: one detection per wake-up
+#endif
+#endif
     run_inference_demo();
+#if CONFIG_YOLO_ARENA_DEMO
+    run_arena_demo();
+#endif
+#if CONFIG_YOLO_TILING_DEMO
+    run_tiling_demo();
+#endif
+#if CONFIG_YOLO_CAMERA_FORMAT_DEMO
+    run_camera_format_demo();
+#endif
+#if CONFIG_YOLO_TRACKING_DEMO
+    run_tracking_demo();
+#endif
+#if CONFIG_YOLO_BATCH_DEMO
+    run_batch_demo();
+#endif
+#if CONFIG_YOLO_PIPELINE_DEMO
+    run_pipeline_demo();
+#endif
+#if CONFIG_YOLO_MODEL_REGISTRY
+    run_model_switch_demo();
+#endif
 }
@@ -3,6 +3,10 @@ import matplotlib.pyplot as plt
 import matplotlib.patches as patches
 from PIL import Image
 import os
+import struct
+import sys
+import zlib
+import numpy as np
 
 # ======================================================================================
 # CONFIGURATION
@@ -103,6 +107,131 @@ def parse_log_string(log_content):
     
     return results
 
+# ======================================================================================
+# RAW TENSOR CAPTURES (.y26t records, framed .y26f dumps)
+# ======================================================================================
+
+# Class names for captures (the log already carries them)
+COCO_CLASSES = [
+    "person", "bicycle", "car", "motorcycle", "airplane", "bus", "train", "truck", "boat", "traffic light",
+    "fire hydrant", "stop sign", "parking meter", "bench", "bird", "cat", "dog", "horse", "sheep", "cow",
+    "elephant", "bear", "zebra", "giraffe", "backpack", "umbrella", "handbag", "tie", "suitcase", "frisbee",
+    "skis", "snowboard", "sports ball", "kite", "baseball bat", "baseball glove", "skateboard", "surfboard",
+    "tennis racket", "bottle", "wine glass", "cup", "fork", "knife", "spoon", "bowl", "banana", "apple",
+    "sandwich", "orange", "broccoli", "carrot", "hot dog", "pizza", "donut", "cake", "chair", "couch",
+    "potted plant", "bed", "dining table", "toilet", "tv", "laptop", "mouse", "remote", "keyboard",
+    "cell phone", "microwave", "oven", "toaster", "sink", "refrigerator", "book", "clock", "vase",
+    "scissors", "teddy bear", "hair drier", "toothbrush",
+]
+
+RECORD_DTYPES = {1: np.int8, 2: np.int16, 3: np.float32}
+
+def parse_record(data, pos=0):
+    """
+    Parses one .y26t record (see yolo_record.hpp).
+    Returns ({ name: (raw ndarray, exponent) }, end position).
+    """
+    magic, version, count = struct.unpack_from("<4sHH", data, pos)
+    if magic != b"Y26T" or version != 1:
+        raise ValueError("not a tensor record")
+    pos += 8
+    tensors = {}
+    for _ in range(count):
+        name_len = data[pos]
+        name = data[pos + 1:pos + 1 + name_len].decode()
+        pos += 1 + name_len
+        code, exponent, ndim = struct.unpack_from("<BbB", data, pos)
+        pos += 3
+        dims = struct.unpack_from(f"<{ndim}i", data, pos)
+        pos += 4 * ndim
+        (nbytes,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        raw = np.frombuffer(data, RECORD_DTYPES[code], nbytes // np.dtype(RECORD_DTYPES[code]).itemsize, pos)
+        tensors[name] = (raw.reshape(dims), exponent)
+        pos += nbytes
+    return tensors, pos
+
+def load_capture(path):
+    """
+    Loads a .y26t recording or a framed dump (UART / USB log capture or SD card file).
+    Bytes between frames (console log text) and frames with a bad CRC are skipped.
+    Returns a list of (sequence, time_ms, tensors).
+    """
+    with open(path, "rb") as f:
+        data = f.read()
+
+    captures = []
+    if data[:4] == b"Y26T":
+        pos = 0
+        while pos < len(data):
+            tensors, pos = parse_record(data, pos)
+            captures.append((len(captures), 0, tensors))
+        return captures
+
+    pos = data.find(b"Y26F")
+    while pos >= 0 and pos + 16 <= len(data):
+        seq, time_ms, length = struct.unpack_from("<III", data, pos + 4)
+        end = pos + 16 + length
+        if end + 4 <= len(data):
+            record = data[pos + 16:end]
+            (crc,) = struct.unpack_from("<I", data, end)
+            if zlib.crc32(record) == crc:
+                captures.append((seq, time_ms, parse_record(record)[0]))
+                pos = data.find(b"Y26F", end + 4)
+                continue
+            print(f"[WARN] Frame {seq} failed CRC, skipped")
+        pos = data.find(b"Y26F", pos + 1)
+    return captures
+
+def decode_capture(tensors, k=32, conf_thresh=0.10):
+    """
+    Reference decode of the raw one2one outputs (same math and defaults as Yolo26Processor::postprocess).
+    Returns detections in model input coordinates, like parse_log_string().
+    """
+    candidates = []
+    for layer, stride in (("p3", 8), ("p4", 16), ("p5", 32)):
+        box, box_exp = tensors[f"one2one_{layer}_box"]
+        cls, cls_exp = tensors[f"one2one_{layer}_cls"]
+        logits = cls[0].astype(np.float32) * 2.0 ** cls_exp
+        dist = box[0].astype(np.float32) * 2.0 ** box_exp
+        best = logits.argmax(axis=-1)
+        scores = 1.0 / (1.0 + np.exp(-logits.max(axis=-1)))
+        for h, w in zip(*np.nonzero(scores >= conf_thresh)):
+            l, t, r, b = dist[h, w]
+            cx, cy = w + 0.5, h + 0.5
+            candidates.append({
+                "class": COCO_CLASSES[best[h, w]] if best[h, w] < len(COCO_CLASSES) else str(best[h, w]),
+                "score": round(float(scores[h, w]) * 100.0, 2),
+                "box": [(cx - l) * stride, (cy - t) * stride, (cx + r) * stride, (cy + b) * stride],
+            })
+    candidates.sort(key=lambda d: -d["score"])
+    return candidates[:k]
+
+def capture_image(tensors):
+    """
+    Rebuilds the model input image from a dumped "images" tensor (CONFIG_YOLO_DUMP_INPUT),
+    undoing the round(pixel / 255 * 128) quantization. None if the input was not dumped.
+    """
+    if "images" not in tensors:
+        return None
+    raw, exponent = tensors["images"]
+    pixels = raw[0].astype(np.float32) * 2.0 ** exponent * 255.0
+    return Image.fromarray(np.clip(np.rint(pixels), 0, 255).astype(np.uint8))
+
+def visualize_capture(path):
+    captures = load_capture(path)
+    print(f"Loaded {len(captures)} frames from {path}")
+    for seq, time_ms, tensors in captures:
+        detections = decode_capture(tensors)
+        grid_h, grid_w = tensors["one2one_p3_cls"][0].shape[1:3]
+        img = capture_image(tensors)
+        if img is None:
+            img = Image.new("RGB", (grid_w * 8, grid_h * 8), (114, 114, 114))
+        name = f"frame {seq} @ {time_ms} ms"
+        for i, det in enumerate(detections):
+            print(f"{name} Det {i + 1}: {det['class']} ({det['score']:.2f}%) | Box: {det['box']}")
+        draw_detections(img, detections, 1.0, 1.0, name)
+
 # ======================================================================================
 # VISUALIZATION LOGIC
 # ======================================================================================
@@ -130,49 +259,57 @@ def visualize_results(results):
         scale_x = orig_width / MODEL_WIDTH
         scale_y = orig_height / MODEL_HEIGHT
         
-        # Create Plot
-        fig, ax = plt.subplots(1, figsize=(12, 12))
-        ax.imshow(img)
-        
-        # Draw Detections
-        for i, det in enumerate(detections):
-            # Rescale Coordinates
-            x1 = det['box'][0] * scale_x
-            y1 = det['box'][1] * scale_y
-            x2 = det['box'][2] * scale_x
-            y2 = det['box'][3] * scale_y
-            
-            box_w = x2 - x1
-            box_h = y2 - y1
-            
-            # Pick Color
-            color = COLORS[i % len(COLORS)]
-            
-            # Create Rectangle Patch
-            rect = patches.Rectangle(
-                (x1, y1), box_w, box_h, 
-                linewidth=2, edgecolor=color, facecolor='none'
-            )
-            ax.add_patch(rect)
-            
-            # Add Label
-            label_text = f"{det['class']} {det['score']}%"
-            plt.text(
-                x1, y1 - 5, label_text, 
-                color='white', fontsize=12, fontweight='bold',
-                bbox=dict(facecolor=color, alpha=0.5, edgecolor=color)
-            )
-            
-        plt.axis('off')
-        plt.title(f"Detections for {img_name}")
-        
-        plt.show()
+        draw_detections(img, detections, scale_x, scale_y, img_name)
+
+def draw_detections(img, detections, scale_x, scale_y, title):
+    # Create Plot
+    fig, ax = plt.subplots(1, figsize=(12, 12))
+    ax.imshow(img)
+
+    # Draw Detections
+    for i, det in enumerate(detections):
+        # Rescale Coordinates
+        x1 = det['box'][0] * scale_x
+        y1 = det['box'][1] * scale_y
+        x2 = det['box'][2] * scale_x
+        y2 = det['box'][3] * scale_y
+
+        box_w = x2 - x1
+        box_h = y2 - y1
+
+        # Pick Color
+        color = COLORS[i % len(COLORS)]
+
+        # Create Rectangle Patch
+        rect = patches.Rectangle(
+            (x1, y1), box_w, box_h,
+            linewidth=2, edgecolor=color, facecolor='none'
+        )
+        ax.add_patch(rect)
+
+        # Add Label
+        label_text = f"{det['class']} {det['score']}%"
+        plt.text(
+            x1, y1 - 5, label_text,
+            color='white', fontsize=12, fontweight='bold',
+            bbox=dict(facecolor=color, alpha=0.5, edgecolor=color)
+        )
+
+    plt.axis('off')
+    plt.title(f"Detections for {title}")
+
+    plt.show()
 
 # ======================================================================================
 # MAIN
 # ======================================================================================
 
 if __name__ == "__main__":
+    # python visualize_esp32_output.py <capture.y26f | recording.y26t>
+    if len(sys.argv) > 1:
+        visualize_capture(sys.argv[1])
+        sys.exit(0)
+
     print(f"Parsing Raw Log Data...")
     parsed_data = parse_log_string(RAW_LOG_DATA)
     
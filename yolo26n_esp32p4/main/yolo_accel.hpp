@@ -0,0 +1,380 @@
+#pragma once
+#include "dl_image_define.hpp"
+#include "esp_heap_caps.h"
+#include "yolo_transform.hpp"
+#include <cstdio>
+#include <cstring>
+
+#if CONFIG_IDF_TARGET_ESP32P4 && CONFIG_YOLO_HW_ACCEL
+#define YOLO_HAS_HW_ACCEL 1
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "driver/ppa.h"
+#include "driver/jpeg_decode.h"
+#include "esp_cache.h"
+#include "esp_attr.h"
+#else
+#define YOLO_HAS_HW_ACCEL 0
+#endif
+
+// ESP32-P4 image hardware for the frame path: the PPA scale-rotate-mirror engine for
+// resize() and the JPEG codec for decode_jpeg(). Both move pixels by 2D-DMA, so the calling
+// task sleeps on a completion semaphore instead of spending CPU time per pixel.
+//
+// The PPA scales by multiples of 1/16, so the hardware resize uses the largest representable
+// scale per axis and pads the rest of the model input (yolo26_make_ppa_transform()); the
+// returned Yolo26Transform maps boxes back exactly. On other targets, with the option off, or
+// when an engine cannot be opened, init() leaves that engine disabled and Yolo26Processor
+// keeps using the software path.
+
+// Default Accelerator Configuration
+#define YOLO_PPA_SCALE_STEPS 16     // PPA scale factor precision (1/16)
+#define YOLO_HW_JPEG_TIMEOUT_MS 100 // Per-picture decode timeout
+#define YOLO_HW_TIMEOUT_MS 100      // Wait for one PPA transaction
+#define YOLO_HW_WAIT_FOREVER 0xFFFFFFFFu
+
+/**
+ * @brief Called from the PPA interrupt when a start_resize() transaction completes.
+ * Must be ISR-safe (FromISR FreeRTOS calls only).
+ */
+typedef void (*Yolo26AccelDoneFn)(void* ctx);
+
+/**
+ * @brief Like yolo26_make_transform(), but with scales the PPA can represent exactly
+ * (k / YOLO_PPA_SCALE_STEPS), rounded down so the scaled frame fits the model input.
+ * @return The transform, or roi_w == 0 if the frame needs a scale below 1/16 on some axis
+ */
+inline Yolo26Transform yolo26_make_ppa_transform(int src_w, int src_h, int model_w, int model_h, Yolo26ResizeMode mode) {
+    Yolo26Transform xf;
+    xf.src_w = src_w;
+    xf.src_h = src_h;
+    if (src_w <= 0 || src_h <= 0) return xf;
+
+    int kx = model_w * YOLO_PPA_SCALE_STEPS / src_w;
+    int ky = model_h * YOLO_PPA_SCALE_STEPS / src_h;
+    if (mode == YOLO_RESIZE_LETTERBOX) kx = ky = std::min(kx, ky);
+    if (kx <= 0 || ky <= 0) return xf;
+
+    xf.roi_w = src_w * kx / YOLO_PPA_SCALE_STEPS;
+    xf.roi_h = src_h * ky / YOLO_PPA_SCALE_STEPS;
+    if (xf.roi_w <= 0 || xf.roi_h <= 0) {
+        xf.roi_w = xf.roi_h = 0;
+        return xf;
+    }
+    xf.roi_x = (model_w - xf.roi_w) / 2;
+    xf.roi_y = (model_h - xf.roi_h) / 2;
+    xf.scale_x = (float)kx / YOLO_PPA_SCALE_STEPS;
+    xf.scale_y = (float)ky / YOLO_PPA_SCALE_STEPS;
+    return xf;
+}
+
+/**
+ * @brief Fills everything outside the roi of a model-sized RGB888 image with YOLO_LETTERBOX_PAD.
+ */
+inline void yolo26_fill_border(dl::image::img_t& dst, const Yolo26Transform& xf) {
+    uint8_t* px = (uint8_t*)dst.data;
+    size_t stride = (size_t)dst.width * 3;
+    int bottom = xf.roi_y + xf.roi_h;
+    memset(px, YOLO_LETTERBOX_PAD, xf.roi_y * stride);
+    if (xf.roi_w < dst.width) {
+        size_t right = (size_t)(dst.width - xf.roi_x - xf.roi_w) * 3;
+        for (int y = xf.roi_y; y < bottom; y++) {
+            uint8_t* row = px + y * stride;
+            memset(row, YOLO_LETTERBOX_PAD, xf.roi_x * 3);
+            memset(row + (xf.roi_x + xf.roi_w) * 3, YOLO_LETTERBOX_PAD, right);
+        }
+    }
+    memset(px + bottom * stride, YOLO_LETTERBOX_PAD, (dst.height - bottom) * stride);
+}
+
+struct Yolo26AccelConfig {
+    bool use_ppa = true;
+    bool use_jpeg = true;
+    int jpeg_timeout_ms = YOLO_HW_JPEG_TIMEOUT_MS;
+};
+
+/**
+ * @brief Owns the PPA client and the hardware JPEG decoder engine.
+ *
+ * One transaction at a time, from the task that owns the processor. Attach with
+ * Yolo26Processor::set_accel(); the accelerator must outlive that use.
+ */
+class Yolo26Accel {
+private:
+    bool ppa_ready = false;
+    bool jpeg_ready = false;
+
+#if YOLO_HAS_HW_ACCEL
+    Yolo26AccelConfig config;
+    ppa_client_handle_t ppa_client = nullptr;
+    jpeg_decoder_handle_t jpeg_engine = nullptr;
+    SemaphoreHandle_t done_sem = nullptr;
+    Yolo26AccelDoneFn done_fn = nullptr;
+    void* done_ctx = nullptr;
+    size_t cache_align = 128;
+    bool in_flight = false;
+
+    // JPEG input staging: the decoder DMA cannot read flash-mapped rodata. Kept across frames.
+    uint8_t* jpeg_in = nullptr;
+    size_t jpeg_in_cap = 0;
+
+    static bool IRAM_ATTR on_trans_done(ppa_client_handle_t client, ppa_event_data_t* event, void* user_data) {
+        auto* self = static_cast<Yolo26Accel*>(user_data);
+        BaseType_t woken = pdFALSE;
+        if (self->done_fn) self->done_fn(self->done_ctx);
+        xSemaphoreGiveFromISR(self->done_sem, &woken);
+        return woken == pdTRUE;
+    }
+
+    bool open_ppa() {
+        done_sem = xSemaphoreCreateBinary();
+        if (!done_sem) return false;
+        ppa_client_config_t client_cfg = {};
+        client_cfg.oper_type = PPA_OPERATION_SRM;
+        client_cfg.max_pending_trans_num = 1;
+        if (ppa_register_client(&client_cfg, &ppa_client) != ESP_OK) {
+            printf("[Yolo26Accel] Error: PPA client registration failed, using software resize\n");
+            ppa_client = nullptr;
+            return false;
+        }
+        ppa_event_callbacks_t cbs = {};
+        cbs.on_trans_done = on_trans_done;
+        if (ppa_client_register_event_callbacks(ppa_client, &cbs) != ESP_OK) return false;
+        if (esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &cache_align) != ESP_OK || cache_align == 0) cache_align = 128;
+        return true;
+    }
+
+    bool open_jpeg() {
+        jpeg_decode_engine_cfg_t engine_cfg = {};
+        engine_cfg.intr_priority = 0;
+        engine_cfg.timeout_ms = config.jpeg_timeout_ms;
+        if (jpeg_new_decoder_engine(&engine_cfg, &jpeg_engine) != ESP_OK) {
+            printf("[Yolo26Accel] Error: JPEG decoder engine unavailable, using software decode\n");
+            jpeg_engine = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    bool stage_jpeg(const uint8_t* jpg, size_t len) {
+        if (len > jpeg_in_cap) {
+            if (jpeg_in) heap_caps_free(jpeg_in);
+            jpeg_decode_memory_alloc_cfg_t mem_cfg = {};
+            mem_cfg.buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER;
+            size_t got = 0;
+            jpeg_in = (uint8_t*)jpeg_alloc_decoder_mem(len, &mem_cfg, &got);
+            jpeg_in_cap = jpeg_in ? got : 0;
+            if (!jpeg_in) return false;
+        }
+        memcpy(jpeg_in, jpg, len);
+        return true;
+    }
+#endif
+
+public:
+    Yolo26Accel() = default;
+
+    ~Yolo26Accel() { deinit(); }
+
+    Yolo26Accel(const Yolo26Accel&) = delete;
+    Yolo26Accel& operator=(const Yolo26Accel&) = delete;
+
+    /**
+     * @brief Opens the engines enabled in `cfg`. An engine that fails stays disabled.
+     * @return true if at least one engine is available
+     */
+    bool init(const Yolo26AccelConfig& cfg = Yolo26AccelConfig()) {
+        deinit();
+#if YOLO_HAS_HW_ACCEL
+        config = cfg;
+        ppa_ready = cfg.use_ppa && open_ppa();
+        if (cfg.use_ppa && !ppa_ready) {
+            if (ppa_client) ppa_unregister_client(ppa_client);
+            ppa_client = nullptr;
+        }
+        jpeg_ready = cfg.use_jpeg && open_jpeg();
+#else
+        (void)cfg;
+#endif
+        return ppa_ready || jpeg_ready;
+    }
+
+    void deinit() {
+#if YOLO_HAS_HW_ACCEL
+        if (in_flight) wait_resize(YOLO_HW_WAIT_FOREVER);
+        if (ppa_client) ppa_unregister_client(ppa_client);
+        if (jpeg_engine) jpeg_del_decoder_engine(jpeg_engine);
+        if (done_sem) vSemaphoreDelete(done_sem);
+        if (jpeg_in) heap_caps_free(jpeg_in);
+        ppa_client = nullptr;
+        jpeg_engine = nullptr;
+        done_sem = nullptr;
+        jpeg_in = nullptr;
+        jpeg_in_cap = 0;
+#endif
+        ppa_ready = false;
+        jpeg_ready = false;
+    }
+
+    bool has_ppa() const { return ppa_ready; }
+
+    bool has_jpeg() const { return jpeg_ready; }
+
+    /**
+     * @brief Output buffer alignment (and size granularity) the PPA needs; 0 without a PPA.
+     */
+    size_t get_alignment() const {
+#if YOLO_HAS_HW_ACCEL
+        return ppa_ready ? cache_align : 0;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief ISR callback run when each start_resize() transaction completes (nullptr = none).
+     */
+    void set_done_callback(Yolo26AccelDoneFn fn, void* ctx) {
+#if YOLO_HAS_HW_ACCEL
+        done_fn = fn;
+        done_ctx = ctx;
+#else
+        (void)fn;
+        (void)ctx;
+#endif
+    }
+
+    /**
+     * @brief Decodes a baseline JPEG to RGB888 on the JPEG codec.
+     * @return The image (free data with heap_caps_free()), or data == nullptr if the engine is
+     * unavailable or the stream is unsupported (e.g. progressive or greyscale): decode in software
+     */
+    dl::image::img_t decode_jpeg(const uint8_t* jpg, size_t len) {
+        dl::image::img_t img = {};
+#if YOLO_HAS_HW_ACCEL
+        if (!jpeg_ready) return img;
+        jpeg_decode_picture_info_t info = {};
+        if (jpeg_decoder_get_info(jpg, (uint32_t)len, &info) != ESP_OK || info.width == 0 || info.height == 0) return img;
+
+        // The codec writes whole MCUs: rows are padded to the MCU width, the height to its height.
+        int mcu_w = 8, mcu_h = 8;
+        switch (info.sample_method) {
+        case JPEG_DOWN_SAMPLING_YUV444: break;
+        case JPEG_DOWN_SAMPLING_YUV422: mcu_w = 16; break;
+        case JPEG_DOWN_SAMPLING_YUV420: mcu_w = 16; mcu_h = 16; break;
+        default: return img;
+        }
+        int pitch_w = (info.width + mcu_w - 1) / mcu_w * mcu_w;
+        int pad_h = (info.height + mcu_h - 1) / mcu_h * mcu_h;
+        if (!stage_jpeg(jpg, len)) return img;
+
+        jpeg_decode_memory_alloc_cfg_t mem_cfg = {};
+        mem_cfg.buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER;
+        size_t out_cap = 0;
+        uint8_t* out = (uint8_t*)jpeg_alloc_decoder_mem((size_t)pitch_w * pad_h * 3, &mem_cfg, &out_cap);
+        if (!out) return img;
+
+        jpeg_decode_cfg_t dec_cfg = {};
+        dec_cfg.output_format = JPEG_DECODE_OUT_FORMAT_RGB888;
+        dec_cfg.rgb_order = JPEG_DEC_RGB_ELEMENT_ORDER_RGB;
+        dec_cfg.conv_std = JPEG_YUV_RGB_CONV_STD_BT601;
+        uint32_t out_size = 0;
+        if (jpeg_decoder_process(jpeg_engine, &dec_cfg, jpeg_in, (uint32_t)len, out, (uint32_t)out_cap, &out_size) != ESP_OK) {
+            heap_caps_free(out);
+            return img;
+        }
+
+        // Drop the MCU padding in place so the image is tightly packed like the software decode.
+        if (pitch_w != (int)info.width) {
+            size_t row = (size_t)info.width * 3;
+            size_t pitch = (size_t)pitch_w * 3;
+            for (uint32_t y = 1; y < info.height; y++) memmove(out + y * row, out + y * pitch, row);
+        }
+        img.data = out;
+        img.width = info.width;
+        img.height = info.height;
+        img.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
+#else
+        (void)jpg;
+        (void)len;
+#endif
+        return img;
+    }
+
+    /**
+     * @brief Starts scaling RGB888 `src` into the roi of the model-sized RGB888 `dst` and returns
+     * without waiting. The border is padded first; `xf` must come from yolo26_make_ppa_transform().
+     * `dst.data` must be get_alignment()-aligned and `dst_capacity` at least the image size.
+     * Neither buffer may be touched until wait_resize() returns.
+     * @return false if the PPA is unavailable or busy, or the buffers or scale are unsupported
+     */
+    bool start_resize(const dl::image::img_t& src, dl::image::img_t& dst, size_t dst_capacity, const Yolo26Transform& xf) {
+#if YOLO_HAS_HW_ACCEL
+        if (!ppa_ready || in_flight || xf.roi_w <= 0 || xf.roi_h <= 0) return false;
+        if (src.pix_type != dl::image::DL_IMAGE_PIX_TYPE_RGB888 || dst.pix_type != dl::image::DL_IMAGE_PIX_TYPE_RGB888) return false;
+        size_t out_bytes = (size_t)dst.width * dst.height * 3;
+        size_t out_size = dst_capacity / cache_align * cache_align;
+        if ((uintptr_t)dst.data % cache_align != 0 || out_size < out_bytes) return false;
+
+        yolo26_fill_border(dst, xf); // Written back by the driver before the DMA starts
+
+        ppa_srm_oper_config_t op = {};
+        op.in.buffer = src.data;
+        op.in.pic_w = src.width;
+        op.in.pic_h = src.height;
+        op.in.block_w = src.width;
+        op.in.block_h = src.height;
+        op.in.srm_cm = PPA_SRM_COLOR_MODE_RGB888;
+        op.out.buffer = dst.data;
+        op.out.buffer_size = out_size;
+        op.out.pic_w = dst.width;
+        op.out.pic_h = dst.height;
+        op.out.block_offset_x = xf.roi_x;
+        op.out.block_offset_y = xf.roi_y;
+        op.out.srm_cm = PPA_SRM_COLOR_MODE_RGB888;
+        op.rotation_angle = PPA_SRM_ROTATION_ANGLE_0;
+        op.scale_x = xf.scale_x;
+        op.scale_y = xf.scale_y;
+        op.mode = PPA_TRANS_MODE_NON_BLOCKING;
+        op.user_data = this;
+        xSemaphoreTake(done_sem, 0); // Drop a completion left over from a timed-out wait
+        if (ppa_do_scale_rotate_mirror(ppa_client, &op) != ESP_OK) return false;
+        in_flight = true;
+        return true;
+#else
+        (void)src;
+        (void)dst;
+        (void)dst_capacity;
+        (void)xf;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Blocks until the transaction from start_resize() completes.
+     * @return false on timeout (the transaction stays in flight) or if none was started
+     */
+    bool wait_resize(uint32_t timeout_ms = YOLO_HW_TIMEOUT_MS) {
+#if YOLO_HAS_HW_ACCEL
+        if (!in_flight) return false;
+        TickType_t ticks = timeout_ms == YOLO_HW_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+        if (xSemaphoreTake(done_sem, ticks) != pdTRUE) {
+            printf("[Yolo26Accel] Error: PPA transaction timed out\n");
+            return false;
+        }
+        in_flight = false;
+        return true;
+#else
+        (void)timeout_ms;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief start_resize() + wait_resize() without a timeout: a started transaction always
+     * completes, so on false nothing was started and `dst` is free for the software path.
+     */
+    bool resize(const dl::image::img_t& src, dl::image::img_t& dst, size_t dst_capacity, const Yolo26Transform& xf) {
+        return start_resize(src, dst, dst_capacity, xf) && wait_resize(YOLO_HW_WAIT_FOREVER);
+    }
+};
@@ -0,0 +1,221 @@
+#pragma once
+#include "esp_heap_caps.h"
+#include "dl_image_define.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+// Default Arena Configuration
+#define YOLO_ARENA_MAX_FRAMES 8          // Upper bound on frame slots (busy mask is 32-bit)
+#define YOLO_ARENA_ALIGN 16              // Bump allocation alignment (vector loads, JPEG outbuf)
+#define YOLO_ARENA_FRAME_ALIGN 128       // PSRAM frame alignment (L2 cache line)
+#define YOLO_ARENA_INTERNAL_BYTES (128 * 1024)
+
+struct Yolo26ArenaConfig {
+    int max_frame_width = 1920;    // Largest decoded frame the arena must hold
+    int max_frame_height = 1080;
+    int frame_slots = 2;           // RGB888 frame buffers in PSRAM
+    size_t internal_bytes = YOLO_ARENA_INTERNAL_BYTES; // Detections, top-K heap, decode strip
+};
+
+class Yolo26Arena;
+
+/**
+ * @brief RAII handle on one arena frame slot. Move-only; the slot is returned on destruction.
+ */
+class Yolo26Frame {
+private:
+    friend class Yolo26Arena;
+    Yolo26Arena* arena = nullptr;
+    int slot = -1;
+    size_t bytes = 0;
+
+public:
+    dl::image::img_t img = {};
+
+    Yolo26Frame() = default;
+    Yolo26Frame(const Yolo26Frame&) = delete;
+    Yolo26Frame& operator=(const Yolo26Frame&) = delete;
+    Yolo26Frame(Yolo26Frame&& o) noexcept { *this = std::move(o); }
+    Yolo26Frame& operator=(Yolo26Frame&& o) noexcept;
+    ~Yolo26Frame() { release(); }
+
+    bool valid() const { return slot >= 0; }
+    size_t capacity() const { return bytes; }
+    inline void release();
+};
+
+/**
+ * @brief Memory set up once at init and reused for every frame.
+ *
+ * Two regions are allocated up front: an internal SRAM block carved by bump allocation
+ * (detections, top-K storage, decode strips) and a PSRAM block split into equal
+ * cache-line aligned RGB888 frame slots handed out as Yolo26Frame handles.
+ * Carving is a setup-time operation; nothing is ever returned to the heap until destruction.
+ */
+class Yolo26Arena {
+private:
+    uint8_t* internal_base = nullptr;
+    size_t internal_size = 0;
+    size_t internal_used = 0;
+
+    uint8_t* frame_base = nullptr;
+    size_t frame_bytes = 0;
+    int frame_slots = 0;
+    std::atomic<uint32_t> frame_busy{0};
+
+    int max_w = 0;
+    int max_h = 0;
+
+public:
+    Yolo26Arena() = default;
+    Yolo26Arena(const Yolo26Arena&) = delete;
+    Yolo26Arena& operator=(const Yolo26Arena&) = delete;
+
+    ~Yolo26Arena() {
+        heap_caps_free(internal_base);
+        heap_caps_free(frame_base);
+    }
+
+    /**
+     * @brief Allocates both regions. Must be called once before use.
+     * @return false if either allocation failed
+     */
+    bool init(const Yolo26ArenaConfig& config) {
+        if (internal_base || frame_base) return false;
+        if (config.frame_slots < 0 || config.frame_slots > YOLO_ARENA_MAX_FRAMES) return false;
+
+        max_w = config.max_frame_width;
+        max_h = config.max_frame_height;
+        internal_size = config.internal_bytes;
+        internal_base = (uint8_t*)heap_caps_aligned_alloc(YOLO_ARENA_ALIGN, internal_size,
+                                                          MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!internal_base) {
+            printf("[Yolo26Arena] Error: Failed to allocate %u bytes of internal SRAM\n", (unsigned)internal_size);
+            return false;
+        }
+
+        frame_slots = config.frame_slots;
+        size_t raw = (size_t)max_w * max_h * 3;
+        frame_bytes = (raw + YOLO_ARENA_FRAME_ALIGN - 1) / YOLO_ARENA_FRAME_ALIGN * YOLO_ARENA_FRAME_ALIGN;
+        if (frame_slots > 0) {
+            frame_base = (uint8_t*)heap_caps_aligned_alloc(YOLO_ARENA_FRAME_ALIGN, frame_bytes * frame_slots,
+                                                           MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!frame_base) {
+                printf("[Yolo26Arena] Error: Failed to allocate %d x %u byte frame slots in PSRAM\n",
+                       frame_slots, (unsigned)frame_bytes);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Carves `bytes` from the internal SRAM region (setup only, never freed individually).
+     * @return nullptr if the region is exhausted
+     */
+    void* alloc_internal(size_t bytes, size_t align = YOLO_ARENA_ALIGN) {
+        size_t offset = (internal_used + align - 1) / align * align;
+        if (!internal_base || offset + bytes > internal_size) {
+            printf("[Yolo26Arena] Error: Internal region exhausted (%u + %u > %u)\n",
+                   (unsigned)offset, (unsigned)bytes, (unsigned)internal_size);
+            return nullptr;
+        }
+        internal_used = offset + bytes;
+        return internal_base + offset;
+    }
+
+    /**
+     * @brief Takes a free frame slot.
+     * @return Handle whose valid() is false when every slot is in use
+     */
+    Yolo26Frame acquire_frame() {
+        Yolo26Frame frame;
+        uint32_t busy = frame_busy.load();
+        for (int i = 0; i < frame_slots; i++) {
+            uint32_t bit = 1u << i;
+            while (!(busy & bit)) {
+                if (frame_busy.compare_exchange_weak(busy, busy | bit)) {
+                    frame.arena = this;
+                    frame.slot = i;
+                    frame.bytes = frame_bytes;
+                    frame.img.data = frame_base + frame_bytes * i;
+                    frame.img.width = 0;
+                    frame.img.height = 0;
+                    frame.img.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
+                    return frame;
+                }
+            }
+        }
+        return frame;
+    }
+
+    void release_slot(int slot) {
+        frame_busy.fetch_and(~(1u << slot));
+    }
+
+    int get_max_frame_width() const { return max_w; }
+    int get_max_frame_height() const { return max_h; }
+    size_t get_internal_used() const { return internal_used; }
+    size_t get_internal_size() const { return internal_size; }
+    size_t get_frame_bytes() const { return frame_bytes; }
+    int get_frame_slots() const { return frame_slots; }
+};
+
+inline Yolo26Frame& Yolo26Frame::operator=(Yolo26Frame&& o) noexcept {
+    if (this != &o) {
+        release();
+        arena = o.arena;
+        slot = o.slot;
+        bytes = o.bytes;
+        img = o.img;
+        o.arena = nullptr;
+        o.slot = -1;
+        o.img = {};
+    }
+    return *this;
+}
+
+inline void Yolo26Frame::release() {
+    if (arena && slot >= 0) {
+        arena->release_slot(slot);
+    }
+    arena = nullptr;
+    slot = -1;
+    img = {};
+}
+
+/**
+ * @brief Heap usage snapshot used to verify that a steady-state loop does not allocate.
+ * Compares allocated block counts and free bytes per capability; any growth is reported.
+ */
+struct Yolo26HeapWatermark {
+    size_t internal_free;
+    size_t internal_blocks;
+    size_t psram_free;
+    size_t psram_blocks;
+
+    static Yolo26HeapWatermark capture() {
+        multi_heap_info_t internal = {};
+        multi_heap_info_t psram = {};
+        heap_caps_get_info(&internal, MALLOC_CAP_INTERNAL);
+        heap_caps_get_info(&psram, MALLOC_CAP_SPIRAM);
+        return {internal.total_free_bytes, internal.allocated_blocks,
+                psram.total_free_bytes, psram.allocated_blocks};
+    }
+
+    /**
+     * @brief Prints the difference to `after` and returns true if nothing was left allocated.
+     */
+    bool check(const Yolo26HeapWatermark& after, const char* label) const {
+        long d_int = (long)internal_free - (long)after.internal_free;
+        long d_ps = (long)psram_free - (long)after.psram_free;
+        long b_int = (long)after.internal_blocks - (long)internal_blocks;
+        long b_ps = (long)after.psram_blocks - (long)psram_blocks;
+        bool ok = d_int <= 0 && d_ps <= 0 && b_int <= 0 && b_ps <= 0;
+        printf("Heap check (%s): %s | internal %+ld B %+ld blocks | psram %+ld B %+ld blocks\n",
+               label, ok ? "PASS" : "FAIL", d_int, b_int, d_ps, b_ps);
+        return ok;
+    }
+};
@@ -0,0 +1,228 @@
+#pragma once
+#include "esp_timer.h"
+#include "dl_model_base.hpp"
+#include "yolo_processor.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+// Several camera streams served by one model and one processor.
+//
+// Each stream has its own configuration (confidence, detection count, resize mode) and a
+// single pending-frame slot: a newer frame replaces one that has not been served yet, so a
+// slow batch never builds a backlog of stale frames. run() serves the streams with a pending
+// frame round-robin, starting after the last stream served, so under a frame budget every
+// stream gets its turn. Per-call setup is done once per batch instead of once per frame:
+// the processor's decode plan check and each stream's integer thresholds.
+// The model still runs one frame at a time (esp-dl models have batch size 1).
+
+// Default Batch Configuration
+#define YOLO_BATCH_MAX_STREAMS 4
+
+struct Yolo26StreamConfig {
+    float conf_thresh = YOLO_CONF_THRESH;
+    int max_detections = YOLO_TARGET_K; // Clipped to the processor's K
+    Yolo26ResizeMode resize_mode = YOLO_RESIZE_STRETCH;
+};
+
+/**
+ * @brief A frame offered to a stream: a JPEG (fused decode), a decoded RGB888 image or a
+ * native camera frame, whichever is set first in that order.
+ * `user_handle` is passed back untouched to the release callback (e.g. a camera frame buffer).
+ */
+struct Yolo26StreamFrame {
+    const uint8_t* jpg_data = nullptr;
+    size_t jpg_len = 0;
+    dl::image::img_t img = {};
+    Yolo26CameraFrame camera;
+    int64_t capture_us = 0;
+    void* user_handle = nullptr;
+};
+
+struct Yolo26StreamStats {
+    uint32_t frames;   // Served
+    uint32_t replaced; // Superseded by a newer frame before being served
+    uint32_t failed;   // Preprocess or inference failed
+    uint32_t last_us;  // Preprocess + inference + postprocess of the last served frame
+    uint64_t total_us;
+};
+
+/**
+ * @brief Detections of one served frame. `detections` is only valid during the callback.
+ */
+struct Yolo26StreamResult {
+    int stream;
+    const Yolo26StreamFrame* frame;
+    const Detection* detections; // Source frame pixels
+    int count;
+};
+
+typedef void (*Yolo26StreamReleaseFn)(int stream, const Yolo26StreamFrame& frame, void* user_ctx);
+typedef void (*Yolo26StreamResultFn)(const Yolo26StreamResult& result, void* user_ctx);
+
+struct Yolo26BatchConfig {
+    Yolo26StreamResultFn publish = nullptr;  // Called from run() for every served frame
+    Yolo26StreamReleaseFn release = nullptr; // Called once a frame has been served, replaced or dropped
+    void* user_ctx = nullptr;
+};
+
+/**
+ * @brief Fair multi-stream scheduler over one dl::Model and one processor.
+ * submit() may be called from any task; run() from one task only. The processor must not be
+ * used elsewhere while run() executes.
+ */
+template <typename Processor>
+class Yolo26StreamBatch {
+private:
+    struct Stream {
+        Yolo26StreamConfig config;
+        Yolo26StreamStats stats;
+        Yolo26StreamFrame pending;
+        bool has_pending;
+        std::vector<Detection> results; // Sized to max_detections once
+    };
+
+    dl::Model* model;
+    Processor& processor;
+    Yolo26BatchConfig config;
+    Stream streams[YOLO_BATCH_MAX_STREAMS];
+    int count = 0;
+    int next = 0; // First stream offered a turn by the next run()
+    std::mutex mutex;
+
+    void release(int s, const Yolo26StreamFrame& frame) {
+        if (config.release) config.release(s, frame, config.user_ctx);
+    }
+
+    // Preprocess + inference of one frame. Returns the frame mapping through `xf`.
+    bool infer(const Yolo26StreamFrame& frame, Yolo26Transform& xf) {
+        const auto& inputs = model->get_inputs();
+        if (frame.jpg_data) {
+            if (!processor.decode_preprocess_jpeg(frame.jpg_data, frame.jpg_len, inputs, &xf)) return false;
+        } else if (frame.img.data) {
+            dl::image::img_t src = frame.img;
+            dl::image::img_t resized = processor.resize(src, inputs, &xf);
+            if (!resized.data) return false;
+            processor.preprocess(resized, inputs);
+            if (resized.data != frame.img.data) heap_caps_free(resized.data);
+        } else if (frame.camera.data) {
+            if (!processor.preprocess(frame.camera, inputs, &xf)) return false;
+        } else {
+            return false;
+        }
+        model->run();
+        return true;
+    }
+
+public:
+    Yolo26StreamBatch(dl::Model* m, Processor& p, const Yolo26BatchConfig& cfg = Yolo26BatchConfig())
+        : model(m), processor(p), config(cfg) {}
+
+    ~Yolo26StreamBatch() {
+        for (int s = 0; s < count; s++) {
+            if (streams[s].has_pending) release(s, streams[s].pending);
+        }
+    }
+
+    Yolo26StreamBatch(const Yolo26StreamBatch&) = delete;
+    Yolo26StreamBatch& operator=(const Yolo26StreamBatch&) = delete;
+
+    /**
+     * @brief Adds a stream (setup only, before the first submit()).
+     * @return Stream index, -1 if YOLO_BATCH_MAX_STREAMS are in use
+     */
+    int add_stream(const Yolo26StreamConfig& cfg = Yolo26StreamConfig()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == YOLO_BATCH_MAX_STREAMS) {
+            printf("[Yolo26StreamBatch] Error: More than %d streams\n", YOLO_BATCH_MAX_STREAMS);
+            return -1;
+        }
+        Stream& st = streams[count];
+        st.config = cfg;
+        st.stats = {};
+        st.has_pending = false;
+        st.results.resize(std::clamp(cfg.max_detections, 0, processor.get_target_k()));
+        return count++;
+    }
+
+    /**
+     * @brief Makes `frame` the pending frame of stream `s`, replacing (and releasing) one that
+     * has not been served yet. The frame memory must stay valid until it is released.
+     */
+    bool submit(int s, const Yolo26StreamFrame& frame) {
+        Yolo26StreamFrame old;
+        bool had = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (s < 0 || s >= count) return false;
+            Stream& st = streams[s];
+            had = st.has_pending;
+            if (had) {
+                old = st.pending;
+                st.stats.replaced++;
+            }
+            st.pending = frame;
+            st.has_pending = true;
+        }
+        if (had) release(s, old);
+        return true;
+    }
+
+    /**
+     * @brief Serves up to `max_frames` pending frames (0 = all), one per stream, round-robin.
+     * The processor's resize mode is switched per stream and restored before returning.
+     * @return Number of frames served
+     */
+    int run(int max_frames = 0) {
+        int served = 0;
+        bool bound = false;
+        Yolo26LayerThresholds th[YOLO_BATCH_MAX_STREAMS];
+        int n = count;
+        int start = next;
+        Yolo26ResizeMode caller_mode = processor.get_resize_mode();
+        for (int i = 0; i < n && (max_frames <= 0 || served < max_frames); i++) {
+            int s = (start + i) % n;
+            Stream& st = streams[s];
+            Yolo26StreamFrame frame;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!st.has_pending) continue;
+                frame = st.pending;
+                st.has_pending = false;
+            }
+
+            int64_t t0 = esp_timer_get_time();
+            processor.set_resize_mode(st.config.resize_mode);
+            Yolo26Transform xf;
+            bool ok = infer(frame, xf);
+            if (ok && !bound) {
+                // The output layout is known once the first frame of the batch has run
+                ok = bound = processor.begin_batch(model->get_outputs());
+                for (int j = 0; bound && j < n; j++) th[j] = processor.batch_thresholds(streams[j].config.conf_thresh);
+            }
+            int found = ok ? processor.postprocess_batch_into(th[s], st.results.data(), (int)st.results.size(), &xf) : 0;
+            uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+
+            if (ok) {
+                st.stats.frames++;
+                st.stats.last_us = us;
+                st.stats.total_us += us;
+                if (config.publish) config.publish({s, &frame, st.results.data(), found}, config.user_ctx);
+            } else {
+                st.stats.failed++;
+            }
+            release(s, frame);
+            next = (s + 1) % n;
+            served++;
+        }
+        if (bound) processor.end_batch();
+        processor.set_resize_mode(caller_mode);
+        return served;
+    }
+
+    int get_stream_count() const { return count; }
+
+    Yolo26StreamStats get_stats(int s) const {
+        return (s >= 0 && s < count) ? streams[s].stats : Yolo26StreamStats{};
+    }
+};
@@ -0,0 +1,217 @@
+#pragma once
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_app_desc.h"
+#include "dl_model_base.hpp"
+#include "yolo_processor.hpp"
+#include "yolo_profiler.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+// Default Benchmark Configuration
+#define YOLO_BENCH_WARMUP 2
+#define YOLO_BENCH_ITERATIONS 10
+#define YOLO_BENCH_SEED 0x2C1B3C6Du  // Fixed: synthetic workloads are identical on every run
+
+struct Yolo26BenchConfig {
+    int warmup = YOLO_BENCH_WARMUP;          // Untimed iterations per workload
+    int iterations = YOLO_BENCH_ITERATIONS;  // Timed iterations per workload
+};
+
+/**
+ * @brief Repeatable on-device benchmark of every Yolo26Processor stage.
+ *
+ * JPEG workloads run decode -> resize -> preprocess -> inference -> postprocess and,
+ * separately, the fused decode_preprocess_jpeg(). Synthetic workloads quantize a fixed noise
+ * frame, run inference, then overwrite the model outputs with a seeded pattern in which
+ * `density` of the cells hold one confident class, so postprocess cost can be compared
+ * from empty scenes up to crowded ones.
+ *
+ * Every workload prints the Yolo26Profiler record (YOLO_PROF ...) plus one summary line:
+ * YOLO_BENCH {"fw":..,"workload":..,"iters":..,"fps":..,"dets":..,"heap":{..},"cache_miss":null}
+ * fps is 1e6 / mean end-to-end latency (classic path). Heap peaks are bytes in use above the
+ * level at workload start, per capability. No cache-miss counter is exposed to applications
+ * on the ESP32-P4, so that field is always null.
+ */
+template <typename Processor>
+class Yolo26BenchmarkT {
+private:
+    dl::Model* model;
+    Processor& processor;
+    Yolo26BenchConfig config;
+    Yolo26Profiler profiler;
+    uint32_t rng = YOLO_BENCH_SEED;
+
+    struct HeapMark {
+        size_t internal_free;
+        size_t psram_free;
+    };
+
+    uint32_t next_random() {
+        // xorshift32
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    HeapMark heap_begin() {
+        heap_caps_monitor_local_minimum_free_size_start();
+        return {heap_caps_get_free_size(MALLOC_CAP_INTERNAL), heap_caps_get_free_size(MALLOC_CAP_SPIRAM)};
+    }
+
+    void report(const char* workload, const HeapMark& start, int dets) {
+        // While monitoring, the minimum free size is the local minimum since heap_begin().
+        size_t internal_min = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+        size_t psram_min = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+        heap_caps_monitor_local_minimum_free_size_stop();
+
+        uint64_t total_us = 0;
+        for (int s : {YOLO_STAGE_DECODE, YOLO_STAGE_RESIZE, YOLO_STAGE_PREPROCESS, YOLO_STAGE_INFERENCE, YOLO_STAGE_POSTPROCESS}) {
+            const Yolo26StageProfile& p = profiler.get((Yolo26Stage)s);
+            if (p.count) total_us += p.total_us / p.count;
+        }
+
+        printf("\n[%s]\n", workload);
+        profiler.print_summary();
+        profiler.print_json(workload);
+        printf("YOLO_BENCH {\"fw\":\"%s\",\"model_input\":%d,\"workload\":\"%s\",\"iters\":%d,\"fps\":%.4f,\"dets\":%d,"
+               "\"heap\":{\"internal_peak\":%u,\"psram_peak\":%u,\"internal_free\":%u,\"psram_free\":%u},\"cache_miss\":null}\n",
+               esp_app_get_description()->version, input_width(), workload, config.iterations,
+               total_us ? 1e6 / total_us : 0.0, dets,
+               (unsigned)(start.internal_free > internal_min ? start.internal_free - internal_min : 0),
+               (unsigned)(start.psram_free > psram_min ? start.psram_free - psram_min : 0),
+               (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL), (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+    }
+
+    int input_width() {
+        auto& inputs = model->get_inputs();
+        return inputs.empty() ? 0 : inputs.begin()->second->shape[2];
+    }
+
+    // Seeded output pattern: background everywhere, `density` of the cells with one confident class.
+    template <typename T>
+    void fill_outputs(float density) {
+        static const char* layers[3] = {"p3", "p4", "p5"};
+        uint32_t hit_below = (uint32_t)(density * 65536.0f);
+        auto& outputs = model->get_outputs();
+        for (const char* l : layers) {
+            dl::TensorBase* box = outputs.at(std::string("one2one_") + l + "_box");
+            dl::TensorBase* cls = outputs.at(std::string("one2one_") + l + "_cls");
+            T* b = (T*)box->data;
+            T* c = (T*)cls->data;
+            int classes = cls->shape[3];
+            int cells = cls->shape[1] * cls->shape[2];
+            // Logit ~ +4 (p ~ 0.98) / -8 (p ~ 0.0003) in the tensor's own scale
+            T fg = (T)std::min((float)std::numeric_limits<T>::max(), std::ldexp(4.0f, -cls->exponent));
+            T bg = (T)std::max((float)std::numeric_limits<T>::min(), std::ldexp(-8.0f, -cls->exponent));
+            for (int i = 0; i < cells; i++) {
+                for (int k = 0; k < classes; k++) c[i * classes + k] = bg;
+                if ((next_random() & 0xFFFF) < hit_below) c[i * classes + next_random() % classes] = fg;
+                for (int k = 0; k < 4; k++) b[i * 4 + k] = (T)(next_random() % 4 + 1);
+            }
+        }
+    }
+
+public:
+    Yolo26BenchmarkT(dl::Model* m, Processor& proc, const Yolo26BenchConfig& cfg = Yolo26BenchConfig())
+        : model(m), processor(proc), config(cfg) {}
+
+    /**
+     * @brief Benchmarks one embedded JPEG through the classic and the fused path.
+     * @return Detections of the last iteration
+     */
+    int run_jpeg(const char* workload, const uint8_t* jpg, size_t len) {
+        profiler.reset();
+        HeapMark heap = heap_begin();
+        auto& inputs = model->get_inputs();
+        int dets = 0;
+        for (int it = 0; it < config.warmup + config.iterations; it++) {
+            if (it == config.warmup) profiler.reset();
+
+            profiler.begin(YOLO_STAGE_DECODE);
+            dl::image::img_t img = processor.decode_jpeg(jpg, len);
+            profiler.end(YOLO_STAGE_DECODE);
+            if (!img.data) {
+                heap_caps_monitor_local_minimum_free_size_stop();
+                return -1;
+            }
+
+            Yolo26Transform xf;
+            profiler.begin(YOLO_STAGE_RESIZE);
+            dl::image::img_t resized = processor.resize(img, inputs, &xf);
+            profiler.end(YOLO_STAGE_RESIZE);
+
+            profiler.begin(YOLO_STAGE_PREPROCESS);
+            processor.preprocess(resized, inputs);
+            profiler.end(YOLO_STAGE_PREPROCESS);
+            if (resized.data != img.data) heap_caps_free(resized.data);
+            heap_caps_free(img.data);
+
+            profiler.begin(YOLO_STAGE_FUSED);
+            processor.decode_preprocess_jpeg(jpg, len, inputs, &xf);
+            profiler.end(YOLO_STAGE_FUSED);
+
+            profiler.begin(YOLO_STAGE_INFERENCE);
+            model->run();
+            profiler.end(YOLO_STAGE_INFERENCE);
+
+            profiler.begin(YOLO_STAGE_POSTPROCESS);
+            dets = (int)processor.postprocess(model->get_outputs(), &xf).size();
+            profiler.end(YOLO_STAGE_POSTPROCESS);
+        }
+        report(workload, heap, dets);
+        return dets;
+    }
+
+    /**
+     * @brief Benchmarks a seeded noise frame with a synthetic detection density (0..1 of cells).
+     * @return Detections of the last iteration
+     */
+    int run_synthetic(const char* workload, float density) {
+        auto& inputs = model->get_inputs();
+        if (inputs.empty()) return -1;
+        dl::TensorBase* input = inputs.begin()->second;
+
+        dl::image::img_t frame;
+        frame.width = input->shape[2];
+        frame.height = input->shape[1];
+        frame.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
+        size_t bytes = (size_t)frame.width * frame.height * 3;
+        frame.data = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+        if (!frame.data) return -1;
+        rng = YOLO_BENCH_SEED;
+        for (size_t i = 0; i < bytes; i++) ((uint8_t*)frame.data)[i] = (uint8_t)next_random();
+
+        profiler.reset();
+        HeapMark heap = heap_begin();
+        bool int8_out = model->get_outputs().at("one2one_p3_cls")->dtype == dl::DATA_TYPE_INT8;
+        int dets = 0;
+        for (int it = 0; it < config.warmup + config.iterations; it++) {
+            if (it == config.warmup) profiler.reset();
+
+            profiler.begin(YOLO_STAGE_PREPROCESS);
+            processor.preprocess(frame, inputs);
+            profiler.end(YOLO_STAGE_PREPROCESS);
+
+            profiler.begin(YOLO_STAGE_INFERENCE);
+            model->run();
+            profiler.end(YOLO_STAGE_INFERENCE);
+
+            rng = YOLO_BENCH_SEED + it; // Same pattern sequence every run
+            if (int8_out) {
+                fill_outputs<int8_t>(density);
+            } else {
+                fill_outputs<int16_t>(density);
+            }
+            profiler.begin(YOLO_STAGE_POSTPROCESS);
+            dets = (int)processor.postprocess(model->get_outputs()).size();
+            profiler.end(YOLO_STAGE_POSTPROCESS);
+        }
+        report(workload, heap, dets);
+        heap_caps_free(frame.data);
+        return dets;
+    }
+};
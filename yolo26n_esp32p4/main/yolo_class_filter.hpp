@@ -0,0 +1,167 @@
+#pragma once
+#include "yolo_scan.hpp"
+#include "yolo_memory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Per-class confidence thresholds and class allow-list for postprocess().
+//
+// Rules are set in probability terms and compiled once per model into integer thresholds per
+// stride layer (one byte lane per class for the int8 SWAR scan), so filtering costs nothing
+// per detection. Disallowed classes get a threshold no value can exceed; with only a few
+// allowed classes the scan reads just those instead of all class logits.
+
+#define YOLO_SCAN_SPARSE_CLASSES 8 // Allowed classes up to which the scan reads them one by one
+#define YOLO_MAX_SCAN_CLASSES 256  // Widest class lane vector of the masked SWAR scan (beyond: one by one)
+
+/**
+ * @brief Class rules of one Yolo26Processor. Setters may be called from any task at any time;
+ * they take effect at the start of the next postprocess().
+ */
+class Yolo26ClassFilter {
+private:
+    // Rules as set: per class id, missing entries fall back to the processor's conf_thresh
+    struct Rules {
+        std::vector<float> thresh;     // < 0: use conf_thresh
+        std::vector<uint8_t> allowed;  // Empty: all classes allowed
+    };
+
+    std::mutex mutex;
+    Rules pending;
+    std::atomic<bool> dirty{false};
+    Rules rules; // Owned by the postprocess() caller
+
+    // Compiled plan for one model (class count, element range, class exponents)
+    bool plan_valid = false;
+    int plan_classes = 0;
+    int plan_exp[3] = {0, 0, 0};
+    int plan_max = 0;
+    float plan_conf = 0.0f;
+    // Read per candidate by the scan: hot memory (yolo_memory.hpp)
+    Yolo26HotVector<float> conf;              // Per class
+    Yolo26HotVector<int> allowed_ids;
+    Yolo26HotVector<int32_t> int_thresh[3];   // Per layer, per class; plan_max = never passes
+    Yolo26HotVector<int8_t> int8_thresh[3];   // Same, padded to YOLO_SCAN_GROUP with 127 (int8 models)
+
+    template <typename F>
+    void update(F&& f) {
+        std::lock_guard<std::mutex> lock(mutex);
+        f(pending);
+        dirty.store(true, std::memory_order_release);
+    }
+
+public:
+    /**
+     * @brief Sets the confidence threshold of classes 0..n-1 (a negative value keeps the global one).
+     * n = 0 clears every per-class threshold.
+     */
+    void set_thresholds(const float* thresh, int n) {
+        update([&](Rules& r) { r.thresh.assign(thresh, thresh + std::max(n, 0)); });
+    }
+
+    void set_threshold(int class_id, float thresh) {
+        if (class_id < 0) return;
+        update([&](Rules& r) {
+            if ((int)r.thresh.size() <= class_id) r.thresh.resize(class_id + 1, -1.0f);
+            r.thresh[class_id] = thresh;
+        });
+    }
+
+    /**
+     * @brief Reports only the classes in `ids`. n = 0 allows every class again.
+     */
+    void set_allowed(const int* ids, int n) {
+        update([&](Rules& r) {
+            r.allowed.clear();
+            for (int i = 0; i < n; i++) {
+                if (ids[i] < 0) continue;
+                if ((int)r.allowed.size() <= ids[i]) r.allowed.resize(ids[i] + 1, 0);
+                r.allowed[ids[i]] = 1;
+            }
+            // Keep "empty = all" distinct from "nothing allowed"
+            if (n > 0 && r.allowed.empty()) r.allowed.push_back(0);
+        });
+    }
+
+    void clear() {
+        update([](Rules& r) {
+            r.thresh.clear();
+            r.allowed.clear();
+        });
+    }
+
+    /**
+     * @brief Applies pending rule changes. Called by postprocess() at the start of each frame.
+     */
+    void sync() {
+        if (!dirty.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        rules.thresh = pending.thresh;
+        rules.allowed = pending.allowed;
+        dirty.store(false, std::memory_order_relaxed);
+        plan_valid = false;
+    }
+
+    /**
+     * @brief True if any rule is set; otherwise postprocess() uses its single-threshold scan.
+     */
+    bool active() const {
+        return !rules.allowed.empty() || !rules.thresh.empty();
+    }
+
+    /**
+     * @brief Compiles the rules for a model with `num_classes` classes, element range
+     * [t_min, t_max] and the class exponents of the three layers. Cheap if nothing changed.
+     */
+    void prepare(int num_classes, int t_min, int t_max, const int cls_exponent[3], float default_conf) {
+        if (plan_valid && plan_classes == num_classes && plan_max == t_max && plan_conf == default_conf &&
+            std::equal(cls_exponent, cls_exponent + 3, plan_exp)) {
+            return;
+        }
+        plan_valid = true;
+        plan_classes = num_classes;
+        plan_max = t_max;
+        plan_conf = default_conf;
+        std::copy(cls_exponent, cls_exponent + 3, plan_exp);
+
+        conf.assign(num_classes, default_conf);
+        allowed_ids.clear();
+        for (int c = 0; c < num_classes; c++) {
+            if (c < (int)rules.thresh.size() && rules.thresh[c] >= 0.0f) conf[c] = rules.thresh[c];
+            if (rules.allowed.empty() || (c < (int)rules.allowed.size() && rules.allowed[c])) allowed_ids.push_back(c);
+        }
+
+        int padded = (num_classes + YOLO_SCAN_GROUP - 1) / YOLO_SCAN_GROUP * YOLO_SCAN_GROUP;
+        for (int l = 0; l < 3; l++) {
+            float scale = std::pow(2.0f, cls_exponent[l]);
+            int_thresh[l].assign(num_classes, t_max);
+            for (int c : allowed_ids) {
+                // raw > floor(logit(conf) / scale)  <=>  sigmoid(raw * scale) > conf
+                float t = std::floor(-std::log(1.0f / conf[c] - 1.0f) / scale);
+                int_thresh[l][c] = t >= (float)t_max ? t_max : (int32_t)std::max((float)t_min, t);
+            }
+            int8_thresh[l].assign(padded, 127);
+            if (t_max == 127) std::copy(int_thresh[l].begin(), int_thresh[l].end(), int8_thresh[l].begin());
+        }
+    }
+
+    // --- Plan accessors (valid after prepare()) ---
+    float get_conf(int class_id) const { return conf[class_id]; }
+    const int* get_allowed_ids() const { return allowed_ids.data(); }
+    int get_allowed_count() const { return (int)allowed_ids.size(); }
+    const int32_t* get_int_thresh(int layer) const { return int_thresh[layer].data(); }
+    const int8_t* get_int8_thresh(int layer) const { return int8_thresh[layer].data(); }
+    bool is_sparse() const { return (int)allowed_ids.size() <= YOLO_SCAN_SPARSE_CLASSES; }
+
+    // Placement report: first layer's thresholds and the size of the whole plan
+    const void* get_plan_storage() const { return int_thresh[0].data(); }
+    size_t get_plan_bytes() const {
+        size_t bytes = conf.capacity() * sizeof(float) + allowed_ids.capacity() * sizeof(int);
+        for (int l = 0; l < 3; l++) bytes += int_thresh[l].capacity() * sizeof(int32_t) + int8_thresh[l].capacity();
+        return bytes;
+    }
+};
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Native camera formats quantized without an RGB888 intermediate.
+//
+// MIPI-CSI sensors deliver RGB565 or packed YUV422. Instead of converting the frame to RGB888
+// and quantizing that, each format gets its own set of tables that map source fields straight to
+// int8 model input values:
+// - RGB565: one table per field (5/6/5 bits), built from the expanded 8-bit channel value.
+// - YUV422: the BT.601 full-range chroma terms per U/V byte, and a clamp-and-quantize table
+//   indexed by Y + term, so there are no branches and no float math per pixel.
+// A frame is read once at 2 bytes per pixel and written once as NHWC int8.
+
+#define YOLO_COLOR_CLAMP_BIAS 384  // Offset of value 0 in Yolo26ColorLut::clamp_q
+#define YOLO_COLOR_CLAMP_SIZE 1024 // Covers Y + chroma term for every Y, U, V
+
+enum Yolo26PixelFormat {
+    YOLO_PIX_RGB565_LE = 0, // 16-bit RGB565, low byte first (esp_video / LCD default)
+    YOLO_PIX_RGB565_BE,     // 16-bit RGB565, high byte first
+    YOLO_PIX_YUYV,          // Packed YUV422: Y0 U Y1 V
+    YOLO_PIX_UYVY,          // Packed YUV422: U Y0 V Y1
+};
+
+/**
+ * @brief A camera frame in a native format, rows tightly packed (2 bytes per pixel).
+ * YUV422 frames must have an even width.
+ */
+struct Yolo26CameraFrame {
+    const void* data = nullptr;
+    int width = 0;
+    int height = 0;
+    Yolo26PixelFormat format = YOLO_PIX_RGB565_LE;
+};
+
+/**
+ * @brief Per-format conversion tables with the input quantization folded in.
+ */
+struct Yolo26ColorLut {
+    int8_t r5[32];   // RGB565 fields -> quantized channel
+    int8_t g6[64];
+    int8_t b5[32];
+    int16_t rv[256]; // BT.601 chroma terms: R = Y + rv[V], G = Y + gu[U] + gv[V], B = Y + bu[U]
+    int16_t gu[256];
+    int16_t gv[256];
+    int16_t bu[256];
+    int8_t clamp_q[YOLO_COLOR_CLAMP_SIZE]; // quant_lut[clamp(i - BIAS, 0, 255)]
+
+    /**
+     * @brief Builds the tables from the processor's uint8 -> int8 quantization LUT.
+     */
+    void init(const int8_t* quant_lut) {
+        for (int v = 0; v < 32; v++) {
+            r5[v] = b5[v] = quant_lut[(v << 3) | (v >> 2)];
+        }
+        for (int v = 0; v < 64; v++) {
+            g6[v] = quant_lut[(v << 2) | (v >> 4)];
+        }
+        for (int c = 0; c < 256; c++) {
+            float d = (float)(c - 128);
+            rv[c] = (int16_t)std::lround(1.402f * d);
+            gu[c] = (int16_t)std::lround(-0.344136f * d);
+            gv[c] = (int16_t)std::lround(-0.714136f * d);
+            bu[c] = (int16_t)std::lround(1.772f * d);
+        }
+        for (int i = 0; i < YOLO_COLOR_CLAMP_SIZE; i++) {
+            clamp_q[i] = quant_lut[std::clamp(i - YOLO_COLOR_CLAMP_BIAS, 0, 255)];
+        }
+    }
+};
+
+/**
+ * @brief Converts and quantizes `n` pixels of one RGB565 row into `dst` (3 bytes per pixel).
+ * Output pixel i reads source pixel x_idx[i].
+ */
+template <bool BigEndian>
+inline void yolo26_convert_rgb565_row(const uint8_t* src_row, const int* x_idx, int n, int8_t* dst, const Yolo26ColorLut& lut) {
+    for (int i = 0; i < n; i++) {
+        const uint8_t* px = src_row + x_idx[i] * 2;
+        uint32_t p = BigEndian ? ((uint32_t)px[0] << 8 | px[1]) : ((uint32_t)px[1] << 8 | px[0]);
+        dst[i * 3 + 0] = lut.r5[p >> 11];
+        dst[i * 3 + 1] = lut.g6[(p >> 5) & 63];
+        dst[i * 3 + 2] = lut.b5[p & 31];
+    }
+}
+
+/**
+ * @brief YUV422 counterpart of yolo26_convert_rgb565_row(). `YOff` is the byte offset of Y0 in
+ * each 4-byte pixel pair (0 for YUYV, 1 for UYVY); U and V sit in the other two slots.
+ */
+template <int YOff>
+inline void yolo26_convert_yuv422_row(const uint8_t* src_row, const int* x_idx, int n, int8_t* dst, const Yolo26ColorLut& lut) {
+    constexpr int UOff = YOff == 0 ? 1 : 0;
+    const int8_t* q = lut.clamp_q + YOLO_COLOR_CLAMP_BIAS;
+    for (int i = 0; i < n; i++) {
+        int x = x_idx[i];
+        const uint8_t* pair = src_row + (x & ~1) * 2;
+        int y = src_row[x * 2 + YOff];
+        int u = pair[UOff];
+        int v = pair[UOff + 2];
+        dst[i * 3 + 0] = q[y + lut.rv[v]];
+        dst[i * 3 + 1] = q[y + lut.gu[u] + lut.gv[v]];
+        dst[i * 3 + 2] = q[y + lut.bu[u]];
+    }
+}
+
+/**
+ * @brief Dispatches one row of `frame` to the kernel of its format.
+ */
+inline void yolo26_convert_row(const Yolo26CameraFrame& frame, const uint8_t* src_row, const int* x_idx, int n, int8_t* dst,
+                               const Yolo26ColorLut& lut) {
+    switch (frame.format) {
+    case YOLO_PIX_RGB565_LE: yolo26_convert_rgb565_row<false>(src_row, x_idx, n, dst, lut); break;
+    case YOLO_PIX_RGB565_BE: yolo26_convert_rgb565_row<true>(src_row, x_idx, n, dst, lut); break;
+    case YOLO_PIX_YUYV: yolo26_convert_yuv422_row<0>(src_row, x_idx, n, dst, lut); break;
+    case YOLO_PIX_UYVY: yolo26_convert_yuv422_row<1>(src_row, x_idx, n, dst, lut); break;
+    }
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "driver/uart.h"
+#include "driver/usb_serial_jtag.h"
+#include "yolo_record.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Default Dump Configuration
+#define YOLO_DUMP_SLOTS 2              // Frames buffered between the inference loop and the writer
+#define YOLO_DUMP_STACK_SIZE 4096
+#define YOLO_DUMP_PRIORITY 2           // Below every pipeline stage: dumping never preempts them
+#define YOLO_DUMP_CORE 0
+#define YOLO_DUMP_UART_TX_BUFFER 16384 // Driver ring buffer drained by the UART TX interrupt
+#define YOLO_DUMP_USB_TX_BUFFER 16384
+
+/**
+ * @brief Writes `len` bytes to the dump destination. Runs on the dump writer task.
+ * @return false on a write error (the frame is counted as failed)
+ */
+typedef bool (*Yolo26DumpWriteFn)(const uint8_t* data, size_t len, void* ctx);
+
+struct Yolo26DumpConfig {
+    Yolo26DumpWriteFn write = nullptr; // Required, see yolo26_dump_*_write below
+    void* ctx = nullptr;
+    int slots = YOLO_DUMP_SLOTS;
+    int every_n = 1;                   // Dump one of every N submitted frames
+    bool include_input = false;        // Also dump the quantized input tensor (~786 KB at 512x512)
+    uint32_t stack_size = YOLO_DUMP_STACK_SIZE;
+    UBaseType_t priority = YOLO_DUMP_PRIORITY;
+    BaseType_t core = YOLO_DUMP_CORE;
+};
+
+struct Yolo26DumpStats {
+    uint32_t written;   // Frames handed to the destination
+    uint32_t dropped;   // Submitted while every slot was still being written
+    uint32_t failed;    // Serialization or write errors
+    uint64_t bytes;
+};
+
+/**
+ * @brief Streams raw model tensors to a UART, USB-Serial-JTAG or a file in the background.
+ *
+ * submit() is called from the inference loop right after model->run(). It serializes the
+ * outputs (and optionally the input) into a free PSRAM slot, which is a few memcpy()s, and
+ * hands the slot to a low-priority writer task. The writer adds the frame header and CRC and
+ * pushes the bytes out; slow transports (a 921600 baud UART needs ~5 s for 512x512 outputs)
+ * therefore only cost dropped dump frames, never inference time. If no slot is free the frame
+ * is skipped and counted.
+ *
+ * Frames use the framed .y26t layout (yolo_record.hpp), so captures interleaved with console
+ * output can be split again on the host (yolo26_replay, visualize_esp32_output.py).
+ * Slots are sized once in init() from the model tensors; nothing is allocated per frame.
+ */
+class Yolo26TensorDump {
+private:
+    struct Slot {
+        uint8_t* buf;       // Frame header + record + CRC
+        size_t record_len;
+        uint32_t seq;
+        uint32_t time_ms;
+    };
+
+    Yolo26DumpConfig config;
+    std::vector<Slot> slots;
+    size_t slot_capacity = 0;   // Record bytes per slot
+    QueueHandle_t free_q = nullptr;
+    QueueHandle_t write_q = nullptr;
+    SemaphoreHandle_t exit_sem = nullptr;
+    TaskHandle_t task = nullptr;
+    uint32_t submitted = 0;
+    uint32_t next_seq = 0;
+
+    std::atomic<uint32_t> written{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> failed{0};
+    std::atomic<uint64_t> bytes{0};
+
+    void writer_loop() {
+        for (;;) {
+            int idx;
+            xQueueReceive(write_q, &idx, portMAX_DELAY);
+            if (idx < 0) break; // stop()
+
+            Slot& s = slots[idx];
+            size_t len = yolo26_frame_finish(s.buf, s.record_len, s.seq, s.time_ms);
+            if (config.write(s.buf, len, config.ctx)) {
+                written++;
+                bytes += len;
+            } else {
+                failed++;
+            }
+            xQueueSend(free_q, &idx, portMAX_DELAY);
+        }
+    }
+
+    static void task_entry(void* arg) {
+        Yolo26TensorDump* self = static_cast<Yolo26TensorDump*>(arg);
+        self->writer_loop();
+        xSemaphoreGive(self->exit_sem);
+        vTaskDelete(nullptr);
+    }
+
+public:
+    Yolo26TensorDump(const Yolo26DumpConfig& cfg) : config(cfg) {}
+
+    ~Yolo26TensorDump() { deinit(); }
+
+    Yolo26TensorDump(const Yolo26TensorDump&) = delete;
+    Yolo26TensorDump& operator=(const Yolo26TensorDump&) = delete;
+
+    /**
+     * @brief Sizes the slots for `outputs` (plus `inputs` when include_input is set) and starts the writer.
+     */
+    bool init(const Yolo26TensorMap& outputs, const Yolo26TensorMap& inputs) {
+        if (task || !config.write || config.slots <= 0) return false;
+        slot_capacity = yolo26_record_size(outputs, config.include_input ? &inputs : nullptr);
+        if (slot_capacity == 0) return false;
+
+        size_t slot_bytes = sizeof(Yolo26FrameHeader) + slot_capacity + 4;
+        for (int i = 0; i < config.slots; i++) {
+            uint8_t* buf = (uint8_t*)heap_caps_malloc(slot_bytes, MALLOC_CAP_SPIRAM);
+            if (!buf) {
+                printf("[Yolo26TensorDump] Error: Failed to allocate %u byte slot\n", (unsigned)slot_bytes);
+                deinit();
+                return false;
+            }
+            slots.push_back({buf, 0, 0, 0});
+        }
+
+        free_q = xQueueCreate(config.slots, sizeof(int));
+        write_q = xQueueCreate(config.slots + 1, sizeof(int)); // +1: stop() sentinel
+        exit_sem = xSemaphoreCreateBinary();
+        for (int i = 0; i < config.slots; i++) xQueueSend(free_q, &i, 0);
+
+        if (xTaskCreatePinnedToCore(task_entry, "yolo_dump", config.stack_size, this, config.priority, &task, config.core) != pdPASS) {
+            printf("[Yolo26TensorDump] Error: Failed to create writer task\n");
+            task = nullptr;
+            deinit();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Waits for frames already queued to be written, then stops the writer and frees the slots.
+     */
+    void deinit() {
+        if (task) {
+            int stop = -1;
+            xQueueSend(write_q, &stop, portMAX_DELAY);
+            xSemaphoreTake(exit_sem, portMAX_DELAY);
+            task = nullptr;
+        }
+        if (free_q) vQueueDelete(free_q);
+        if (write_q) vQueueDelete(write_q);
+        if (exit_sem) vSemaphoreDelete(exit_sem);
+        free_q = write_q = nullptr;
+        exit_sem = nullptr;
+        for (Slot& s : slots) heap_caps_free(s.buf);
+        slots.clear();
+    }
+
+    /**
+     * @brief Queues one frame of tensors for writing. Never blocks.
+     * Call while `outputs` still hold this frame (before the next model->run()).
+     * @return true if the frame was queued
+     */
+    bool submit(const Yolo26TensorMap& outputs, const Yolo26TensorMap* inputs = nullptr) {
+        if (!task) return false;
+        if (config.every_n > 1 && submitted++ % config.every_n != 0) return false;
+        int idx;
+        if (xQueueReceive(free_q, &idx, 0) != pdTRUE) {
+            dropped++;
+            return false;
+        }
+        Slot& s = slots[idx];
+        s.record_len = yolo26_record_serialize(outputs, config.include_input ? inputs : nullptr,
+                                               s.buf + sizeof(Yolo26FrameHeader), slot_capacity);
+        if (s.record_len == 0) {
+            failed++;
+            xQueueSend(free_q, &idx, 0);
+            return false;
+        }
+        s.seq = next_seq++;
+        s.time_ms = (uint32_t)(esp_timer_get_time() / 1000);
+        xQueueSend(write_q, &idx, 0); // Holds every slot, never full
+        return true;
+    }
+
+    Yolo26DumpStats get_stats() const {
+        return {written.load(), dropped.load(), failed.load(), bytes.load()};
+    }
+};
+
+// --- Destinations ---
+
+/**
+ * @brief FILE* destination (ctx), e.g. a file on a mounted SD card. Flushed per frame.
+ */
+inline bool yolo26_dump_file_write(const uint8_t* data, size_t len, void* ctx) {
+    FILE* f = (FILE*)ctx;
+    return fwrite(data, 1, len, f) == len && fflush(f) == 0;
+}
+
+/**
+ * @brief UART destination; ctx is the port number cast to a pointer.
+ * Bytes go through the driver's TX ring buffer and are drained by interrupt, so only the
+ * writer task waits. On the console UART, frames interleave with log lines; the framing
+ * lets the host split them again.
+ */
+inline bool yolo26_dump_uart_write(const uint8_t* data, size_t len, void* ctx) {
+    uart_port_t port = (uart_port_t)(intptr_t)ctx;
+    return uart_write_bytes(port, data, len) == (int)len;
+}
+
+/**
+ * @brief Installs the UART driver (if the console has not already) with a TX ring buffer.
+ * @param baud 0 keeps the current baud rate
+ */
+inline bool yolo26_dump_uart_init(uart_port_t port, int baud) {
+    if (!uart_is_driver_installed(port) &&
+        uart_driver_install(port, 256, YOLO_DUMP_UART_TX_BUFFER, 0, nullptr, 0) != ESP_OK) {
+        printf("[Yolo26TensorDump] Error: UART%d driver install failed\n", (int)port);
+        return false;
+    }
+    return baud <= 0 || uart_set_baudrate(port, baud) == ESP_OK;
+}
+
+/**
+ * @brief USB-Serial-JTAG destination (ctx unused). Requires yolo26_dump_usb_init().
+ */
+inline bool yolo26_dump_usb_write(const uint8_t* data, size_t len, void*) {
+    size_t sent = 0;
+    while (sent < len) {
+        int n = usb_serial_jtag_write_bytes(data + sent, len - sent, pdMS_TO_TICKS(1000));
+        if (n <= 0) return false; // Host not reading
+        sent += n;
+    }
+    return true;
+}
+
+inline bool yolo26_dump_usb_init() {
+    if (usb_serial_jtag_is_driver_installed()) return true;
+    usb_serial_jtag_driver_config_t cfg = USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT();
+    cfg.tx_buffer_size = YOLO_DUMP_USB_TX_BUFFER;
+    if (usb_serial_jtag_driver_install(&cfg) != ESP_OK) {
+        printf("[Yolo26TensorDump] Error: USB-Serial-JTAG driver install failed\n");
+        return false;
+    }
+    return true;
+}
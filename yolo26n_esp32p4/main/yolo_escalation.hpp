@@ -0,0 +1,72 @@
+#pragma once
+#include "yolo_processor.hpp"
+
+// Resolution escalation: run the small model normally and the large one only while a
+// detection sits close to the decision threshold, where the extra resolution decides.
+//
+// The decision threshold is the score the application acts on, not the processor's top-K
+// floor (YOLO_CONF_THRESH): a real scene always fills the top-K list with a tail of weak
+// scores just above the floor, and measuring against it would escalate every frame.
+
+#define YOLO_ESCALATE_DECISION 0.30f // Score at which the application treats a detection as real
+#define YOLO_ESCALATE_MARGIN 0.10f   // Scores within this of the decision threshold count as uncertain
+#define YOLO_ESCALATE_HOLD 5         // Frames to stay on the large model after the last uncertain one
+
+struct Yolo26EscalationConfig {
+    float decision_thresh = YOLO_ESCALATE_DECISION;
+    float margin = YOLO_ESCALATE_MARGIN;
+    int hold_frames = YOLO_ESCALATE_HOLD;
+};
+
+/**
+ * @brief Picks the model level (0 = low resolution, 1 = high) for each frame from its detections.
+ *
+ * update() is fed the detections of every processed frame. Uncertain detections at level 0 ask
+ * to re-run the frame at level 1; level 1 is held for hold_frames frames without uncertain
+ * detections, so the model does not flip on every frame.
+ */
+class Yolo26Escalation {
+private:
+    Yolo26EscalationConfig config;
+    int level = 0;
+    int calm_frames = 0; // At level 1: consecutive frames without uncertain detections
+
+public:
+    Yolo26Escalation(const Yolo26EscalationConfig& cfg = Yolo26EscalationConfig()) : config(cfg) {}
+
+    /**
+     * @brief True if a detection scores in [decision_thresh - margin, decision_thresh + margin).
+     * Scores below the band are the top-K tail and never escalate.
+     */
+    bool is_uncertain(const Detection* dets, int n) const {
+        for (int i = 0; i < n; i++) {
+            if (dets[i].score >= config.decision_thresh - config.margin &&
+                dets[i].score < config.decision_thresh + config.margin) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Updates the level from the detections of a frame run at get_level().
+     * @return true if the level rose: re-run this frame at the new level for its answer
+     */
+    bool update(const Detection* dets, int n) {
+        bool uncertain = is_uncertain(dets, n);
+        if (level == 0) {
+            if (!uncertain) return false;
+            level = 1;
+            calm_frames = 0;
+            return true;
+        }
+        calm_frames = uncertain ? 0 : calm_frames + 1;
+        if (calm_frames >= config.hold_frames) level = 0;
+        return false;
+    }
+
+    int get_level() const { return level; }
+
+    void reset() {
+        level = 0;
+        calm_frames = 0;
+    }
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#ifdef ESP_PLATFORM
+#include "esp_memory_utils.h"
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Memory placement policy for the processor's own buffers.
+//
+// Two classes of memory, each with fixed heap capabilities instead of MALLOC_CAP_DEFAULT:
+// - Hot: small state read for every pixel or candidate (quantization and color LUTs, class
+//   thresholds, top-K heaps, sampling maps). Internal SRAM, optionally the ESP32-P4's TCM,
+//   so the inner loops never miss to PSRAM.
+// - Frame: decoded and resized images. PSRAM, aligned to the L2 cache line and padded to
+//   whole lines, so cache writeback / invalidation around the PPA and JPEG DMA never touches
+//   a neighbouring allocation.
+// Either class falls back to the default heap when its region is exhausted (or absent, e.g.
+// no PSRAM), so placement only ever changes speed, not behaviour.
+// Model tensors, including the output heads postprocess() reads, are placed by esp-dl's memory
+// planner; dl::Model's max_internal_size is the only lever there (CONFIG_YOLO_MODEL_INTERNAL_KB).
+
+// Default Memory Placement Configuration
+#if CONFIG_CACHE_L2_CACHE_LINE_64B
+#define YOLO_MEM_CACHE_LINE 64
+#else
+#define YOLO_MEM_CACHE_LINE 128  // CONFIG_CACHE_L2_CACHE_LINE_128B (sdkconfig.defaults.esp32p4)
+#endif
+#define YOLO_MEM_HOT_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define YOLO_MEM_FRAME_CAPS (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+#if defined(ESP_PLATFORM) && !CONFIG_YOLO_MEM_PLACEMENT
+#define YOLO_MEM_PLACEMENT 0 // Kconfig: leave every buffer to malloc (MALLOC_CAP_DEFAULT)
+#else
+#define YOLO_MEM_PLACEMENT 1
+#endif
+
+#if YOLO_MEM_PLACEMENT && CONFIG_YOLO_MEM_HOT_TCM && defined(MALLOC_CAP_TCM)
+#define YOLO_MEM_HOT_TRY_TCM 1
+#else
+#define YOLO_MEM_HOT_TRY_TCM 0
+#endif
+
+/**
+ * @brief Allocates `bytes` of hot state: TCM (if enabled), then internal SRAM, then the default heap.
+ * Free with heap_caps_free().
+ */
+inline void* yolo26_alloc_hot(size_t bytes) {
+#if YOLO_MEM_PLACEMENT
+#if YOLO_MEM_HOT_TRY_TCM
+    if (void* p = heap_caps_malloc(bytes, MALLOC_CAP_TCM)) return p;
+#endif
+    if (void* p = heap_caps_malloc(bytes, YOLO_MEM_HOT_CAPS)) return p;
+#endif
+    return heap_caps_malloc(bytes, MALLOC_CAP_DEFAULT);
+}
+
+/**
+ * @brief Allocates a frame buffer: PSRAM, aligned to max(`align`, YOLO_MEM_CACHE_LINE) with
+ * `bytes` rounded up to whole lines (written back). Without placement only a non-zero `align`
+ * (e.g. the PPA's) forces an aligned PSRAM buffer. Free with heap_caps_free().
+ */
+inline void* yolo26_alloc_frame(size_t& bytes, size_t align = 0) {
+#if YOLO_MEM_PLACEMENT
+    if (align < YOLO_MEM_CACHE_LINE) align = YOLO_MEM_CACHE_LINE;
+#endif
+    if (!align) return heap_caps_malloc(bytes, MALLOC_CAP_DEFAULT);
+    bytes = (bytes + align - 1) / align * align;
+    if (void* p = heap_caps_aligned_alloc(align, bytes, YOLO_MEM_FRAME_CAPS)) return p;
+    return heap_caps_aligned_alloc(align, bytes, MALLOC_CAP_DEFAULT);
+}
+
+/**
+ * @brief std::allocator replacement that places container storage with yolo26_alloc_hot().
+ */
+template <typename T>
+struct Yolo26HotAllocator {
+    using value_type = T;
+
+    Yolo26HotAllocator() = default;
+    template <typename U>
+    Yolo26HotAllocator(const Yolo26HotAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* p = yolo26_alloc_hot(n * sizeof(T));
+        if (!p) {
+            // Firmware builds without exceptions: a container cannot report the failure
+            printf("[Yolo26Memory] Error: Failed to allocate %u bytes of hot state\n", (unsigned)(n * sizeof(T)));
+            abort();
+        }
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t) { heap_caps_free(p); }
+
+    template <typename U>
+    bool operator==(const Yolo26HotAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const Yolo26HotAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using Yolo26HotVector = std::vector<T, Yolo26HotAllocator<T>>;
+
+/**
+ * @brief Memory region holding `p`: "TCM", "SRAM", "PSRAM", "flash" or "heap" (host build).
+ */
+inline const char* yolo26_mem_region(const void* p) {
+    if (!p) return "-";
+#ifdef ESP_PLATFORM
+#if SOC_MEM_TCM_SUPPORTED
+    if (esp_ptr_in_tcm(p)) return "TCM";
+#endif
+    if (esp_ptr_external_ram(p)) return "PSRAM";
+    if (esp_ptr_internal(p)) return "SRAM";
+    if (esp_ptr_in_drom(p)) return "flash";
+    return "?";
+#else
+    return "heap";
+#endif
+}
+
+/**
+ * @brief One line of the startup placement report.
+ */
+inline void yolo26_print_placement(const char* name, const void* p, size_t bytes) {
+    printf("  %-20s %-6s %7u B  %p\n", name, yolo26_mem_region(p), (unsigned)bytes, p);
+}
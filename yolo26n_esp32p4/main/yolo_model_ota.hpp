@@ -0,0 +1,389 @@
+#pragma once
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "mbedtls/sha256.h"
+#include "nvs.h"
+#include "yolo_startup.hpp"
+#include <cstdio>
+#include <cstring>
+
+// A/B model slots: two data partitions hold .espdl images independently of the firmware.
+// Updates stream into the inactive slot; NVS records which slot is active and the size, version
+// and SHA-256 of each image. A new slot is on trial until confirm(); a boot that finds a slot still
+// on trial from the previous boot rolls back, like the app OTA rollback of ESP-IDF.
+
+// Default OTA Configuration
+#define YOLO_MODEL_SLOT_B_LABEL "model_b"      // Slot A is YOLO_MODEL_PARTITION_LABEL
+#define YOLO_MODEL_NVS_NAMESPACE "yolo_model"
+#define YOLO_MODEL_OTA_CHUNK 4096              // Flash sector: erase, write and read-back unit
+
+enum Yolo26ModelSlotState : uint8_t {
+    YOLO_SLOT_CONFIRMED = 0, // Active slot has run successfully
+    YOLO_SLOT_PENDING = 1,   // Activated by an update, not booted yet
+    YOLO_SLOT_TRIAL = 2,     // Booted once, waiting for confirm()
+};
+
+// Image record per slot, stored in NVS. size = 0: unknown image (e.g. written by idf.py flash)
+struct Yolo26ModelSlotInfo {
+    uint32_t size;
+    uint32_t version;
+    uint8_t sha256[32];
+};
+
+/**
+ * @brief The two model partitions and their NVS state.
+ *
+ * Requires nvs_flash_init() before init(). Without init() (or if NVS is unavailable) slot A is
+ * active and nothing is recorded, which is the state after a fresh idf.py flash.
+ */
+class Yolo26ModelSlots {
+private:
+    const char* labels[2] = {YOLO_MODEL_PARTITION_LABEL, YOLO_MODEL_SLOT_B_LABEL};
+    const esp_partition_t* parts[2] = {nullptr, nullptr};
+    Yolo26ModelSlotInfo info[2] = {};
+    int active = 0;
+    Yolo26ModelSlotState state = YOLO_SLOT_CONFIRMED;
+    bool rolled_back = false;
+
+    static void info_key(int slot, char* key) { snprintf(key, 8, "slot%d", slot); }
+
+    bool save() {
+        nvs_handle_t h;
+        if (nvs_open(YOLO_MODEL_NVS_NAMESPACE, NVS_READWRITE, &h) != ESP_OK) {
+            printf("[Yolo26ModelSlots] Error: Cannot open NVS namespace '%s'\n", YOLO_MODEL_NVS_NAMESPACE);
+            return false;
+        }
+        char key[8];
+        esp_err_t err = nvs_set_u8(h, "active", (uint8_t)active);
+        if (err == ESP_OK) err = nvs_set_u8(h, "state", (uint8_t)state);
+        for (int s = 0; s < 2 && err == ESP_OK; s++) {
+            info_key(s, key);
+            err = nvs_set_blob(h, key, &info[s], sizeof(info[s]));
+        }
+        if (err == ESP_OK) err = nvs_commit(h);
+        nvs_close(h);
+        if (err != ESP_OK) printf("[Yolo26ModelSlots] Error: NVS write failed (%d)\n", (int)err);
+        return err == ESP_OK;
+    }
+
+public:
+    /**
+     * @brief Finds both partitions, loads the NVS state and applies the trial rules.
+     * @return false if a partition is missing
+     */
+    bool init() {
+        for (int s = 0; s < 2; s++) {
+            parts[s] = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, labels[s]);
+            if (!parts[s]) {
+                printf("[Yolo26ModelSlots] Error: No '%s' data partition in the partition table\n", labels[s]);
+                return false;
+            }
+        }
+
+        nvs_handle_t h;
+        if (nvs_open(YOLO_MODEL_NVS_NAMESPACE, NVS_READONLY, &h) == ESP_OK) {
+            uint8_t a = 0, st = YOLO_SLOT_CONFIRMED;
+            nvs_get_u8(h, "active", &a);
+            nvs_get_u8(h, "state", &st);
+            active = a & 1;
+            state = (Yolo26ModelSlotState)st;
+            char key[8];
+            for (int s = 0; s < 2; s++) {
+                size_t len = sizeof(info[s]);
+                info_key(s, key);
+                if (nvs_get_blob(h, key, &info[s], &len) != ESP_OK || len != sizeof(info[s])) info[s] = {};
+            }
+            nvs_close(h);
+        }
+
+        if (state == YOLO_SLOT_PENDING) {
+            state = YOLO_SLOT_TRIAL;
+            save();
+        } else if (state == YOLO_SLOT_TRIAL) {
+            printf("[Yolo26ModelSlots] Slot '%s' was never confirmed, rolling back\n", labels[active]);
+            rollback();
+        }
+        return true;
+    }
+
+    int get_active() const { return active; }
+    const char* get_label(int slot) const { return labels[slot]; }
+    const char* get_active_label() const { return labels[active]; }
+    const esp_partition_t* get_partition(int slot) const { return parts[slot]; }
+    const Yolo26ModelSlotInfo& get_info(int slot) const { return info[slot]; }
+    Yolo26ModelSlotState get_state() const { return state; }
+    bool was_rolled_back() const { return rolled_back; }
+
+    /**
+     * @brief Hashes the image in `slot` and compares it with its NVS record.
+     * A slot without a record (size 0) passes if its partition is not blank.
+     */
+    bool verify(int slot) const {
+        const esp_partition_t* part = parts[slot];
+        if (!part) return false;
+        if (info[slot].size == 0) return yolo26_find_model_partition(labels[slot]) != nullptr;
+        if (info[slot].size > part->size) return false;
+
+        uint8_t* buf = (uint8_t*)heap_caps_malloc(YOLO_MODEL_OTA_CHUNK, MALLOC_CAP_INTERNAL);
+        if (!buf) return false;
+        mbedtls_sha256_context sha;
+        mbedtls_sha256_init(&sha);
+        mbedtls_sha256_starts(&sha, 0);
+        bool ok = true;
+        for (uint32_t off = 0; ok && off < info[slot].size; off += YOLO_MODEL_OTA_CHUNK) {
+            size_t n = info[slot].size - off < YOLO_MODEL_OTA_CHUNK ? info[slot].size - off : YOLO_MODEL_OTA_CHUNK;
+            ok = esp_partition_read(part, off, buf, n) == ESP_OK;
+            if (ok) mbedtls_sha256_update(&sha, buf, n);
+        }
+        uint8_t digest[32];
+        mbedtls_sha256_finish(&sha, digest);
+        mbedtls_sha256_free(&sha);
+        heap_caps_free(buf);
+
+        if (ok && memcmp(digest, info[slot].sha256, 32) != 0) {
+            printf("[Yolo26ModelSlots] Error: Slot '%s' does not match its SHA-256\n", labels[slot]);
+            ok = false;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Makes `slot` active with the image record `rec`; it stays on trial until confirm().
+     * @param run_now A model is built from `slot` in this boot: put it on trial right away, so a
+     *                crash rolls back on the next boot instead of retrying the slot once more
+     */
+    bool activate(int slot, const Yolo26ModelSlotInfo& rec, bool run_now = false) {
+        info[slot] = rec;
+        active = slot;
+        state = run_now ? YOLO_SLOT_TRIAL : YOLO_SLOT_PENDING;
+        rolled_back = false;
+        return save();
+    }
+
+    /**
+     * @brief Marks the active slot as good. Call once a model built from it has produced results.
+     */
+    bool confirm() {
+        if (state == YOLO_SLOT_CONFIRMED) return true;
+        state = YOLO_SLOT_CONFIRMED;
+        return save();
+    }
+
+    /**
+     * @brief Returns to the other slot (e.g. after the active one failed to load).
+     * @return false if the other slot holds no image
+     */
+    bool rollback() {
+        int other = active ^ 1;
+        if (!parts[other] || (info[other].size == 0 && !yolo26_find_model_partition(labels[other]))) {
+            printf("[Yolo26ModelSlots] Error: No image in slot '%s' to roll back to\n", labels[other]);
+            state = YOLO_SLOT_CONFIRMED;
+            save();
+            return false;
+        }
+        active = other;
+        state = YOLO_SLOT_CONFIRMED;
+        rolled_back = true;
+        return save();
+    }
+
+    void print_summary() const {
+        static const char* state_names[] = {"confirmed", "pending", "trial"};
+        printf("Model slots (active: %s, %s%s):\n", labels[active], state_names[state % 3], rolled_back ? ", rolled back" : "");
+        for (int s = 0; s < 2; s++) {
+            if (info[s].size == 0) {
+                printf("  %-8s %s| no record\n", labels[s], s == active ? "* " : "  ");
+                continue;
+            }
+            printf("  %-8s %s| v%lu | %lu B | sha256 %02x%02x%02x%02x...\n", labels[s], s == active ? "* " : "  ",
+                   (unsigned long)info[s].version, (unsigned long)info[s].size, info[s].sha256[0], info[s].sha256[1],
+                   info[s].sha256[2], info[s].sha256[3]);
+        }
+    }
+};
+
+/**
+ * @brief Streams a new .espdl image into the inactive slot.
+ *
+ * write() accepts the image in pieces of any size (HTTP body, BLE, SD card reads). Every full
+ * sector is erased, written, read back and compared before it is hashed, so a flash fault fails
+ * the update at that chunk instead of after the whole transfer. finish() checks the total size and
+ * SHA-256 and only then activates the slot. The active slot, which a running model may have mapped,
+ * is never written: begin() refuses to start while the active slot is unconfirmed, because the
+ * running model may still be mapped from the other one and, on trial, that one is the rollback image.
+ */
+class Yolo26ModelUpdate {
+private:
+    Yolo26ModelSlots& slots;
+    int target = -1;
+    const esp_partition_t* part = nullptr;
+    Yolo26ModelSlotInfo rec = {};
+    size_t written = 0;
+    size_t fill = 0;
+    uint8_t* chunk = nullptr;    // Pending bytes of the current sector
+    uint8_t* readback = nullptr;
+    mbedtls_sha256_context sha;
+
+    bool flush() {
+        if (fill == 0) return true;
+        bool ok = esp_partition_erase_range(part, written, YOLO_MODEL_OTA_CHUNK) == ESP_OK &&
+                  esp_partition_write(part, written, chunk, fill) == ESP_OK &&
+                  esp_partition_read(part, written, readback, fill) == ESP_OK && memcmp(chunk, readback, fill) == 0;
+        if (!ok) {
+            printf("[Yolo26ModelUpdate] Error: Chunk at offset %u failed to write or verify\n", (unsigned)written);
+            return false;
+        }
+        mbedtls_sha256_update(&sha, chunk, fill);
+        written += fill;
+        fill = 0;
+        return true;
+    }
+
+    void release() {
+        if (chunk) {
+            mbedtls_sha256_free(&sha);
+        }
+        heap_caps_free(chunk);
+        heap_caps_free(readback);
+        chunk = readback = nullptr;
+        target = -1;
+    }
+
+public:
+    Yolo26ModelUpdate(Yolo26ModelSlots& s) : slots(s) {}
+    ~Yolo26ModelUpdate() { release(); }
+
+    Yolo26ModelUpdate(const Yolo26ModelUpdate&) = delete;
+    Yolo26ModelUpdate& operator=(const Yolo26ModelUpdate&) = delete;
+
+    /**
+     * @brief Starts an update of `size` bytes whose SHA-256 must equal `sha256`.
+     */
+    bool begin(size_t size, const uint8_t sha256[32], uint32_t version) {
+        release();
+        int slot = slots.get_active() ^ 1;
+        if (slots.get_state() != YOLO_SLOT_CONFIRMED) {
+            printf("[Yolo26ModelUpdate] Error: Slot '%s' is not confirmed yet, '%s' cannot be written\n",
+                   slots.get_active_label(), slots.get_label(slot));
+            return false;
+        }
+        part = slots.get_partition(slot);
+        if (!part || size == 0 || size > part->size) {
+            printf("[Yolo26ModelUpdate] Error: %u byte image does not fit slot '%s'\n", (unsigned)size, slots.get_label(slot));
+            return false;
+        }
+        chunk = (uint8_t*)heap_caps_malloc(YOLO_MODEL_OTA_CHUNK, MALLOC_CAP_INTERNAL);
+        readback = (uint8_t*)heap_caps_malloc(YOLO_MODEL_OTA_CHUNK, MALLOC_CAP_INTERNAL);
+        if (!chunk || !readback) {
+            printf("[Yolo26ModelUpdate] Error: Failed to allocate chunk buffers\n");
+            heap_caps_free(chunk);
+            heap_caps_free(readback);
+            chunk = readback = nullptr;
+            return false;
+        }
+        mbedtls_sha256_init(&sha);
+        mbedtls_sha256_starts(&sha, 0);
+        rec = {(uint32_t)size, version, {}};
+        memcpy(rec.sha256, sha256, 32);
+        written = fill = 0;
+        target = slot;
+        return true;
+    }
+
+    bool write(const uint8_t* data, size_t len) {
+        if (target < 0) return false;
+        if (written + fill + len > rec.size) {
+            printf("[Yolo26ModelUpdate] Error: More data than the announced %lu bytes\n", (unsigned long)rec.size);
+            release();
+            return false;
+        }
+        while (len > 0) {
+            size_t n = YOLO_MODEL_OTA_CHUNK - fill < len ? YOLO_MODEL_OTA_CHUNK - fill : len;
+            memcpy(chunk + fill, data, n);
+            fill += n;
+            data += n;
+            len -= n;
+            if (fill == YOLO_MODEL_OTA_CHUNK && !flush()) {
+                release();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Verifies size and SHA-256 and activates the new slot (on trial until confirm()).
+     * The running model keeps using the old slot until it is rebuilt from get_active_label().
+     * @param run_now The model is rebuilt from the new slot in this boot (see Yolo26ModelSlots::activate())
+     */
+    bool finish(bool run_now = false) {
+        if (target < 0) return false;
+        bool ok = flush() && written == rec.size;
+        uint8_t digest[32];
+        mbedtls_sha256_finish(&sha, digest);
+        if (ok && memcmp(digest, rec.sha256, 32) != 0) {
+            printf("[Yolo26ModelUpdate] Error: SHA-256 mismatch, slot '%s' not activated\n", slots.get_label(target));
+            ok = false;
+        } else if (!ok) {
+            printf("[Yolo26ModelUpdate] Error: Image incomplete (%u of %lu bytes)\n", (unsigned)written, (unsigned long)rec.size);
+        }
+        int slot = target;
+        release();
+        return ok && slots.activate(slot, rec, run_now);
+    }
+
+    void abort() { release(); }
+
+    size_t get_written() const { return written + fill; }
+};
+
+/**
+ * @brief Parses 64 hex digits (e.g. the first token of a sha256sum line).
+ */
+inline bool yolo26_parse_sha256(const char* hex, uint8_t out[32]) {
+    for (int i = 0; i < 32; i++) {
+        unsigned v;
+        if (sscanf(hex + 2 * i, "%2x", &v) != 1) return false;
+        out[i] = (uint8_t)v;
+    }
+    return true;
+}
+
+/**
+ * @brief Installs the .espdl at `path` (e.g. on a mounted SD card) into the inactive slot.
+ * The expected digest is read from `<path>.sha256` (sha256sum output).
+ * @param run_now The model is built from the new slot in this boot (see Yolo26ModelSlots::activate())
+ */
+inline bool yolo26_model_update_from_file(Yolo26ModelSlots& slots, const char* path, uint32_t version, bool run_now = false) {
+    char sha_path[128];
+    snprintf(sha_path, sizeof(sha_path), "%s.sha256", path);
+    FILE* hf = fopen(sha_path, "r");
+    char hex[65] = {};
+    uint8_t sha256[32];
+    bool have_sha = hf && fread(hex, 1, 64, hf) == 64 && yolo26_parse_sha256(hex, sha256);
+    if (hf) fclose(hf);
+    if (!have_sha) {
+        printf("[Yolo26ModelUpdate] Error: No valid digest in %s\n", sha_path);
+        return false;
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        printf("[Yolo26ModelUpdate] Error: Cannot open %s\n", path);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    Yolo26ModelUpdate update(slots);
+    bool ok = size > 0 && update.begin((size_t)size, sha256, version);
+    static uint8_t buf[YOLO_MODEL_OTA_CHUNK]; // Kept off the caller's stack
+    while (ok) {
+        size_t n = fread(buf, 1, sizeof(buf), f);
+        if (n == 0) break;
+        ok = update.write(buf, n);
+    }
+    fclose(f);
+    return ok && update.finish(run_now);
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include "dl_model_base.hpp"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "yolo_arena.hpp"
+#include <cstdio>
+#include <cstring>
+
+// Default Registry Configuration
+#define YOLO_MODEL_MAX_ENTRIES 4
+
+enum Yolo26ModelPolicy {
+    YOLO_MODEL_SHARED,   // One model built at a time; a switch frees it and builds the next in the same memory
+    YOLO_MODEL_RESIDENT, // Every selected model stays built; a switch is a pointer swap
+};
+
+struct Yolo26ModelRegistryConfig {
+    Yolo26ModelPolicy policy = YOLO_MODEL_SHARED;
+    int max_internal_size = 0; // dl::Model internal SRAM budget for tensors (0 = esp-dl default)
+    bool param_copy = true;    // Copy weights to PSRAM: faster inference, slower build (SHARED switches)
+};
+
+// Memory a built model holds: heap drop measured across its construction
+struct Yolo26ModelFootprint {
+    long internal_bytes;
+    long psram_bytes;
+};
+
+struct Yolo26SwitchStats {
+    uint32_t count;    // select() calls that changed the active model
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+};
+
+/**
+ * @brief Set of embedded .espdl models (e.g. 512 and 640 input) with one active model.
+ *
+ * SHARED keeps peak memory at the largest model's: the active model is deleted before the next
+ * one is built, so the heap regions esp-dl's memory planner used are the arena the next model
+ * plans into. A switch costs one model build; build with param_copy = false to leave the
+ * weights in mapped flash and keep it short. RESIDENT builds each model once and keeps it, so
+ * switching costs nothing after the first use but memory is the sum of all models.
+ *
+ * After select(), bind processors to get()->get_inputs() (Yolo26Processor<>::bind()); the
+ * runtime facade routes both shipped resolutions to their specialized decode loops.
+ */
+class Yolo26ModelRegistry {
+private:
+    struct Entry {
+        const char* tag;
+        const char* address; // rodata address, or partition label for MODEL_LOCATION_IN_FLASH_PARTITION
+        fbs::model_location_type_t location;
+        dl::Model* model;
+        Yolo26ModelFootprint footprint;
+        uint32_t build_us;
+    };
+
+    Yolo26ModelRegistryConfig config;
+    Entry entries[YOLO_MODEL_MAX_ENTRIES];
+    int count = 0;
+    int active = -1;
+    Yolo26SwitchStats stats = {};
+
+    bool build(Entry& e) {
+        Yolo26HeapWatermark before = Yolo26HeapWatermark::capture();
+        int64_t t0 = esp_timer_get_time();
+        e.model = new dl::Model(e.address, e.location, config.max_internal_size, dl::MEMORY_MANAGER_GREEDY,
+                                nullptr, config.param_copy);
+        e.build_us = (uint32_t)(esp_timer_get_time() - t0);
+        Yolo26HeapWatermark after = Yolo26HeapWatermark::capture();
+        e.footprint = {(long)before.internal_free - (long)after.internal_free, (long)before.psram_free - (long)after.psram_free};
+        if (e.model->get_inputs().empty()) {
+            printf("[Yolo26ModelRegistry] Error: Model '%s' failed to load\n", e.tag);
+            delete e.model;
+            e.model = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+public:
+    Yolo26ModelRegistry(const Yolo26ModelRegistryConfig& cfg = Yolo26ModelRegistryConfig()) : config(cfg) {}
+
+    ~Yolo26ModelRegistry() { release(); }
+
+    Yolo26ModelRegistry(const Yolo26ModelRegistry&) = delete;
+    Yolo26ModelRegistry& operator=(const Yolo26ModelRegistry&) = delete;
+
+    /**
+     * @brief Registers a model. Nothing is built until select().
+     * @return Index for select(), -1 if the registry is full
+     */
+    int add(const char* tag, const char* address, fbs::model_location_type_t location = fbs::MODEL_LOCATION_IN_FLASH_RODATA) {
+        if (count == YOLO_MODEL_MAX_ENTRIES) {
+            printf("[Yolo26ModelRegistry] Error: More than %d models\n", YOLO_MODEL_MAX_ENTRIES);
+            return -1;
+        }
+        entries[count] = {tag, address, location, nullptr, {0, 0}, 0};
+        return count++;
+    }
+
+    int find(const char* tag) const {
+        for (int i = 0; i < count; i++) {
+            if (strcmp(entries[i].tag, tag) == 0) return i;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Makes model `index` active, building it if needed. The switch time goes into get_switch_stats().
+     * Under SHARED the previous model is deleted first: dl::Model pointers from get() are invalidated.
+     * @return false if the model failed to build (no model is active then under SHARED)
+     */
+    bool select(int index) {
+        if (index < 0 || index >= count) return false;
+        if (index == active) return true;
+
+        int64_t t0 = esp_timer_get_time();
+        if (config.policy == YOLO_MODEL_SHARED && active >= 0) {
+            delete entries[active].model;
+            entries[active].model = nullptr;
+        }
+        active = -1;
+        Entry& e = entries[index];
+        if (!e.model && !build(e)) return false;
+        active = index;
+
+        uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+        stats.count++;
+        stats.last_us = us;
+        stats.max_us = us > stats.max_us ? us : stats.max_us;
+        stats.total_us += us;
+        return true;
+    }
+
+    /**
+     * @brief Deletes every built model.
+     */
+    void release() {
+        for (int i = 0; i < count; i++) {
+            delete entries[i].model;
+            entries[i].model = nullptr;
+        }
+        active = -1;
+    }
+
+    dl::Model* get() const { return active >= 0 ? entries[active].model : nullptr; }
+    int get_active() const { return active; }
+    int get_count() const { return count; }
+    const char* get_tag(int index) const { return entries[index].tag; }
+
+    /**
+     * @brief Model input width, or 0 if the model has not been built yet.
+     */
+    int get_input_size(int index) const {
+        dl::Model* m = entries[index].model;
+        return m ? m->get_inputs().begin()->second->shape[2] : 0;
+    }
+
+    Yolo26ModelFootprint get_footprint(int index) const { return entries[index].footprint; }
+    uint32_t get_build_us(int index) const { return entries[index].build_us; }
+    Yolo26SwitchStats get_switch_stats() const { return stats; }
+
+    void print_summary() const {
+        printf("Models (%s):\n", config.policy == YOLO_MODEL_SHARED ? "shared" : "resident");
+        for (int i = 0; i < count; i++) {
+            const Entry& e = entries[i];
+            printf("  %-12s %s | build %7.1f ms | internal %6ld B | psram %8ld B\n", e.tag,
+                   i == active ? "active" : (e.model ? "built " : "      "), e.build_us / 1000.0f,
+                   e.footprint.internal_bytes, e.footprint.psram_bytes);
+        }
+        if (stats.count > 0) {
+            printf("  switches: %lu | last %.1f ms | mean %.1f ms | max %.1f ms\n", (unsigned long)stats.count,
+                   stats.last_us / 1000.0f, stats.total_us / 1000.0f / stats.count, stats.max_us / 1000.0f);
+        }
+    }
+};
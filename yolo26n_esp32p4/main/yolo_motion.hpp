@@ -0,0 +1,120 @@
+#pragma once
+#include "dl_image_define.hpp"
+#include "yolo_transform.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+// Cheap change detection on a downsampled luma grid.
+//
+// A signature is YOLO_MOTION_GRID x YOLO_MOTION_GRID luma samples taken at cell centres of a
+// region. Comparing two signatures (mean absolute difference) costs 256 byte ops regardless of
+// resolution, so it can gate a ~1.8 s inference for a few microseconds.
+
+#define YOLO_MOTION_GRID 16 // Samples per axis
+#define YOLO_MOTION_THRESH 4            // Mean abs luma difference (0..255) that counts as a change
+#define YOLO_MOTION_MAX_STALE_MS 5000   // Run inference at least this often even on a static scene
+
+struct Yolo26LumaSignature {
+    uint8_t luma[YOLO_MOTION_GRID * YOLO_MOTION_GRID];
+    bool valid = false;
+};
+
+/**
+ * @brief BT.601 luma of one RGB888 pixel, integer weights summing to 256.
+ */
+inline uint8_t yolo26_luma(const uint8_t* px) {
+    return (uint8_t)((px[0] * 77 + px[1] * 150 + px[2] * 29) >> 8);
+}
+
+/**
+ * @brief Samples the signature of `region` of an RGB888 frame.
+ */
+inline void yolo26_luma_signature(const dl::image::img_t& img, const Yolo26Rect& region, Yolo26LumaSignature& sig) {
+    const uint8_t* px = (const uint8_t*)img.data;
+    for (int gy = 0; gy < YOLO_MOTION_GRID; gy++) {
+        int y = region.y + (2 * gy + 1) * region.h / (2 * YOLO_MOTION_GRID);
+        const uint8_t* row = px + (size_t)y * img.width * 3;
+        for (int gx = 0; gx < YOLO_MOTION_GRID; gx++) {
+            int x = region.x + (2 * gx + 1) * region.w / (2 * YOLO_MOTION_GRID);
+            sig.luma[gy * YOLO_MOTION_GRID + gx] = yolo26_luma(row + x * 3);
+        }
+    }
+    sig.valid = true;
+}
+
+/**
+ * @brief Incremental yolo26_luma_signature() over a whole frame for strip decoders.
+ * Samples the grid rows falling in frame rows [y0, y1); `rows` points at row y0 (RGB888).
+ * The caller clears `sig.valid` before the first strip and sets it once all strips are seen.
+ */
+inline void yolo26_luma_signature_strip(const uint8_t* rows, int y0, int y1, int frame_w, int frame_h, Yolo26LumaSignature& sig) {
+    for (int gy = 0; gy < YOLO_MOTION_GRID; gy++) {
+        int y = (2 * gy + 1) * frame_h / (2 * YOLO_MOTION_GRID);
+        if (y < y0 || y >= y1) continue;
+        const uint8_t* row = rows + (size_t)(y - y0) * frame_w * 3;
+        for (int gx = 0; gx < YOLO_MOTION_GRID; gx++) {
+            int x = (2 * gx + 1) * frame_w / (2 * YOLO_MOTION_GRID);
+            sig.luma[gy * YOLO_MOTION_GRID + gx] = yolo26_luma(row + x * 3);
+        }
+    }
+}
+
+/**
+ * @brief Mean absolute luma difference (0..255). An invalid signature counts as full change.
+ */
+inline int yolo26_signature_diff(const Yolo26LumaSignature& a, const Yolo26LumaSignature& b) {
+    if (!a.valid || !b.valid) return 255;
+    int sad = 0;
+    for (int i = 0; i < YOLO_MOTION_GRID * YOLO_MOTION_GRID; i++) {
+        sad += std::abs((int)a.luma[i] - (int)b.luma[i]);
+    }
+    return sad / (YOLO_MOTION_GRID * YOLO_MOTION_GRID);
+}
+
+struct Yolo26MotionGateConfig {
+    int thresh = YOLO_MOTION_THRESH;               // Sensitivity: lower runs inference on smaller changes
+    int max_stale_ms = YOLO_MOTION_MAX_STALE_MS;   // 0 = never force a run
+};
+
+/**
+ * @brief Decides per frame whether inference is worth running.
+ *
+ * The reference is the signature of the last frame that was let through, so slow drift
+ * accumulates until it crosses the threshold. Timestamps come from the caller (esp_timer_get_time()).
+ */
+class Yolo26MotionGate {
+private:
+    Yolo26MotionGateConfig config;
+    Yolo26LumaSignature ref;
+    int64_t last_run_us = 0;
+    int last_diff = 0;
+    std::atomic<uint32_t> evaluated{0}; // Written by the gating task, read by stats from any task
+    std::atomic<uint32_t> skipped{0};
+
+public:
+    Yolo26MotionGate(const Yolo26MotionGateConfig& cfg = Yolo26MotionGateConfig()) : config(cfg) {}
+
+    /**
+     * @brief True if the frame with signature `cur` should be inferred; it then becomes the reference.
+     * An invalid `cur` (signature not computed) always runs.
+     */
+    bool update(const Yolo26LumaSignature& cur, int64_t now_us) {
+        evaluated++;
+        last_diff = yolo26_signature_diff(cur, ref);
+        bool stale = config.max_stale_ms > 0 && now_us - last_run_us >= (int64_t)config.max_stale_ms * 1000;
+        if (!cur.valid || !ref.valid || stale || last_diff >= config.thresh) {
+            ref = cur;
+            last_run_us = now_us;
+            return true;
+        }
+        skipped++;
+        return false;
+    }
+
+    void reset() { ref.valid = false; }
+
+    int get_last_diff() const { return last_diff; }
+    uint32_t get_evaluated() const { return evaluated; }
+    uint32_t get_skipped() const { return skipped; }
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdio>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#else
+#include <semaphore>
+#include <thread>
+#endif
+
+// Two-way work splitting for the frame loop: one worker task pinned to the other HP core,
+// created once and woken per job, so a split costs two task notifications instead of a task.
+// The host build uses a std::thread and semaphores with the same contract, so split results
+// can be tested.
+
+// Default Executor Configuration
+#define YOLO_EXECUTOR_STACK_SIZE 4096
+#define YOLO_EXECUTOR_PRIORITY 5
+#define YOLO_EXECUTOR_CORE 1      // The frame loop usually runs on core 0
+#define YOLO_EXECUTOR_PARTS 2
+
+/**
+ * @brief Work for one part of a split job. part 0 runs on the calling task, part 1 on the worker.
+ */
+typedef void (*Yolo26WorkFn)(void* ctx, int part);
+
+struct Yolo26ExecutorConfig {
+    uint32_t stack_size = YOLO_EXECUTOR_STACK_SIZE;
+    int priority = YOLO_EXECUTOR_PRIORITY;
+    int core = YOLO_EXECUTOR_CORE;
+};
+
+/**
+ * @brief Runs fn(ctx, 0) on the caller and fn(ctx, 1) on a pinned worker, and returns when both are done.
+ *
+ * One job at a time: run() is called from a single task (the one owning the processor). Until
+ * start() succeeds, or after stop(), run() executes both parts on the caller. On ESP-IDF the
+ * completion is signalled with a notification to the calling task, so that task must not
+ * wait on its own notification value elsewhere while run() is in progress.
+ */
+class Yolo26Executor {
+private:
+    Yolo26ExecutorConfig config;
+    Yolo26WorkFn job_fn = nullptr;
+    void* job_ctx = nullptr;
+    bool running = false;
+
+#ifdef ESP_PLATFORM
+    TaskHandle_t worker = nullptr;
+    TaskHandle_t caller = nullptr;
+    SemaphoreHandle_t exit_sem = nullptr;
+
+    static void task_entry(void* arg) {
+        auto* self = static_cast<Yolo26Executor*>(arg);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            if (!self->job_fn) break; // stop()
+            self->job_fn(self->job_ctx, 1);
+            xTaskNotifyGive(self->caller);
+        }
+        xSemaphoreGive(self->exit_sem);
+        vTaskDelete(nullptr);
+    }
+#else
+    std::thread worker;
+    std::binary_semaphore wake{0}; // Stands in for the worker's task notification
+    std::binary_semaphore done{0}; // ... and the caller's
+
+    void worker_loop() {
+        for (;;) {
+            wake.acquire();
+            if (!job_fn) break;
+            job_fn(job_ctx, 1);
+            done.release();
+        }
+    }
+#endif
+
+public:
+    Yolo26Executor(const Yolo26ExecutorConfig& cfg = Yolo26ExecutorConfig()) : config(cfg) {}
+
+    ~Yolo26Executor() { stop(); }
+
+    Yolo26Executor(const Yolo26Executor&) = delete;
+    Yolo26Executor& operator=(const Yolo26Executor&) = delete;
+
+    bool start() {
+        if (running) return true;
+#ifdef ESP_PLATFORM
+        exit_sem = xSemaphoreCreateBinary();
+        if (!exit_sem) return false;
+        if (xTaskCreatePinnedToCore(task_entry, "yolo_exec", config.stack_size, this, config.priority, &worker, config.core) != pdPASS) {
+            printf("[Yolo26Executor] Error: Failed to create worker task\n");
+            vSemaphoreDelete(exit_sem);
+            exit_sem = nullptr;
+            worker = nullptr;
+            return false;
+        }
+#else
+        worker = std::thread([this] { worker_loop(); });
+#endif
+        running = true;
+        return true;
+    }
+
+    void stop() {
+        if (!running) return;
+        job_fn = nullptr;
+#ifdef ESP_PLATFORM
+        xTaskNotifyGive(worker);
+        xSemaphoreTake(exit_sem, portMAX_DELAY);
+        vSemaphoreDelete(exit_sem);
+        exit_sem = nullptr;
+        worker = nullptr;
+#else
+        wake.release();
+        worker.join();
+#endif
+        running = false;
+    }
+
+    bool is_running() const { return running; }
+
+    void run(Yolo26WorkFn fn, void* ctx) {
+        if (!running) {
+            fn(ctx, 0);
+            fn(ctx, 1);
+            return;
+        }
+        job_ctx = ctx;
+        job_fn = fn;
+#ifdef ESP_PLATFORM
+        caller = xTaskGetCurrentTaskHandle();
+        xTaskNotifyGive(worker);
+        fn(ctx, 0);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#else
+        wake.release();
+        fn(ctx, 0);
+        done.acquire();
+#endif
+    }
+};
@@ -0,0 +1,515 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "dl_model_base.hpp"
+#include "yolo_processor.hpp"
+#include "yolo_dump.hpp"
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+// Default Pipeline Configuration
+#define YOLO_PIPELINE_QUEUE_DEPTH 2      // Frames buffered between decode and preprocess
+#define YOLO_PIPELINE_INPUT_BUFFERS 2    // Double-buffered input tensors
+#define YOLO_PIPELINE_STACK_SIZE 8192
+#define YOLO_PIPELINE_POLL_MS 100        // Queue timeout used to observe stop()
+
+static_assert(YOLO_PIPELINE_INPUT_BUFFERS <= YOLO_BOUND_INPUTS, "Every input buffer must stay bound in the processor");
+
+/**
+ * @brief A compressed frame handed to the pipeline by the capture callback.
+ * `user_handle` is passed back untouched to the release callback (e.g. a camera frame buffer).
+ */
+struct Yolo26CapturedFrame {
+    const uint8_t* jpg_data;
+    size_t jpg_len;
+    void* user_handle;
+};
+
+/**
+ * @brief Result published by the postprocess stage. `detections` is only valid during the callback.
+ */
+struct Yolo26PipelineResult {
+    uint32_t frame_id;
+    int64_t capture_us;   // esp_timer timestamp when the frame was captured
+    int64_t latency_us;   // capture -> publish
+    const std::vector<Detection>* detections; // Source frame pixels (processor resize mode applies)
+    bool cached;          // Motion gate skipped inference: detections are the last inferred frame's
+};
+
+typedef bool (*Yolo26CaptureFn)(Yolo26CapturedFrame* frame, void* user_ctx);
+typedef void (*Yolo26ReleaseFn)(const Yolo26CapturedFrame& frame, void* user_ctx);
+typedef void (*Yolo26PublishFn)(const Yolo26PipelineResult& result, void* user_ctx);
+
+struct Yolo26PipelineConfig {
+    Yolo26CaptureFn capture = nullptr;  // Required. Return false when no frame is available.
+    Yolo26ReleaseFn release = nullptr;  // Optional. Called once the JPEG has been decoded or dropped.
+    Yolo26PublishFn publish = nullptr;  // Optional. Called from the postprocess task.
+    void* user_ctx = nullptr;
+
+    int queue_depth = YOLO_PIPELINE_QUEUE_DEPTH;
+    // Decode, resize and quantize in one pass (decode_preprocess_jpeg()) in the preprocess stage.
+    // The JPEG is then held until preprocess finishes and no RGB888 frame is allocated.
+    bool fused_preprocess = true;
+    // Skip inference on frames that barely differ from the last inferred one and re-publish its
+    // detections instead. The luma signature is sampled during decode.
+    bool motion_gate = false;
+    Yolo26MotionGateConfig motion;
+    // Optional, initialized by the caller. Raw outputs of every inferred frame are queued to it
+    // right after model->run(), before the input buffer is recycled.
+    Yolo26TensorDump* dump = nullptr;
+    uint32_t stack_size = YOLO_PIPELINE_STACK_SIZE;
+
+    // Inference owns core 1; the cheap stages share core 0 so they overlap model->run().
+    BaseType_t decode_core = 0;
+    BaseType_t preprocess_core = 0;
+    BaseType_t inference_core = 1;
+    BaseType_t postprocess_core = 0;
+
+    UBaseType_t decode_priority = 5;
+    UBaseType_t preprocess_priority = 6;
+    UBaseType_t inference_priority = 7;
+    UBaseType_t postprocess_priority = 8;
+};
+
+struct Yolo26StageStats {
+    uint32_t processed;
+    uint32_t dropped;
+    uint32_t queue_depth;  // Messages currently waiting at the stage input
+    uint32_t queue_peak;
+    int64_t busy_us;       // Accumulated time spent doing work
+};
+
+struct Yolo26PipelineStats {
+    Yolo26StageStats decode;
+    Yolo26StageStats preprocess;
+    Yolo26StageStats inference;
+    Yolo26StageStats postprocess;
+    float fps;             // Published frames per second since start()
+    uint32_t motion_skipped; // Frames published from cache by the motion gate
+};
+
+/**
+ * @brief Four-stage streaming pipeline: capture/decode -> preprocess -> inference -> postprocess/publish.
+ *
+ * Stages are FreeRTOS tasks joined by bounded queues. In the default fused mode the
+ * preprocess stage decodes the JPEG straight into the input tensor (decode_preprocess_jpeg());
+ * otherwise decode/resize run in the decode stage. Preprocess writes into one of
+ * YOLO_PIPELINE_INPUT_BUFFERS private input tensors, so frame N+1 is decoded and quantized
+ * while frame N is inside model->run(). When the decode queue is full the newest captured
+ * frame is dropped (and counted) instead of stalling the camera.
+ *
+ * The model outputs are single-buffered: inference waits until postprocess has consumed
+ * them. Postprocess is ~10 ms against ~1.8 s of inference, so this costs nothing in throughput.
+ *
+ * With motion_gate set, preprocess compares each frame's luma signature against the last
+ * inferred frame (Yolo26MotionGate). Frames below the threshold skip inference and are
+ * published with the previous detections (`cached`), until max_stale_ms forces a fresh run.
+ *
+ * The processor is shared by the stages without locks. Stop the pipeline before binding it
+ * to a model of another input size (its grid sizes are read by postprocess).
+ */
+template <typename Processor>
+class Yolo26PipelineT {
+private:
+    // --- Queue Messages ---
+    struct DecodedMsg {
+        Yolo26CapturedFrame frame; // Fused mode: JPEG still owned, released by preprocess
+        dl::image::img_t img;      // Owned, freed by preprocess (unused in fused mode)
+        dl::image::img_t resized;  // Owned if resized.data != img.data
+        Yolo26Transform xf;        // Frame -> model mapping (non-fused mode)
+        Yolo26LumaSignature motion; // Non-fused mode, when the motion gate is enabled
+        uint32_t frame_id;
+        int64_t capture_us;
+    };
+
+    struct TensorMsg {
+        int buffer_idx;            // -1: gated out, publish the cached result
+        uint32_t frame_id;
+        int64_t capture_us;
+        Yolo26Transform xf;        // Carried to postprocess for back-mapping
+    };
+
+    struct StageCounters {
+        std::atomic<uint32_t> processed{0};
+        std::atomic<uint32_t> dropped{0};
+        std::atomic<uint32_t> queue_peak{0};
+        std::atomic<int64_t> busy_us{0};
+    };
+
+    enum { STAGE_DECODE = 0, STAGE_PREPROCESS, STAGE_INFERENCE, STAGE_POSTPROCESS, STAGE_COUNT };
+
+    // --- State ---
+    dl::Model* model;
+    Processor& processor;
+    Yolo26PipelineConfig config;
+
+    std::vector<dl::TensorBase*> input_buffers;
+    std::vector<std::map<std::string, dl::TensorBase*>> input_maps; // Built once, reused per frame
+
+    QueueHandle_t decode_q = nullptr;  // DecodedMsg: decode -> preprocess
+    QueueHandle_t free_q = nullptr;    // int: free input buffer indices
+    QueueHandle_t infer_q = nullptr;   // TensorMsg: preprocess -> inference
+    QueueHandle_t post_q = nullptr;    // TensorMsg: inference -> postprocess
+    SemaphoreHandle_t outputs_free = nullptr; // Given when model outputs may be overwritten
+    SemaphoreHandle_t exit_sem = nullptr;     // Given once by each task on exit
+
+    StageCounters counters[STAGE_COUNT];
+    Yolo26MotionGate gate;
+    std::vector<Detection> last_results;  // Postprocess task only
+    std::atomic<bool> running{false};
+    uint32_t next_frame_id = 0;
+    int64_t start_us = 0;
+
+    // --- Helpers ---
+    void free_decoded(DecodedMsg& msg) {
+        if (msg.frame.jpg_data) {
+            release_frame(msg.frame);
+            msg.frame.jpg_data = nullptr;
+        }
+        if (msg.resized.data && msg.resized.data != msg.img.data) {
+            heap_caps_free(msg.resized.data);
+        }
+        if (msg.img.data) {
+            heap_caps_free(msg.img.data);
+        }
+    }
+
+    void note_depth(int stage, QueueHandle_t q) {
+        uint32_t depth = uxQueueMessagesWaiting(q);
+        uint32_t peak = counters[stage].queue_peak.load();
+        while (depth > peak && !counters[stage].queue_peak.compare_exchange_weak(peak, depth)) {
+        }
+    }
+
+    void release_frame(const Yolo26CapturedFrame& frame) {
+        if (config.release) config.release(frame, config.user_ctx);
+    }
+
+    // Gated frames travel without a buffer or output credit, so infer_q / post_q can be full.
+    // Waits in YOLO_PIPELINE_POLL_MS steps like the receives; false once stop() is called.
+    bool send_while_running(QueueHandle_t q, const void* item) {
+        while (running) {
+            if (xQueueSend(q, item, pdMS_TO_TICKS(YOLO_PIPELINE_POLL_MS)) == pdTRUE) return true;
+        }
+        return false;
+    }
+
+    // --- Stage Bodies ---
+    void decode_loop() {
+        while (running) {
+            Yolo26CapturedFrame frame = {};
+            if (!config.capture(&frame, config.user_ctx)) {
+                vTaskDelay(1);
+                continue;
+            }
+            int64_t capture_us = esp_timer_get_time();
+            uint32_t frame_id = next_frame_id++;
+
+            // Drop before spending cycles on decode if preprocess is still behind.
+            if (uxQueueSpacesAvailable(decode_q) == 0) {
+                release_frame(frame);
+                counters[STAGE_DECODE].dropped++;
+                continue;
+            }
+
+            DecodedMsg msg = {};
+            msg.frame_id = frame_id;
+            msg.capture_us = capture_us;
+            if (config.fused_preprocess) {
+                // Decoding happens later, straight into the input tensor.
+                msg.frame = frame;
+                if (xQueueSend(decode_q, &msg, 0) != pdTRUE) {
+                    free_decoded(msg);
+                    counters[STAGE_DECODE].dropped++;
+                    continue;
+                }
+                counters[STAGE_DECODE].processed++;
+                note_depth(STAGE_PREPROCESS, decode_q);
+                continue;
+            }
+
+            int64_t t0 = esp_timer_get_time();
+            msg.img = processor.decode_jpeg(frame.jpg_data, frame.jpg_len);
+            release_frame(frame);
+            if (!msg.img.data) {
+                counters[STAGE_DECODE].dropped++;
+                continue;
+            }
+            if (config.motion_gate) {
+                yolo26_luma_signature(msg.img, {0, 0, msg.img.width, msg.img.height}, msg.motion);
+            }
+            msg.resized = processor.resize(msg.img, model->get_inputs(), &msg.xf);
+            counters[STAGE_DECODE].busy_us += esp_timer_get_time() - t0;
+            if (!msg.resized.data) {
+                free_decoded(msg);
+                counters[STAGE_DECODE].dropped++;
+                continue;
+            }
+
+            if (xQueueSend(decode_q, &msg, 0) != pdTRUE) {
+                free_decoded(msg);
+                counters[STAGE_DECODE].dropped++;
+                continue;
+            }
+            counters[STAGE_DECODE].processed++;
+            note_depth(STAGE_PREPROCESS, decode_q);
+        }
+    }
+
+    void preprocess_loop() {
+        while (running) {
+            DecodedMsg msg;
+            if (xQueueReceive(decode_q, &msg, pdMS_TO_TICKS(YOLO_PIPELINE_POLL_MS)) != pdTRUE) continue;
+
+            // Wait for an input buffer; inference hands one back right after copying it in.
+            int idx = -1;
+            while (running && xQueueReceive(free_q, &idx, pdMS_TO_TICKS(YOLO_PIPELINE_POLL_MS)) != pdTRUE) {
+            }
+            if (idx < 0) {
+                free_decoded(msg);
+                break;
+            }
+
+            int64_t t0 = esp_timer_get_time();
+            bool ok = true;
+            bool run = true;
+            if (msg.frame.jpg_data) {
+                Yolo26LumaSignature* motion = config.motion_gate ? &msg.motion : nullptr;
+                ok = processor.decode_preprocess_jpeg(msg.frame.jpg_data, msg.frame.jpg_len, input_maps[idx], &msg.xf, motion);
+            } else if (config.motion_gate && !gate.update(msg.motion, esp_timer_get_time())) {
+                run = false; // Static scene: skip the quantize as well
+            } else {
+                processor.preprocess(msg.resized, input_maps[idx]);
+            }
+            if (ok && run && msg.frame.jpg_data && config.motion_gate) {
+                run = gate.update(msg.motion, esp_timer_get_time());
+            }
+            free_decoded(msg);
+            counters[STAGE_PREPROCESS].busy_us += esp_timer_get_time() - t0;
+            if (!ok) {
+                xQueueSend(free_q, &idx, 0);
+                counters[STAGE_PREPROCESS].dropped++;
+                continue;
+            }
+            if (!run) {
+                xQueueSend(free_q, &idx, 0);
+                idx = -1;
+            }
+
+            // Gated frames travel through the inference queue too, so publish order is preserved.
+            TensorMsg out = {idx, msg.frame_id, msg.capture_us, msg.xf};
+            if (!send_while_running(infer_q, &out)) {
+                if (idx >= 0) xQueueSend(free_q, &idx, 0);
+                break;
+            }
+            counters[STAGE_PREPROCESS].processed++;
+            note_depth(STAGE_INFERENCE, infer_q);
+        }
+    }
+
+    void inference_loop() {
+        while (running) {
+            TensorMsg msg;
+            if (xQueueReceive(infer_q, &msg, pdMS_TO_TICKS(YOLO_PIPELINE_POLL_MS)) != pdTRUE) continue;
+            if (msg.buffer_idx < 0) {
+                if (!send_while_running(post_q, &msg)) break;
+                continue;
+            }
+
+            // Outputs still being decoded by postprocess must not be overwritten.
+            while (running && xSemaphoreTake(outputs_free, pdMS_TO_TICKS(YOLO_PIPELINE_POLL_MS)) != pdTRUE) {
+            }
+            if (!running) {
+                xQueueSend(free_q, &msg.buffer_idx, 0);
+                break;
+            }
+
+            int64_t t0 = esp_timer_get_time();
+            model->run(input_buffers[msg.buffer_idx]); // Copies into the model input tensor
+            counters[STAGE_INFERENCE].busy_us += esp_timer_get_time() - t0;
+            if (config.dump) config.dump->submit(model->get_outputs(), &input_maps[msg.buffer_idx]);
+
+            xQueueSend(free_q, &msg.buffer_idx, 0); // Holds every index, never full
+            if (!send_while_running(post_q, &msg)) break; // stop() hands the output credit back
+            counters[STAGE_INFERENCE].processed++;
+            note_depth(STAGE_POSTPROCESS, post_q);
+        }
+    }
+
+    void postprocess_loop() {
+        while (running) {
+            TensorMsg msg;
+            if (xQueueReceive(post_q, &msg, pdMS_TO_TICKS(YOLO_PIPELINE_POLL_MS)) != pdTRUE) continue;
+
+            bool cached = msg.buffer_idx < 0;
+            int64_t t0 = esp_timer_get_time();
+            if (!cached) {
+                last_results = processor.postprocess(model->get_outputs(), &msg.xf);
+                xSemaphoreGive(outputs_free);
+            }
+            int64_t t1 = esp_timer_get_time();
+            counters[STAGE_POSTPROCESS].busy_us += t1 - t0;
+
+            if (config.publish) {
+                Yolo26PipelineResult result = {msg.frame_id, msg.capture_us, t1 - msg.capture_us, &last_results, cached};
+                config.publish(result, config.user_ctx);
+            }
+            counters[STAGE_POSTPROCESS].processed++;
+        }
+    }
+
+    template <void (Yolo26PipelineT::*Loop)()>
+    static void task_entry(void* arg) {
+        Yolo26PipelineT* self = static_cast<Yolo26PipelineT*>(arg);
+        (self->*Loop)();
+        xSemaphoreGive(self->exit_sem);
+        vTaskDelete(nullptr);
+    }
+
+    void drain_queues() {
+        DecodedMsg decoded;
+        while (decode_q && xQueueReceive(decode_q, &decoded, 0) == pdTRUE) free_decoded(decoded);
+        TensorMsg msg;
+        while (infer_q && xQueueReceive(infer_q, &msg, 0) == pdTRUE) {
+            if (msg.buffer_idx >= 0) xQueueSend(free_q, &msg.buffer_idx, 0);
+        }
+        while (post_q && xQueueReceive(post_q, &msg, 0) == pdTRUE) {
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor. Allocates queues and double-buffered input tensors mirroring the model input.
+     *
+     * @param m Loaded model (not owned)
+     * @param proc Processor used by every stage (not owned)
+     * @param cfg Callbacks, queue depth and core/priority placement
+     */
+    Yolo26PipelineT(dl::Model* m, Processor& proc, const Yolo26PipelineConfig& cfg)
+        : model(m), processor(proc), config(cfg), gate(cfg.motion) {
+        auto& inputs = model->get_inputs();
+        assert(!inputs.empty());
+        const std::string& input_name = inputs.begin()->first;
+        dl::TensorBase* model_input = inputs.begin()->second;
+
+        for (int i = 0; i < YOLO_PIPELINE_INPUT_BUFFERS; i++) {
+            dl::TensorBase* buf = new dl::TensorBase(model_input->shape, nullptr, model_input->exponent,
+                                                     model_input->dtype, true, MALLOC_CAP_SPIRAM);
+            input_buffers.push_back(buf);
+            input_maps.push_back({{input_name, buf}});
+        }
+
+        decode_q = xQueueCreate(config.queue_depth, sizeof(DecodedMsg));
+        free_q = xQueueCreate(YOLO_PIPELINE_INPUT_BUFFERS, sizeof(int));
+        infer_q = xQueueCreate(YOLO_PIPELINE_INPUT_BUFFERS, sizeof(TensorMsg));
+        post_q = xQueueCreate(1, sizeof(TensorMsg));
+        outputs_free = xSemaphoreCreateBinary();
+        exit_sem = xSemaphoreCreateCounting(STAGE_COUNT, 0);
+
+        for (int i = 0; i < YOLO_PIPELINE_INPUT_BUFFERS; i++) {
+            xQueueSend(free_q, &i, 0);
+        }
+        xSemaphoreGive(outputs_free);
+    }
+
+    ~Yolo26PipelineT() {
+        stop();
+        vQueueDelete(decode_q);
+        vQueueDelete(free_q);
+        vQueueDelete(infer_q);
+        vQueueDelete(post_q);
+        vSemaphoreDelete(outputs_free);
+        vSemaphoreDelete(exit_sem);
+        for (auto* buf : input_buffers) delete buf;
+    }
+
+    /**
+     * @brief Spawns the four pinned stage tasks.
+     * @return true if all tasks were created
+     */
+    bool start() {
+        if (running || !config.capture) return false;
+        running = true;
+        start_us = esp_timer_get_time();
+
+        struct TaskSpec {
+            TaskFunction_t fn; const char* name; UBaseType_t prio; BaseType_t core;
+        } specs[STAGE_COUNT] = {
+            {&task_entry<&Yolo26PipelineT::decode_loop>, "yolo_decode", config.decode_priority, config.decode_core},
+            {&task_entry<&Yolo26PipelineT::preprocess_loop>, "yolo_pre", config.preprocess_priority, config.preprocess_core},
+            {&task_entry<&Yolo26PipelineT::inference_loop>, "yolo_infer", config.inference_priority, config.inference_core},
+            {&task_entry<&Yolo26PipelineT::postprocess_loop>, "yolo_post", config.postprocess_priority, config.postprocess_core},
+        };
+
+        int created = 0;
+        for (auto& s : specs) {
+            if (xTaskCreatePinnedToCore(s.fn, s.name, config.stack_size, this, s.prio, nullptr, s.core) != pdPASS) {
+                printf("[Yolo26Pipeline] Error: Failed to create task %s\n", s.name);
+                break;
+            }
+            created++;
+        }
+        if (created != STAGE_COUNT) {
+            running = false;
+            for (int i = 0; i < created; i++) xSemaphoreTake(exit_sem, portMAX_DELAY);
+            drain_queues();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Signals every stage to exit and waits for them. Frames in flight are discarded.
+     */
+    void stop() {
+        if (!running) return;
+        running = false;
+        for (int i = 0; i < STAGE_COUNT; i++) xSemaphoreTake(exit_sem, portMAX_DELAY);
+        drain_queues();
+        // Restore the initial "outputs free" state so the pipeline can be restarted.
+        xSemaphoreTake(outputs_free, 0);
+        xSemaphoreGive(outputs_free);
+    }
+
+    bool is_running() const { return running; }
+
+    /**
+     * @brief Snapshot of per-stage counters and current queue depths.
+     */
+    Yolo26PipelineStats get_stats() {
+        Yolo26PipelineStats stats = {};
+        Yolo26StageStats* out[STAGE_COUNT] = {&stats.decode, &stats.preprocess, &stats.inference, &stats.postprocess};
+        QueueHandle_t inq[STAGE_COUNT] = {nullptr, decode_q, infer_q, post_q};
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            out[i]->processed = counters[i].processed;
+            out[i]->dropped = counters[i].dropped;
+            out[i]->queue_peak = counters[i].queue_peak;
+            out[i]->busy_us = counters[i].busy_us;
+            out[i]->queue_depth = inq[i] ? uxQueueMessagesWaiting(inq[i]) : 0;
+        }
+        int64_t elapsed = esp_timer_get_time() - start_us;
+        stats.fps = (start_us && elapsed > 0) ? stats.postprocess.processed * 1e6f / elapsed : 0.0f;
+        stats.motion_skipped = gate.get_skipped();
+        return stats;
+    }
+
+    void print_stats() {
+        Yolo26PipelineStats s = get_stats();
+        const char* names[STAGE_COUNT] = {"decode", "preprocess", "inference", "postprocess"};
+        Yolo26StageStats* st[STAGE_COUNT] = {&s.decode, &s.preprocess, &s.inference, &s.postprocess};
+        printf("Pipeline: %.3f fps | motion skipped %lu\n", s.fps, (unsigned long)s.motion_skipped);
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            uint32_t n = st[i]->processed;
+            printf("  %-11s done %5lu | dropped %4lu | queue %lu (peak %lu) | avg %lld us\n", names[i],
+                   (unsigned long)n, (unsigned long)st[i]->dropped, (unsigned long)st[i]->queue_depth,
+                   (unsigned long)st[i]->queue_peak, (long long)(n ? st[i]->busy_us / n : 0));
+        }
+    }
+};
+
+using Yolo26Pipeline = Yolo26PipelineT<Yolo26Processor<>>;
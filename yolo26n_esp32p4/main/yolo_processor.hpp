@@ -2,18 +2,39 @@
 #include "dl_image_process.hpp"
 #include "esp_heap_caps.h"
 #include "dl_image_jpeg.hpp"
+#include "esp_jpeg_dec.h"
 #include "dl_tensor_base.hpp"
 #include "coco_classes.hpp"
+#include "yolo_quant.hpp"
+#include "yolo_scan.hpp"
+#include "yolo_topk.hpp"
+#include "yolo_class_filter.hpp"
+#include "yolo_arena.hpp"
+#include "yolo_transform.hpp"
+#include "yolo_motion.hpp"
+#include "yolo_parallel.hpp"
+#include "yolo_accel.hpp"
+#include "yolo_color.hpp"
+#include "yolo_suppress.hpp"
+#include "yolo_memory.hpp"
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <cassert>
 #include <map>
 #include <string>
+#include <limits>
+#include <cstring>
+#include <type_traits>
+#include <atomic>
 
 // Default Configuration
 #define YOLO_TARGET_K 32
 #define YOLO_CONF_THRESH 0.10f
+#define YOLO_MAX_MCU_ROWS 16       // Tallest JPEG MCU row (4:2:0 subsampling)
+#define YOLO_MAX_INPUT_WIDTH 1024  // Sampling map capacity for dynamic-shape processors in arena mode
+#define YOLO_PLAN_MAX_OUTPUTS 8    // Output maps with more tensors are resolved on every postprocess()
+#define YOLO_BOUND_INPUTS 2        // Input tensors remembered by preprocess() (pipeline double buffering)
 
 struct Detection {
     float x1, y1, x2, y2;
@@ -21,26 +42,202 @@ struct Detection {
     int class_id;
 };
 
+// Compact detection for transport: corners in YOLO_DETQ_FRAC_BITS fixed point (1/4 px, so up to
+// +-8191 px), score in 1/255 steps, class id < 256. Produced exactly by the integer box decode.
+#define YOLO_DETQ_FRAC_BITS 2
+
+struct DetectionQ {
+    int16_t x1, y1, x2, y2;
+    uint8_t score;
+    uint8_t class_id;
+};
+static_assert(sizeof(DetectionQ) == 10, "DetectionQ must stay packed");
+
+inline int16_t yolo26_q_coord(float v) {
+    float q = std::floor(v * (1 << YOLO_DETQ_FRAC_BITS) + 0.5f);
+    return (int16_t)std::clamp(q, -32768.0f, 32767.0f);
+}
+
+inline uint8_t yolo26_q_score(float score) {
+    return (uint8_t)std::clamp((int)(score * 255.0f + 0.5f), 0, 255);
+}
+
+/**
+ * @brief Float detection -> DetectionQ (same rounding as the integer decode).
+ */
+inline DetectionQ yolo26_quantize_detection(const Detection& d) {
+    return {yolo26_q_coord(d.x1), yolo26_q_coord(d.y1), yolo26_q_coord(d.x2), yolo26_q_coord(d.y2),
+            yolo26_q_score(d.score), (uint8_t)d.class_id};
+}
+
+/**
+ * @brief DetectionQ -> float detection, e.g. on the receiving side of a link.
+ */
+inline Detection yolo26_dequantize_detection(const DetectionQ& q) {
+    const float inv = 1.0f / (1 << YOLO_DETQ_FRAC_BITS);
+    return {q.x1 * inv, q.y1 * inv, q.x2 * inv, q.y2 * inv, q.score / 255.0f, q.class_id};
+}
+
+// Confidence threshold in the raw integer domain of each stride layer (see postprocess())
+struct Yolo26LayerThresholds {
+    float conf;
+    float int_thresh[3];
+};
+
+/**
+ * @brief YOLO26 pre/post-processor, optionally specialized at compile time.
+ *
+ * Every template parameter left at its default (0 / void) is read from the model at runtime.
+ * Yolo26Processor<> is the runtime-dispatching facade: postprocess() routes the shipped 512/640
+ * int8/int16 80-class models to their compile-time specialized scan and falls back to the
+ * generic loops for anything else.
+ * Yolo26Processor<512, 512, int8_t, 80> fixes everything, so grid bounds, tensor offsets and
+ * the class loop are constants; preprocess() rejects a model that does not match.
+ *
+ * @tparam Width Model input width (0 = from model)
+ * @tparam Height Model input height (0 = from model)
+ * @tparam DType Raw output element type, int8_t or int16_t (void = from model)
+ * @tparam NumClasses Class count (0 = from model)
+ */
+template <int Width = 0, int Height = 0, typename DType = void, int NumClasses = 0>
 class Yolo26Processor {
+    static_assert((Width > 0) == (Height > 0), "Width and Height must both be fixed or both be 0");
+    static_assert(Width % 32 == 0 && Height % 32 == 0, "Input size must be a multiple of the largest stride (32)");
+    static_assert(std::is_void<DType>::value || std::is_same<DType, int8_t>::value || std::is_same<DType, int16_t>::value,
+                  "DType must be int8_t, int16_t or void");
+
+public:
+    static constexpr bool is_static_shape = Width > 0;
+    static constexpr bool is_static = Width > 0 && NumClasses > 0 && !std::is_void<DType>::value;
+
 private:
     // --- constants ---
-    const int num_classes = 80;
-    const int strides[3] = {8, 16, 32};
+    static constexpr int strides[3] = {8, 16, 32};
+    int num_classes = NumClasses > 0 ? NumClasses : 80; // Dynamic: read from the class tensor
     bool is_resized = false; // Track if we need to free a resized image
     
     // --- State (Calculated/Configured) ---
-    std::vector<int> grid_sizes; // Calculated in preprocess
+    // Grid sizes per stride layer. Static shape: fixed here; dynamic: calculated in preprocess.
+    int grid_h[3] = {Height / 8, Height / 16, Height / 32};
+    int grid_w[3] = {Width / 8, Width / 16, Width / 32};
     int target_k;
     float conf_thresh;
     const char** class_names;
+    Yolo26ResizeMode resize_mode = YOLO_RESIZE_STRETCH;
     
     // --- Optimization ---
     // Lookup Table for Quantization
     // Stores pre-calculated (pixel / 255.0 * 128) values for all 256 inputs.
-    // Located in internal SRAM (part of class instance on stack).
-    int8_t quantization_lut[256];
+    // Hot memory (yolo_memory.hpp): internal SRAM wherever the processor object itself lives.
+    Yolo26HotVector<int8_t> quantization_lut;
+
+    // --- Top-K Selection ---
+    // Candidates are packed keys (score, layer, cell; see yolo_topk.hpp), which rank like
+    // sigmoid() and map back to each layer's integer domain for early rejection. Both heaps
+    // share one buffer: int8 models use 32-bit keys, the rest 64-bit keys.
+    // The second half of the buffer holds the executor worker's partial heaps.
+    Yolo26HotVector<uint64_t> topk_storage; // Sized to 2 * target_k once, reused every frame
+    Yolo26TopK<uint32_t> topk32;
+    Yolo26TopK<uint64_t> topk64;
+    Yolo26TopK<uint32_t> worker_topk32;
+    Yolo26TopK<uint64_t> worker_topk64;
+
+    // Per-layer inputs of the scan, resolved once per postprocess() call or batch
+    struct LayerScan {
+        const void* raw_box;
+        const void* raw_cls;
+        float box_scale;
+        float cls_scale;
+        float inv_cls_scale;
+        float int_thresh; // Class threshold in the raw integer domain
+        int key_shift;    // Left shift from this layer's class exponent to the common one
+        int cls_exponent;
+        // Integer box decode: edge = anchor << q_anchor_shift +- raw << q_raw_shift, exact with
+        // q_round_shift extra fraction bits, then rounded to YOLO_DETQ_FRAC_BITS
+        int q_anchor_shift;
+        int q_raw_shift;
+        int q_round_shift;
+    };
+
+    // --- Decode Plan ---
+    // Everything postprocess() derives from the model outputs, resolved once and reused until
+    // the output map changes identity (tensor objects, buffers, exponents in key order) or bind()
+    // is called. The per-frame check walks the map nodes: no string compares, no pow() / log().
+    struct DecodePlan {
+        bool valid;
+        int num_outputs;
+        const dl::TensorBase* tensors[YOLO_PLAN_MAX_OUTPUTS];
+        const void* data[YOLO_PLAN_MAX_OUTPUTS];
+        int exponents[YOLO_PLAN_MAX_OUTPUTS];
+        LayerScan layers[3];
+        dl::dtype_t dtype;
+        Yolo26LayerThresholds th; // For conf_thresh; recomputed when it changes
+    };
+    DecodePlan plan = {};
+    bool batch_bound = false; // Between begin_batch() and end_batch()
+    float scan_conf = 0.0f;   // Confidence of the frame being decoded (conf_thresh or the stream's)
+
+    // Input tensors validated by bind_input(), one entry per buffer so double-buffered inputs
+    // both stay bound. Preprocess-side state: postprocess() only reads grid_h / grid_w, which
+    // change only when the input size does (never between the buffers of one model).
+    struct BoundInput {
+        const dl::TensorBase* tensor;
+        int exponent;
+        int h;
+        int w;
+    };
+    BoundInput bound_inputs[YOLO_BOUND_INPUTS] = {};
+    int next_bound = 0; // Entry replaced by the next new tensor
+
+    // Optional second core for the quantization loop and the scan (set_executor())
+    Yolo26Executor* executor = nullptr;
+
+    // Optional PPA / JPEG codec for decode_jpeg(), resize() and resize_into() (set_accel())
+    Yolo26Accel* accel = nullptr;
+
+    // Native camera format tables (~3 KB), built on the first RGB565 / YUV422 frame
+    Yolo26ColorLut* color_lut = nullptr;
+
+    // Per-class thresholds and allow-list (inactive until a rule is set)
+    Yolo26ClassFilter class_filter;
+
+    // Optional duplicate suppression of the top-K list (set_suppression()); storage sized to
+    // target_k at construction (K^2 / 8 bytes each)
+    std::atomic<bool> suppress_on{false};
+    std::atomic<uint32_t> suppress_iou{0};
+    Yolo26SuppressorT<Detection> suppressor;
+    Yolo26SuppressorT<DetectionQ> suppressor_q; // postprocess_into(DetectionQ*)
+
+    // Optional coarse-to-fine early exit (set_early_exit()). Per call: the scan stops after the
+    // layer (or, for query_presence(), the cell) where exit_hits candidates have passed.
+    std::atomic<int> early_exit_hits{0};
+    int exit_hits = 0;
+    bool exit_at_cell = false;
+    int scanned_cells = 0;
+
+    // --- Arena Mode ---
+    // Set by use_arena(): scratch buffers live in the arena and the decoders stay open.
+    Yolo26Arena* arena = nullptr;
+    uint8_t* strip_buf = nullptr;
+    size_t strip_buf_bytes = 0;
+    int* x_map_buf = nullptr;
+    int x_map_cap = 0;
+    jpeg_dec_handle_t block_decoder = nullptr;
+    jpeg_dec_handle_t frame_decoder = nullptr;
+
+    // Vectorized equivalent of the LUT, picked at construction by a bit-exact self-test.
+    Yolo26QuantizeFn quantize_fn = yolo26_quantize_lut;
+    Yolo26QuantKernel quant_kernel = YOLO_QUANT_KERNEL_LUT;
 
     // --- Helpers ---
+    // `storage` holds YOLO_EXECUTOR_PARTS * k entries
+    void reset_topk(uint64_t* storage, int k) {
+        topk32.reset(reinterpret_cast<uint32_t*>(storage), k);
+        topk64.reset(storage, k);
+        worker_topk32.reset(reinterpret_cast<uint32_t*>(storage + k), k);
+        worker_topk64.reset(storage + k, k);
+    }
+
     inline float sigmoid(float x) {
         return 1.0f / (1.0f + std::exp(-x));
     }
@@ -50,6 +247,254 @@ private:
         return val * scale;
     }
 
+    /**
+     * @brief Validates the input tensor against the LUT optimization and this specialization,
+     * then stores the grid sizes.
+     */
+    bool bind_input(dl::TensorBase* input_tensor) {
+        BoundInput* entry = nullptr;
+        for (BoundInput& b : bound_inputs) {
+            if (b.tensor == input_tensor) {
+                if (b.exponent == input_tensor->exponent && b.h == input_tensor->shape[1] && b.w == input_tensor->shape[2]) {
+                    return true;
+                }
+                entry = &b; // Same buffer, changed metadata: re-validate in place
+                break;
+            }
+            if (!b.tensor && !entry) entry = &b;
+        }
+        if (!entry) {
+            entry = &bound_inputs[next_bound];
+            next_bound = (next_bound + 1) % YOLO_BOUND_INPUTS;
+        }
+        entry->tensor = nullptr;
+
+        // Logic: 8 (uint8 bits) + exponent (usually -7) should equal 1
+        int shift_check = 8 + input_tensor->exponent;
+        if (shift_check != 1) {
+             printf("[Yolo26Processor] Error: Model exponent %d not compatible with optimization (Expected -7)\n", input_tensor->exponent);
+             return false;
+        }
+
+        int input_h = input_tensor->shape[1];
+        int input_w = input_tensor->shape[2];
+        if constexpr (is_static_shape) {
+            if (input_w != Width || input_h != Height) {
+                printf("[Yolo26Processor] Error: Model input %dx%d does not match specialization %dx%d\n",
+                       input_w, input_h, Width, Height);
+                return false;
+            }
+        } else {
+            // Written only on a size change. These are plain ints that postprocess() may read on
+            // another core, so a running Yolo26Pipeline must be stopped before the processor
+            // is bound to a model of another input size.
+            for(int i=0; i<3; i++) {
+                if (grid_h[i] != input_h / strides[i]) grid_h[i] = input_h / strides[i];
+                if (grid_w[i] != input_w / strides[i]) grid_w[i] = input_w / strides[i];
+            }
+        }
+        *entry = {input_tensor, input_tensor->exponent, input_h, input_w};
+        return true;
+    }
+
+    void clear_bound_inputs() {
+        for (BoundInput& b : bound_inputs) b.tensor = nullptr;
+        next_bound = 0;
+    }
+
+    /**
+     * @brief True if `outputs` is still the map the plan was resolved from.
+     */
+    bool plan_matches(const std::map<std::string, dl::TensorBase*>& outputs) const {
+        if (!plan.valid || (int)outputs.size() != plan.num_outputs) return false;
+        int i = 0;
+        for (const auto& kv : outputs) {
+            const dl::TensorBase* t = kv.second;
+            if (t != plan.tensors[i] || t->data != plan.data[i] || t->exponent != plan.exponents[i]) return false;
+            i++;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Makes the plan current for `outputs` and conf_thresh, resolving only what changed.
+     */
+    bool update_plan(const std::map<std::string, dl::TensorBase*>& outputs) {
+        if (!plan_matches(outputs)) {
+            plan.valid = false;
+            if (!resolve_outputs(outputs, plan.layers, plan.dtype)) return false;
+            plan.th = make_thresholds(plan.layers, conf_thresh);
+            plan.num_outputs = (int)outputs.size();
+            plan.valid = plan.num_outputs <= YOLO_PLAN_MAX_OUTPUTS;
+            int i = 0;
+            for (const auto& kv : outputs) {
+                if (i == YOLO_PLAN_MAX_OUTPUTS) break;
+                plan.tensors[i] = kv.second;
+                plan.data[i] = kv.second->data;
+                plan.exponents[i] = kv.second->exponent;
+                i++;
+            }
+        } else if (plan.th.conf != conf_thresh) {
+            plan.th = make_thresholds(plan.layers, conf_thresh);
+        }
+        return true;
+    }
+
+    static jpeg_dec_handle_t open_jpeg(bool block) {
+        jpeg_dec_config_t config = DEFAULT_JPEG_DEC_CONFIG();
+        config.output_type = JPEG_PIXEL_FORMAT_RGB888;
+        config.block_enable = block;
+        jpeg_dec_handle_t decoder = nullptr;
+        if (jpeg_dec_open(&config, &decoder) != JPEG_ERR_OK) {
+            printf("[Yolo26Processor] Error: Failed to open JPEG decoder\n");
+            return nullptr;
+        }
+        return decoder;
+    }
+
+    /**
+     * @brief Returns a decoder with the header of `io` parsed.
+     * Arena mode reuses the persistent decoder and only reopens it (allocating) if reuse fails.
+     */
+    jpeg_dec_handle_t begin_jpeg(bool block, jpeg_dec_io_t& io, jpeg_dec_header_info_t& info) {
+        jpeg_dec_handle_t* persistent = arena ? (block ? &block_decoder : &frame_decoder) : nullptr;
+        jpeg_dec_handle_t decoder = persistent ? *persistent : open_jpeg(block);
+        if (!decoder) return nullptr;
+        if (jpeg_dec_parse_header(decoder, &io, &info) == JPEG_ERR_OK) return decoder;
+
+        if (persistent) {
+            jpeg_dec_close(decoder);
+            *persistent = decoder = open_jpeg(block);
+            if (decoder && jpeg_dec_parse_header(decoder, &io, &info) == JPEG_ERR_OK) return decoder;
+        } else {
+            jpeg_dec_close(decoder);
+            decoder = nullptr;
+        }
+        printf("[Yolo26Processor] Error: Invalid JPEG header\n");
+        return nullptr;
+    }
+
+    void end_jpeg(jpeg_dec_handle_t decoder) {
+        if (decoder != block_decoder && decoder != frame_decoder) {
+            jpeg_dec_close(decoder);
+        }
+    }
+
+    // Horizontal sampling map for `n` destination pixels: the arena's in arena mode, else a heap buffer.
+    int* acquire_x_map(int n) {
+        if (arena) return n <= x_map_cap ? x_map_buf : nullptr;
+        return (int*)yolo26_alloc_hot(n * sizeof(int));
+    }
+
+    void release_x_map(int* x_map) {
+        if (x_map != x_map_buf) heap_caps_free(x_map);
+    }
+
+    static void fill_x_map(int* x_map, int src_w, int n) {
+        for (int dx = 0; dx < n; dx++) {
+            x_map[dx] = (dx * src_w / n) * 3;
+        }
+    }
+
+    // Source pixel index (not byte offset) per destination pixel, for the camera format kernels
+    static void fill_x_index(int* x_map, int src_w, int n) {
+        for (int dx = 0; dx < n; dx++) {
+            x_map[dx] = dx * src_w / n;
+        }
+    }
+
+    /**
+     * @brief Writes one model input row: pad bytes left/right of the roi, then `src_row`
+     * (src_w RGB888 pixels) sampled through `x_map` and quantized.
+     */
+    void emit_row(const uint8_t* src_row, int src_w, int8_t* line, int dst_w, const Yolo26Transform& t, const int* x_map) {
+        int8_t pad_q = quantization_lut[YOLO_LETTERBOX_PAD];
+        memset(line, pad_q, t.roi_x * 3);
+        memset(line + (t.roi_x + t.roi_w) * 3, pad_q, (dst_w - t.roi_x - t.roi_w) * 3);
+        int8_t* dst_row = line + t.roi_x * 3;
+        if (src_w == t.roi_w) {
+            quantize_fn(src_row, dst_row, t.roi_w * 3, quantization_lut.data());
+            return;
+        }
+        for (int dx = 0; dx < t.roi_w; dx++) {
+            const uint8_t* px = src_row + x_map[dx];
+            dst_row[dx * 3 + 0] = quantization_lut[px[0]];
+            dst_row[dx * 3 + 1] = quantization_lut[px[1]];
+            dst_row[dx * 3 + 2] = quantization_lut[px[2]];
+        }
+    }
+
+    // Pad rows above and below the roi.
+    void emit_pad_rows(int8_t* raw_input, int dst_w, int dst_h, const Yolo26Transform& t) {
+        int8_t pad_q = quantization_lut[YOLO_LETTERBOX_PAD];
+        size_t row_bytes = (size_t)dst_w * 3;
+        int roi_end = t.roi_y + t.roi_h;
+        memset(raw_input, pad_q, t.roi_y * row_bytes);
+        memset(raw_input + roi_end * row_bytes, pad_q, (dst_h - roi_end) * row_bytes);
+    }
+
+    /**
+     * @brief Nearest-neighbour copy of `src` into the roi of `dst` (both RGB888, dst model-sized),
+     * border filled with YOLO_LETTERBOX_PAD.
+     */
+    static void letterbox_rgb(const dl::image::img_t& src, dl::image::img_t& dst, const Yolo26Transform& xf, int* x_map) {
+        const uint8_t* src_px = (const uint8_t*)src.data;
+        uint8_t* dst_px = (uint8_t*)dst.data;
+        int dst_stride = dst.width * 3;
+        fill_x_map(x_map, src.width, xf.roi_w);
+
+        memset(dst_px, YOLO_LETTERBOX_PAD, (size_t)xf.roi_y * dst_stride);
+        for (int dy = 0; dy < xf.roi_h; dy++) {
+            const uint8_t* src_row = src_px + (size_t)(dy * src.height / xf.roi_h) * src.width * 3;
+            uint8_t* dst_row = dst_px + (size_t)(xf.roi_y + dy) * dst_stride;
+            memset(dst_row, YOLO_LETTERBOX_PAD, xf.roi_x * 3);
+            uint8_t* out = dst_row + xf.roi_x * 3;
+            for (int dx = 0; dx < xf.roi_w; dx++) {
+                const uint8_t* px = src_row + x_map[dx];
+                out[dx * 3 + 0] = px[0];
+                out[dx * 3 + 1] = px[1];
+                out[dx * 3 + 2] = px[2];
+            }
+            memset(out + xf.roi_w * 3, YOLO_LETTERBOX_PAD, (dst.width - xf.roi_x - xf.roi_w) * 3);
+        }
+        int bottom = xf.roi_y + xf.roi_h;
+        memset(dst_px + (size_t)bottom * dst_stride, YOLO_LETTERBOX_PAD, (size_t)(dst.height - bottom) * dst_stride);
+    }
+
+    /**
+     * @brief Resizes `img` into the model-sized RGB888 buffer `dst` using the current resize mode.
+     * @return false if arena scratch is too small
+     */
+    bool resize_rgb(const dl::image::img_t& img, dl::image::img_t& dst, const Yolo26Transform& xf) {
+        if (resize_mode == YOLO_RESIZE_STRETCH) {
+            dl::image::ImageTransformer transformer;
+            transformer.set_src_img(img)
+                       .set_dst_img(dst)
+                       .transform();
+            return true;
+        }
+        int* x_map = acquire_x_map(xf.roi_w);
+        if (!x_map) return false;
+        letterbox_rgb(img, dst, xf, x_map);
+        release_x_map(x_map);
+        return true;
+    }
+
+    /**
+     * @brief resize_rgb() on the PPA when attached, in software otherwise or if the PPA refuses
+     * the frame. `xf` is replaced with the PPA transform when the hardware path is taken.
+     */
+    bool resize_frame(const dl::image::img_t& img, dl::image::img_t& dst, size_t dst_capacity, Yolo26Transform& xf) {
+        if (accel && accel->has_ppa()) {
+            Yolo26Transform hw = yolo26_make_ppa_transform(img.width, img.height, dst.width, dst.height, resize_mode);
+            if (accel->resize(img, dst, dst_capacity, hw)) {
+                xf = hw;
+                return true;
+            }
+        }
+        return resize_rgb(img, dst, xf);
+    }
+
 public:
     /**
      * @brief Constructor.
@@ -61,13 +506,11 @@ public:
      */
     Yolo26Processor(int k = YOLO_TARGET_K, float thresh = YOLO_CONF_THRESH, const char** classes = coco_classes) 
         : target_k(k), conf_thresh(thresh), class_names(classes) {
-        // Reserve memory for grids
-        grid_sizes.resize(3);
-        
         // Calculate Quantization LUT (Lossless)
         // Recovers the exact precision of floating point normalization.
         // Scale 128 correspondes to exponent -7 (which is validated in preprocess).
         // Formula: round( (pixel / 255.0) * 128 )
+        quantization_lut.resize(256);
         for (int i = 0; i < 256; i++) {
             float normalized = i / 255.0f;
             float scaled = normalized * 128.0f; 
@@ -79,9 +522,166 @@ public:
             
             quantization_lut[i] = (int8_t)val;
         }
+
+        quant_kernel = yolo26_select_quant_kernel(quantization_lut.data(), &quantize_fn);
+
+        topk_storage.resize(YOLO_EXECUTOR_PARTS * std::max(target_k, 0));
+        reset_topk(topk_storage.data(), std::max(target_k, 0));
+        suppressor.reserve(std::max(target_k, 0));
+        suppressor_q.reserve(std::max(target_k, 0));
     }
     
     ~Yolo26Processor() {
+        if (block_decoder) jpeg_dec_close(block_decoder);
+        if (frame_decoder) jpeg_dec_close(frame_decoder);
+        heap_caps_free(color_lut);
+    }
+
+    Yolo26Processor(const Yolo26Processor&) = delete;
+    Yolo26Processor& operator=(const Yolo26Processor&) = delete;
+
+    /**
+     * @brief Splits preprocess() quantization and the postprocess() scan with `ex` (running,
+     * or started later) across both cores. nullptr returns to single-core processing.
+     * Results are identical either way. The executor must outlive its use by this processor.
+     */
+    void set_executor(Yolo26Executor* ex) {
+        executor = ex;
+    }
+
+    /**
+     * @brief Routes decode_jpeg() to the JPEG codec and resize() / resize_into() to the PPA for
+     * the engines `acc` has open; the rest stays in software. nullptr = software only.
+     * PPA resizes use 1/16-step scales, so the returned transform (not the software one) must be
+     * passed to postprocess(). The accelerator must outlive its use by this processor.
+     */
+    void set_accel(Yolo26Accel* acc) {
+        accel = acc;
+    }
+
+    /**
+     * @brief Selects how resize(), resize_into() and decode_preprocess_jpeg() fit a frame
+     * to the model input (default: stretch).
+     */
+    void set_resize_mode(Yolo26ResizeMode mode) {
+        resize_mode = mode;
+    }
+
+    Yolo26ResizeMode get_resize_mode() const {
+        return resize_mode;
+    }
+
+    int get_target_k() const {
+        return target_k;
+    }
+
+    /**
+     * @brief Changes the global confidence threshold. Call from the task that runs postprocess();
+     * the integer thresholds are recomputed on the next frame.
+     */
+    void set_conf_thresh(float thresh) {
+        conf_thresh = thresh;
+    }
+
+    float get_conf_thresh() const {
+        return conf_thresh;
+    }
+
+    // --- Class Rules ---
+    // Safe to call from any task while frames are processed; applied from the next postprocess().
+
+    /**
+     * @brief Per-class confidence thresholds for classes 0..n-1, overriding the global threshold
+     * (a negative entry keeps it). n = 0 clears them.
+     */
+    void set_class_thresholds(const float* thresh, int n) {
+        class_filter.set_thresholds(thresh, n);
+    }
+
+    void set_class_threshold(int class_id, float thresh) {
+        class_filter.set_threshold(class_id, thresh);
+    }
+
+    /**
+     * @brief Reports only the classes in `ids`; the others are never scanned. n = 0 allows all.
+     */
+    void set_allowed_classes(const int* ids, int n) {
+        class_filter.set_allowed(ids, n);
+    }
+
+    /**
+     * @brief Back to the single global threshold over every class.
+     */
+    void clear_class_rules() {
+        class_filter.clear();
+    }
+
+    // --- Duplicate Suppression ---
+
+    /**
+     * @brief Enables the class-aware suppression pass on the top-K list (yolo_suppress.hpp): among
+     * same-class boxes overlapping by more than `iou`, only the best-scoring one is reported.
+     * Costs O(K^2) integer box tests per frame whatever the candidate count. Safe to call from any
+     * task; applied from the next postprocess(). Its storage is sized at construction, so enabling
+     * it never allocates.
+     */
+    void set_suppression(bool enable, float iou = YOLO_SUPPRESS_IOU) {
+        suppress_iou.store(yolo26_suppress_iou_num(iou), std::memory_order_relaxed);
+        suppress_on.store(enable, std::memory_order_release);
+    }
+
+    bool get_suppression() const {
+        return suppress_on.load(std::memory_order_relaxed);
+    }
+
+    // --- Early Exit ---
+
+    /**
+     * @brief Scans the stride layers coarse to fine (p5, p4, p3) and skips the finer ones once
+     * `min_hits` candidates have cleared their thresholds, class rules included. Results are
+     * then the top-K of the layers scanned, so small objects only seen by p3 may be missed.
+     * 0 restores the full scan. Safe to call from any task; applied from the next postprocess().
+     */
+    void set_early_exit(int min_hits) {
+        early_exit_hits.store(std::max(min_hits, 0), std::memory_order_relaxed);
+    }
+
+    int get_early_exit() const {
+        return early_exit_hits.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Grid cells in the layers scanned by the last postprocess() or query_presence()
+     * (grid_h * grid_w summed over p3, p4 and p5 without an early exit).
+     */
+    int get_last_scan_cells() const {
+        return scanned_cells;
+    }
+
+    /**
+     * @brief Name of the quantization kernel selected at construction ("pie", "swar" or "lut").
+     */
+    const char* get_quant_kernel_name() const {
+        return yolo26_quant_kernel_name(quant_kernel);
+    }
+
+    /**
+     * @brief Prints where each hot buffer landed (see yolo_memory.hpp). Buffers built lazily
+     * (class thresholds, color LUT) show "-" until their first use.
+     */
+    void print_memory_placement() const {
+        printf("Processor memory (%s, frames in %d B lines):\n",
+               YOLO_MEM_PLACEMENT ? "pinned" : "malloc default", YOLO_MEM_CACHE_LINE);
+        const uint64_t* heaps = topk64.get_storage();
+        yolo26_print_placement("quantization LUT", quantization_lut.data(), quantization_lut.size());
+        yolo26_print_placement("top-K heaps", heaps, sizeof(uint64_t) * YOLO_EXECUTOR_PARTS * std::max(target_k, 0));
+        yolo26_print_placement("class thresholds", class_filter.get_plan_storage(), class_filter.get_plan_bytes());
+        yolo26_print_placement("color LUT", color_lut, color_lut ? sizeof(Yolo26ColorLut) : 0);
+        yolo26_print_placement("suppression masks", suppressor.get_storage(), suppressor.get_storage_bytes());
+        if (arena) {
+            yolo26_print_placement("sampling map", x_map_buf, sizeof(int) * x_map_cap);
+            yolo26_print_placement("decode strip", strip_buf, strip_buf_bytes);
+        }
     }
 
     /**
@@ -92,6 +692,10 @@ public:
             .data = (void*)jpg_data,
             .data_len = jpg_len
         };
+        if (accel && accel->has_jpeg()) {
+            dl::image::img_t img = accel->decode_jpeg(jpg_data, jpg_len);
+            if (img.data) return img;
+        }
         return dl::image::sw_decode_jpeg(jpeg_img, dl::image::DL_IMAGE_PIX_TYPE_RGB888);
     }
 
@@ -100,67 +704,386 @@ public:
      * 
      * @param img Input image
      * @param inputs Model input map
+     * @param xf Optional. Receives the frame -> model mapping for postprocess()
      * @return dl::image::img_t Resized image (or original if no resize needed)
      */
-    dl::image::img_t resize(dl::image::img_t& img, const std::map<std::string, dl::TensorBase*>& inputs) {
+    dl::image::img_t resize(dl::image::img_t& img, const std::map<std::string, dl::TensorBase*>& inputs, Yolo26Transform* xf = nullptr) {
         if (inputs.empty()) return img;
         dl::TensorBase* input_tensor = inputs.begin()->second;
         
         int model_h = input_tensor->shape[1];
         int model_w = input_tensor->shape[2];
+        Yolo26Transform t = yolo26_make_transform(img.width, img.height, model_w, model_h, resize_mode);
         
         if (img.width != model_w || img.height != model_h) {
             dl::image::img_t resized_img;
             resized_img.width = model_w;
             resized_img.height = model_h;
             resized_img.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
-            resized_img.data = heap_caps_malloc(dl::image::get_img_byte_size(resized_img), MALLOC_CAP_DEFAULT);
-            
-            dl::image::ImageTransformer transformer;
-            transformer.set_src_img(img)
-                       .set_dst_img(resized_img)
-                       .transform();
-            
+            size_t bytes = dl::image::get_img_byte_size(resized_img);
+            resized_img.data = yolo26_alloc_frame(bytes, accel ? accel->get_alignment() : 0); // PPA output: whole cache lines
+            if (resized_img.data && !resize_frame(img, resized_img, bytes, t)) {
+                heap_caps_free(resized_img.data);
+                resized_img.data = nullptr;
+            }
+            if (xf) *xf = t;
             return resized_img; 
         }
         
+        if (xf) *xf = t;
         return img;
     }
 
     /**
-     * @brief Preprocesses image and updates internal state (grid_sizes).
+     * @brief Preprocesses image and updates internal state (grid sizes).
      * 
-     * @param img Input image (RGB888)
+     * @param img Input image (RGB888 at model size; RGB565 of any size goes through the camera path)
      * @param inputs Model input map (used to get tensor data and shape)
      */
     void preprocess(const dl::image::img_t& img, const std::map<std::string, dl::TensorBase*>& inputs) {
+        if (img.pix_type == dl::image::DL_IMAGE_PIX_TYPE_RGB565LE || img.pix_type == dl::image::DL_IMAGE_PIX_TYPE_RGB565BE) {
+            Yolo26CameraFrame frame;
+            frame.data = img.data;
+            frame.width = img.width;
+            frame.height = img.height;
+            frame.format = img.pix_type == dl::image::DL_IMAGE_PIX_TYPE_RGB565BE ? YOLO_PIX_RGB565_BE : YOLO_PIX_RGB565_LE;
+            preprocess(frame, inputs);
+            return;
+        }
+
         // 1. Get the first input tensor
         if (inputs.empty()) return;
         dl::TensorBase* input_tensor = inputs.begin()->second;
 
-        // 2. Validate Exponent for LUT Optimization
-        // Logic: 8 (uint8 bits) + exponent (usually -7) should equal 1
-        int shift_check = 8 + input_tensor->exponent;
-        if (shift_check != 1) {
-             printf("[Yolo26Processor] Error: Model exponent %d not compatible with optimization (Expected -7)\n", input_tensor->exponent);
+        // 2. Validate Exponent for LUT Optimization, Calculate and Store Grid Sizes
+        bool bound = bind_input(input_tensor);
+        assert(bound);
+        if (!bound) return;
+
+        // 3. Quantize (Fast & Lossless)
+        // Vector kernel is bit-exact with the LUT: round(p * 128 / 255) == sat(p + 1) >> 1
+        uint8_t* rgb_data = (uint8_t*)img.data;
+        int8_t* raw_input = (int8_t*)input_tensor->data;
+        int total_pixels = img.width * img.height * 3;
+
+        if (!executor || !executor->is_running()) {
+            quantize_fn(rgb_data, raw_input, total_pixels, quantization_lut.data());
+            return;
         }
-        assert(shift_check == 1);
+        // Two halves, split on a cache line so both keep the kernel's alignment
+        QuantizeJob job = {quantize_fn, rgb_data, raw_input, quantization_lut.data(), {0, 0}, {0, 0}};
+        size_t split = (size_t)total_pixels / 2 / YOLO_ARENA_FRAME_ALIGN * YOLO_ARENA_FRAME_ALIGN;
+        job.begin[1] = job.end[0] = split;
+        job.end[1] = (size_t)total_pixels;
+        executor->run(quantize_job, &job);
+    }
 
-        // 3. Calculate and Store Grid Sizes
-        int input_w = input_tensor->shape[2]; 
-        for(int i=0; i<3; i++) {
-            grid_sizes[i] = input_w / strides[i];
+    /**
+     * @brief Resize + color conversion + quantization of a native camera frame (RGB565 or
+     * YUV422) straight into the model input tensor, in one pass.
+     *
+     * Each destination pixel is sampled nearest-neighbour (current resize mode) and mapped through
+     * the format's tables (yolo_color.hpp), so no RGB888 frame is written or read back. Rows are
+     * split across both cores when an executor runs. preprocess(img_t) forwards RGB565 images here.
+     *
+     * @param frame Camera frame, any size
+     * @param inputs Model input map (used to get tensor data and shape)
+     * @param xf Optional. Receives the frame -> model mapping for postprocess()
+     * @return false on an invalid frame or model input (grid sizes are updated as in preprocess())
+     */
+    bool preprocess(const Yolo26CameraFrame& frame, const std::map<std::string, dl::TensorBase*>& inputs, Yolo26Transform* xf = nullptr) {
+        if (inputs.empty() || !frame.data || frame.width <= 0 || frame.height <= 0) return false;
+        bool yuv = frame.format == YOLO_PIX_YUYV || frame.format == YOLO_PIX_UYVY;
+        if (yuv && (frame.width & 1)) {
+            printf("[Yolo26Processor] Error: YUV422 frame width %d is odd\n", frame.width);
+            return false;
         }
+        dl::TensorBase* input_tensor = inputs.begin()->second;
+        if (!bind_input(input_tensor)) return false;
+        if (!color_lut) {
+            color_lut = (Yolo26ColorLut*)yolo26_alloc_hot(sizeof(Yolo26ColorLut));
+            if (!color_lut) return false;
+            color_lut->init(quantization_lut.data());
+        }
+        int dst_h = input_tensor->shape[1];
+        int dst_w = input_tensor->shape[2];
+
+        Yolo26Transform t = yolo26_make_transform(frame.width, frame.height, dst_w, dst_h, resize_mode);
+        if (xf) *xf = t;
+        int* x_map = acquire_x_map(t.roi_w);
+        if (!x_map) return false;
+        fill_x_index(x_map, frame.width, t.roi_w);
 
-        // 4. Quantize using LUT (Fast & Lossless)
-        uint8_t* rgb_data = (uint8_t*)img.data;
         int8_t* raw_input = (int8_t*)input_tensor->data;
-        int total_pixels = img.width * img.height * 3;
+        emit_pad_rows(raw_input, dst_w, dst_h, t);
+        ConvertJob job = {&frame, &t, x_map, color_lut, raw_input, dst_w, quantization_lut[YOLO_LETTERBOX_PAD],
+                          {0, t.roi_h / 2}, {t.roi_h / 2, t.roi_h}};
+        if (executor && executor->is_running()) {
+            executor->run(convert_job, &job);
+        } else {
+            convert_rows(job, 0, t.roi_h);
+        }
+        release_x_map(x_map);
+        return true;
+    }
+
+    /**
+     * @brief Validates the model input and stores the grid sizes without quantizing a frame.
+     * For postprocess() on outputs that were not produced through this processor (recordings).
+     */
+    bool bind(const std::map<std::string, dl::TensorBase*>& inputs) {
+        clear_bound_inputs();
+        plan.valid = false;
+        return !inputs.empty() && bind_input(inputs.begin()->second);
+    }
+
+    /**
+     * @brief Fused Decode + Resize + Quantize straight into the model input tensor.
+     *
+     * Replaces decode_jpeg() -> resize() -> preprocess() for JPEG sources.
+     * The JPEG is decoded one MCU row block (8 or 16 lines) at a time into a small strip buffer,
+     * destination rows are sampled nearest-neighbour from the strip and written through the
+     * quantization LUT. No full-frame RGB888 buffer is ever allocated.
+     * In letterbox mode the border is written as the pre-quantized pad value.
+     *
+     * @param jpg_data JPEG bitstream
+     * @param jpg_len JPEG length in bytes
+     * @param inputs Model input map (used to get tensor data and shape)
+     * @param xf Optional. Receives the frame -> model mapping for postprocess()
+     * @param motion Optional. Receives the full-frame luma signature, sampled from the strips
+     *               while they are decoded (feed it to Yolo26MotionGate)
+     * @return true on success (grid sizes are updated as in preprocess())
+     */
+    bool decode_preprocess_jpeg(const uint8_t* jpg_data, size_t jpg_len, const std::map<std::string, dl::TensorBase*>& inputs,
+                                Yolo26Transform* xf = nullptr, Yolo26LumaSignature* motion = nullptr) {
+        if (inputs.empty()) return false;
+        dl::TensorBase* input_tensor = inputs.begin()->second;
+
+        if (!bind_input(input_tensor)) return false;
+        int dst_h = input_tensor->shape[1];
+        int dst_w = input_tensor->shape[2];
+
+        // 1. Block decoder (each jpeg_dec_process() call emits one MCU row)
+        jpeg_dec_io_t io = {};
+        io.inbuf = (uint8_t*)jpg_data;
+        io.inbuf_len = (int)jpg_len;
+        jpeg_dec_header_info_t info = {};
+        jpeg_dec_handle_t decoder = begin_jpeg(true, io, info);
+        if (!decoder) return false;
+
+        int strip_bytes = 0;
+        int block_count = 0;
+        if (jpeg_dec_get_outbuf_len(decoder, &strip_bytes) != JPEG_ERR_OK ||
+            jpeg_dec_get_process_count(decoder, &block_count) != JPEG_ERR_OK) {
+            printf("[Yolo26Processor] Error: Invalid JPEG header\n");
+            end_jpeg(decoder);
+            return false;
+        }
+
+        int src_w = info.width;
+        int src_h = info.height;
+        int strip_rows = strip_bytes / (src_w * 3);
+        Yolo26Transform t = yolo26_make_transform(src_w, src_h, dst_w, dst_h, resize_mode);
+        if (xf) *xf = t;
 
-        for (int i = 0; i < total_pixels; i++) {
-            // LUT lookup recovers exact floating point precision without the cost
-            raw_input[i] = quantization_lut[rgb_data[i]];
+        // 2. Strip buffer (one MCU row, ~1% of a frame) plus the horizontal sampling map.
+        // Arena mode reuses buffers carved once in use_arena().
+        uint8_t* strip = strip_buf;
+        if (arena) {
+            if ((size_t)strip_bytes > strip_buf_bytes || t.roi_w > x_map_cap) {
+                printf("[Yolo26Processor] Error: %dx%d JPEG exceeds arena limits\n", src_w, src_h);
+                end_jpeg(decoder);
+                return false;
+            }
+        } else {
+            strip = (uint8_t*)jpeg_calloc_align(strip_bytes, 16);
+        }
+        int* x_map = acquire_x_map(t.roi_w);
+        if (!strip || !x_map) {
+            if (!arena && strip) jpeg_free_align(strip);
+            if (x_map) release_x_map(x_map);
+            end_jpeg(decoder);
+            return false;
         }
+        fill_x_map(x_map, src_w, t.roi_w);
+
+        // 3. Letterbox border, written once as the already quantized pad value
+        int8_t* raw_input = (int8_t*)input_tensor->data;
+        emit_pad_rows(raw_input, dst_w, dst_h, t);
+
+        // 4. Decode strips and emit every destination row whose source row falls inside.
+        // The motion signature needs every strip, so it keeps the decoder going past the last sampled row.
+        if (motion) motion->valid = false;
+        int dy = 0;
+        bool ok = true;
+        for (int b = 0; b < block_count && (dy < t.roi_h || motion); b++) {
+            io.outbuf = strip;
+            if (jpeg_dec_process(decoder, &io) != JPEG_ERR_OK) {
+                printf("[Yolo26Processor] Error: JPEG decode failed at block %d\n", b);
+                ok = false;
+                break;
+            }
+            int strip_y0 = b * strip_rows;
+            int strip_y1 = strip_y0 + strip_rows;
+            if (motion) {
+                yolo26_luma_signature_strip(strip, strip_y0, std::min(strip_y1, src_h), src_w, src_h, *motion);
+            }
+
+            for (; dy < t.roi_h; dy++) {
+                int sy = dy * src_h / t.roi_h;
+                if (sy >= strip_y1) break;
+                const uint8_t* src_row = strip + (sy - strip_y0) * src_w * 3;
+                emit_row(src_row, src_w, raw_input + (size_t)(t.roi_y + dy) * dst_w * 3, dst_w, t, x_map);
+            }
+        }
+
+        if (!arena) jpeg_free_align(strip);
+        release_x_map(x_map);
+        end_jpeg(decoder);
+        if (motion) motion->valid = ok;
+        return ok && dy == t.roi_h;
+    }
+
+    /**
+     * @brief Resize + Quantize a region of an RGB888 frame straight into the model input tensor.
+     *
+     * Used for tiles / ROIs of high-resolution frames: the region is sampled nearest-neighbour
+     * (current resize mode) without an intermediate RGB buffer.
+     *
+     * @param img Full RGB888 frame
+     * @param region Region in frame pixels, must lie inside the frame
+     * @param inputs Model input map (used to get tensor data and shape)
+     * @param xf Optional. Receives the region -> model mapping; postprocess() with it returns full-frame pixels
+     * @return true on success (grid sizes are updated as in preprocess())
+     */
+    bool preprocess_region(const dl::image::img_t& img, const Yolo26Rect& region, const std::map<std::string, dl::TensorBase*>& inputs,
+                           Yolo26Transform* xf = nullptr) {
+        if (inputs.empty()) return false;
+        if (region.w <= 0 || region.h <= 0 || region.x < 0 || region.y < 0 ||
+            region.x + region.w > img.width || region.y + region.h > img.height) {
+            printf("[Yolo26Processor] Error: Region %d,%d %dx%d outside %dx%d frame\n",
+                   region.x, region.y, region.w, region.h, img.width, img.height);
+            return false;
+        }
+        dl::TensorBase* input_tensor = inputs.begin()->second;
+        if (!bind_input(input_tensor)) return false;
+        int dst_h = input_tensor->shape[1];
+        int dst_w = input_tensor->shape[2];
+
+        Yolo26Transform t = yolo26_make_region_transform(region, dst_w, dst_h, resize_mode);
+        if (xf) *xf = t;
+        int* x_map = acquire_x_map(t.roi_w);
+        if (!x_map) return false;
+        fill_x_map(x_map, region.w, t.roi_w);
+
+        int8_t* raw_input = (int8_t*)input_tensor->data;
+        const uint8_t* origin = (const uint8_t*)img.data + ((size_t)region.y * img.width + region.x) * 3;
+        emit_pad_rows(raw_input, dst_w, dst_h, t);
+        for (int dy = 0; dy < t.roi_h; dy++) {
+            const uint8_t* src_row = origin + (size_t)(dy * region.h / t.roi_h) * img.width * 3;
+            emit_row(src_row, region.w, raw_input + (size_t)(t.roi_y + dy) * dst_w * 3, dst_w, t, x_map);
+        }
+        release_x_map(x_map);
+        return true;
+    }
+
+    // --- Arena Mode (zero steady-state allocation) ---
+
+    /**
+     * @brief Moves all per-frame scratch into `a`: top-K storage, decode strip and sampling map
+     * are carved from its internal SRAM region and the JPEG decoders are kept open.
+     * Call once at init, before the first frame. The arena must outlive the processor.
+     *
+     * @return false if the arena is too small (the processor keeps working without it)
+     */
+    bool use_arena(Yolo26Arena& a) {
+        if (arena) return false;
+
+        int k = std::max(target_k, 0);
+        size_t strip_bytes = (size_t)a.get_max_frame_width() * YOLO_MAX_MCU_ROWS * 3;
+        int map_cap = is_static_shape ? Width : YOLO_MAX_INPUT_WIDTH;
+
+        uint64_t* heap_mem = (uint64_t*)a.alloc_internal(sizeof(uint64_t) * YOLO_EXECUTOR_PARTS * (k > 0 ? k : 1));
+        uint8_t* strip = (uint8_t*)a.alloc_internal(strip_bytes);
+        int* map = (int*)a.alloc_internal(sizeof(int) * map_cap);
+        if (!heap_mem || !strip || !map) return false;
+
+        jpeg_dec_handle_t block_dec = open_jpeg(true);
+        jpeg_dec_handle_t frame_dec = open_jpeg(false);
+        if (!block_dec || !frame_dec) {
+            if (block_dec) jpeg_dec_close(block_dec);
+            if (frame_dec) jpeg_dec_close(frame_dec);
+            return false;
+        }
+
+        arena = &a;
+        reset_topk(heap_mem, k);
+        Yolo26HotVector<uint64_t>().swap(topk_storage);
+        strip_buf = strip;
+        strip_buf_bytes = strip_bytes;
+        x_map_buf = map;
+        x_map_cap = map_cap;
+        block_decoder = block_dec;
+        frame_decoder = frame_dec;
+        return true;
+    }
+
+    /**
+     * @brief Decodes JPEG to RGB888 into an arena frame (arena mode only).
+     * @return false if not in arena mode, the frame is invalid, or the image does not fit
+     */
+    bool decode_jpeg_into(const uint8_t* jpg_data, size_t jpg_len, Yolo26Frame& frame) {
+        if (!arena || !frame.valid()) return false;
+
+        jpeg_dec_io_t io = {};
+        io.inbuf = (uint8_t*)jpg_data;
+        io.inbuf_len = (int)jpg_len;
+        jpeg_dec_header_info_t info = {};
+        jpeg_dec_handle_t decoder = begin_jpeg(false, io, info);
+        if (!decoder) return false;
+
+        int out_len = 0;
+        jpeg_dec_get_outbuf_len(decoder, &out_len);
+        if (out_len <= 0 || (size_t)out_len > frame.capacity()) {
+            printf("[Yolo26Processor] Error: %dx%d JPEG exceeds arena frame slot\n", info.width, info.height);
+            end_jpeg(decoder);
+            return false;
+        }
+
+        io.outbuf = (uint8_t*)frame.img.data;
+        bool ok = jpeg_dec_process(decoder, &io) == JPEG_ERR_OK;
+        end_jpeg(decoder);
+        if (!ok) return false;
+
+        frame.img.width = info.width;
+        frame.img.height = info.height;
+        frame.img.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
+        return true;
+    }
+
+    /**
+     * @brief resize() into an arena frame instead of a fresh heap buffer.
+     * @param xf Optional. Receives the frame -> model mapping for postprocess()
+     * @return The image to preprocess: `img` itself if no resize was needed, else `dst.img`
+     * (invalid `dst` -> `img.data == nullptr` in the returned image)
+     */
+    dl::image::img_t resize_into(const dl::image::img_t& img, Yolo26Frame& dst, const std::map<std::string, dl::TensorBase*>& inputs,
+                                 Yolo26Transform* xf = nullptr) {
+        if (inputs.empty()) return img;
+        dl::TensorBase* input_tensor = inputs.begin()->second;
+        int model_h = input_tensor->shape[1];
+        int model_w = input_tensor->shape[2];
+        Yolo26Transform t = yolo26_make_transform(img.width, img.height, model_w, model_h, resize_mode);
+        if (xf) *xf = t;
+        if (img.width == model_w && img.height == model_h) return img;
+        if (!dst.valid() || (size_t)model_w * model_h * 3 > dst.capacity()) return {};
+
+        dst.img.width = model_w;
+        dst.img.height = model_h;
+        dst.img.pix_type = dl::image::DL_IMAGE_PIX_TYPE_RGB888;
+        if (!resize_frame(img, dst.img, dst.capacity(), t)) return {};
+        if (xf) *xf = t;
+        return dst.img;
     }
 
     /**
@@ -171,17 +1094,156 @@ public:
      * we calculate a raw INT8 threshold for each layer.
      * We then filter candidates in the integer domain: if (raw_int8 <= thresh_int8) continue;
      * This skips >99% of floating point math for background pixels.
+     *
+     * OPTIMIZATION: VECTORIZED CELL SCAN (see scan_layer())
+     * Class logits are compared 16 at a time (SWAR), whole background cells are skipped,
+     * and the int8 argmax is found before a single sigmoid call per surviving cell.
+     *
+     * OPTIMIZATION: PARTIAL TOP-K
+     * Survivors go into a fixed-capacity min-heap of target_k entries (O(N log K), no allocation
+     * during the scan). Once it is full, the K-th best logit is mapped back into the layer's
+     * integer domain and raises the scan threshold, so weaker cells are rejected by the SWAR test.
+     *
+     * OPTIMIZATION: LAZY DECODE
+     * The scan only finds each cell's max logit and pushes a packed key (score, layer, cell).
+     * Scores of all layers are shifted to the smallest class exponent so keys compare across
+     * layers. Class argmax, sigmoid() and the box decode run once per returned detection, so
+     * cost no longer grows with the number of cells that clear the threshold.
+     *
+     * OPTIMIZATION: DECODE PLAN
+     * Tensor lookups, scales and integer thresholds are resolved on the first frame and reused
+     * while the output map keeps its identity (see DecodePlan), so a frame runs no string
+     * compare and no pow() / log().
+     *
+     * OPTIONAL: DUPLICATE SUPPRESSION (set_suppression())
+     * A class-aware integer IoU pass over the K decoded boxes (bitmask sweep, yolo_suppress.hpp),
+     * so its cost is fixed by K and independent of the candidate count.
+     *
+     * OPTIONAL: EARLY EXIT (set_early_exit(), query_presence())
+     * Layers are scanned coarse to fine and the finer ones skipped once enough candidates
+     * passed; a presence query stops at the first passing cell.
+     *
+     * OPTIONAL: COMPACT DETECTIONS (postprocess_into(DetectionQ*))
+     * 10-byte detections with the box decoded by integer shifts instead of float math.
      * 
      * @param outputs Map of model outputs
+     * @param xf Optional. Mapping returned by resize() / decode_preprocess_jpeg(): boxes are
+     *           returned in source frame pixels, clipped to the frame. nullptr = model pixels.
      * @return std::vector<Detection> 
      */
-    std::vector<Detection> postprocess(const std::map<std::string, dl::TensorBase*>& outputs) {
-        // Ensure grid_sizes are ready
-        if (grid_sizes.empty() || grid_sizes[0] == 0) {
+    std::vector<Detection> postprocess(const std::map<std::string, dl::TensorBase*>& outputs, const Yolo26Transform* xf = nullptr) {
+        std::vector<Detection> results(std::max(target_k, 0));
+        results.resize(postprocess_into(outputs, results.data(), (int)results.size(), xf));
+        return results;
+    }
+
+    /**
+     * @brief postprocess() writing into caller memory instead of a new vector.
+     * Performs no heap allocation; pair with use_arena() for a fully allocation-free frame.
+     *
+     * @param out Destination, best detection first
+     * @param capacity Entries available at `out` (at most target_k are ever produced)
+     * @param xf Optional frame mapping, as in postprocess()
+     * @return Number of detections written
+     */
+    int postprocess_into(const std::map<std::string, dl::TensorBase*>& outputs, Detection* out, int capacity,
+                         const Yolo26Transform* xf = nullptr) {
+        // Ensure grid sizes are ready
+        if (grid_w[0] == 0) {
+             printf("[Yolo26Processor] Error: Grid sizes not initialized. Call preprocess() first.\n");
+             return 0;
+        }
+
+        if (!update_plan(outputs)) return 0;
+        return decode_outputs(plan.layers, plan.dtype, plan.th, out, capacity, xf);
+    }
+
+    /**
+     * @brief postprocess_into() producing DetectionQ: the same detections, with box corners
+     * decoded by integer shifts only (exact before rounding to YOLO_DETQ_FRAC_BITS).
+     * Model-pixel boxes are exactly yolo26_quantize_detection() of the float ones. With `xf`,
+     * the 1/4 px corners are mapped to the source frame in float, one step per corner.
+     * Suppression, if enabled, compares the fixed-point boxes.
+     */
+    int postprocess_into(const std::map<std::string, dl::TensorBase*>& outputs, DetectionQ* out, int capacity,
+                         const Yolo26Transform* xf = nullptr) {
+        if (grid_w[0] == 0) {
              printf("[Yolo26Processor] Error: Grid sizes not initialized. Call preprocess() first.\n");
-             return {};
+             return 0;
         }
 
+        if (!update_plan(outputs)) return 0;
+        return decode_outputs(plan.layers, plan.dtype, plan.th, out, capacity, xf);
+    }
+
+    /**
+     * @brief Presence-only query: is any (allowed) class above its threshold anywhere?
+     * Scans p5, p4 then p3 and stops at the first passing cell, so on a scene with a large
+     * object only the 1/21 of the cells in p5 are read. That cell is decoded into `hit`; it is
+     * a passing detection, not necessarily the best one.
+     *
+     * @param hit Optional. The detection that answered the query
+     * @param xf Optional. As in postprocess()
+     */
+    bool query_presence(const std::map<std::string, dl::TensorBase*>& outputs, Detection* hit = nullptr,
+                        const Yolo26Transform* xf = nullptr) {
+        if (grid_w[0] == 0) {
+             printf("[Yolo26Processor] Error: Grid sizes not initialized. Call preprocess() first.\n");
+             return false;
+        }
+
+        if (!update_plan(outputs)) return false;
+        Detection found;
+        if (decode_outputs(plan.layers, plan.dtype, plan.th, &found, 1, xf, true) == 0) return false;
+        if (hit) *hit = found;
+        return true;
+    }
+
+    // --- Batch Mode ---
+
+    /**
+     * @brief Makes the decode plan current once for a batch of frames run through one model.
+     * esp-dl reuses its output tensors across run() calls, so the plan stays valid for every
+     * frame until end_batch(); the batch path skips even the per-frame identity check.
+     * @return false if the outputs do not match the processor
+     */
+    bool begin_batch(const std::map<std::string, dl::TensorBase*>& outputs) {
+        batch_bound = update_plan(outputs);
+        return batch_bound;
+    }
+
+    void end_batch() {
+        batch_bound = false;
+    }
+
+    /**
+     * @brief Integer thresholds for confidence `conf` under the begin_batch() layout: one per
+     * stream and batch, so the per-frame path runs no log().
+     */
+    Yolo26LayerThresholds batch_thresholds(float conf) const {
+        return make_thresholds(plan.layers, conf);
+    }
+
+    /**
+     * @brief postprocess_into() for the frame the model last ran, using the begin_batch() layout
+     * and a stream's own thresholds. Class rules and suppression apply as set on the processor;
+     * with class rules, streams of different confidence recompile the rule plan on each switch.
+     * @return Number of detections written (0 outside a batch)
+     */
+    template <typename Out>
+    int postprocess_batch_into(const Yolo26LayerThresholds& th, Out* out, int capacity,
+                               const Yolo26Transform* xf = nullptr) {
+        static_assert(std::is_same<Out, Detection>::value || std::is_same<Out, DetectionQ>::value,
+                      "Detection or DetectionQ");
+        if (!batch_bound || grid_w[0] == 0) return 0;
+        return decode_outputs(plan.layers, plan.dtype, th, out, capacity, xf);
+    }
+
+private:
+    /**
+     * @brief Looks up the six output tensors and fills the threshold-independent part of `layers`.
+     */
+    bool resolve_outputs(const std::map<std::string, dl::TensorBase*>& outputs, LayerScan* layers, dl::dtype_t& dtype) {
         dl::TensorBase* p3_box = outputs.at("one2one_p3_box");
         dl::TensorBase* p4_box = outputs.at("one2one_p4_box");
         dl::TensorBase* p5_box = outputs.at("one2one_p5_box");
@@ -189,105 +1251,600 @@ public:
         dl::TensorBase* p4_cls = outputs.at("one2one_p4_cls");
         dl::TensorBase* p5_cls = outputs.at("one2one_p5_cls");
 
-        std::vector<Detection> candidates;
-        candidates.reserve(target_k * 2);
-
         dl::TensorBase* boxes[] = {p3_box, p4_box, p5_box};
         dl::TensorBase* clss[] = {p3_cls, p4_cls, p5_cls};
-        dl::dtype_t dtype = p3_box->dtype;
+        dtype = p3_box->dtype;
+
+        if constexpr (NumClasses > 0) {
+            if (p3_cls->shape[3] != NumClasses) {
+                printf("[Yolo26Processor] Error: Model has %d classes, specialization expects %d\n",
+                       p3_cls->shape[3], NumClasses);
+                return false;
+            }
+        } else {
+            num_classes = p3_cls->shape[3];
+        }
 
+        if constexpr (!std::is_void<DType>::value) {
+            constexpr dl::dtype_t expected = sizeof(DType) == 1 ? dl::DATA_TYPE_INT8 : dl::DATA_TYPE_INT16;
+            if (dtype != expected) {
+                printf("[Yolo26Processor] Error: Model output dtype does not match specialization\n");
+                return false;
+            }
+        }
+
+        // Common exponent for 32-bit keys: the finest class scale of the three layers
+        int min_exp = std::min({p3_cls->exponent, p4_cls->exponent, p5_cls->exponent});
+
+        for (int i = 0; i < 3; i++) {
+            layers[i].raw_box = boxes[i]->data;
+            layers[i].raw_cls = clss[i]->data;
+            layers[i].box_scale = std::pow(2.0f, boxes[i]->exponent);
+            layers[i].cls_scale = std::pow(2.0f, clss[i]->exponent);
+            layers[i].inv_cls_scale = std::pow(2.0f, -clss[i]->exponent);
+            layers[i].key_shift = clss[i]->exponent - min_exp;
+            layers[i].cls_exponent = clss[i]->exponent;
+
+            // Edge in pixels = (2 * cell + 1) * 2^(k - 1) -+ raw * 2^(e + k), stride 2^k: integer at
+            // g = max(F, -(e + k)) fraction bits
+            int k = i + 3;
+            int g = std::max(YOLO_DETQ_FRAC_BITS, -(boxes[i]->exponent + k));
+            layers[i].q_anchor_shift = k - 1 + g;
+            layers[i].q_raw_shift = boxes[i]->exponent + k + g;
+            layers[i].q_round_shift = g - YOLO_DETQ_FRAC_BITS;
+        }
+        return true;
+    }
+
+    static Yolo26LayerThresholds make_thresholds(const LayerScan* layers, float conf) {
+        Yolo26LayerThresholds th;
+        th.conf = conf;
+        // raw_thresh = -ln(1/conf_thresh - 1)
+        float raw_thresh_float = -std::log(1.0f / conf - 1.0f);
+        for (int i = 0; i < 3; i++) {
+            // --- Optimization: Calculate integer threshold for this layer ---
+            // int_thresh = floor(raw_thresh / cls_scale): raw > int_thresh  <=>  sigmoid(raw * scale) > conf
+            th.int_thresh[i] = std::floor(raw_thresh_float / layers[i].cls_scale);
+        }
+        return th;
+    }
+
+    /**
+     * @brief Scan, decode, optional suppression and unmapping of resolved outputs.
+     */
+    template <typename Out>
+    int decode_outputs(const LayerScan* resolved, dl::dtype_t dtype, const Yolo26LayerThresholds& th, Out* out,
+                       int capacity, const Yolo26Transform* xf, bool presence = false) {
+        LayerScan layers[3];
         for (int i = 0; i < 3; i++) {
-            int stride = strides[i];
-            int grid_h = grid_sizes[i]; // Use stored grid size
-            int grid_w = grid_sizes[i];
-
-            float box_scale = std::pow(2.0f, boxes[i]->exponent);
-            float cls_scale = std::pow(2.0f, clss[i]->exponent);
-            void* raw_box = boxes[i]->data;
-            void* raw_cls = clss[i]->data;
-
-            // --- Optimization: Calculate INT8 Threshold for this layer ---
-            // raw_thresh = -ln(1/conf_thresh - 1)
-            // int8_thresh = raw_thresh / cls_scale
-            float raw_thresh_float = -std::log(1.0f / conf_thresh - 1.0f);
-            int8_t cls_thresh_int8 = 0;
-            // Note: We assume int8 here as per optimization plan. Check dtype if int16 needed.
-            // Current models are int8.
-            cls_thresh_int8 = (int8_t)std::floor(raw_thresh_float / cls_scale);
-
-            for (int h = 0; h < grid_h; h++) {
-                for (int w = 0; w < grid_w; w++) {
-                    int pixel_idx = (h * grid_w) + w; // NHWC
-                    int cls_offset = pixel_idx * num_classes;
-                    
-                    float max_score = -1.0f;
-                    int best_cls_id = -1;
-
-                    // Class Score Loop
-                    for (int c = 0; c < num_classes; c++) {
-                        // --- OPTIMIZATION START ---
-                        // 1. Fast Integer Check
-                        if (dtype == dl::DATA_TYPE_INT8) {
-                            int8_t raw_val_int8 = ((int8_t*)raw_cls)[cls_offset + c];
-                            if (raw_val_int8 <= cls_thresh_int8) continue; // SKIP FLOAT MATH
-                        }
-                        // --- OPTIMIZATION END ---
-
-                        float raw_val = 0.0f;
-                        if (dtype == dl::DATA_TYPE_INT8) {
-                            raw_val = dequantize_val(((int8_t*)raw_cls)[cls_offset + c], cls_scale);
-                        } else {
-                            raw_val = dequantize_val(((int16_t*)raw_cls)[cls_offset + c], cls_scale);
-                        }
-                        
-                        float score = sigmoid(raw_val);
-                        if (score > max_score) {
-                            max_score = score;
-                            best_cls_id = c;
-                        }
+            layers[i] = resolved[i];
+            layers[i].int_thresh = th.int_thresh[i];
+        }
+        scan_conf = th.conf;
+        exit_hits = presence ? 1 : early_exit_hits.load(std::memory_order_relaxed);
+        exit_at_cell = presence;
+
+        class_filter.sync();
+
+        // dtype dispatch happens once per call, never inside the cell loop
+        int n;
+        if constexpr (std::is_void<DType>::value) {
+            if (dtype == dl::DATA_TYPE_INT8) {
+                n = select_keys<int8_t>(layers, out, capacity);
+            } else {
+                n = select_keys<int16_t>(layers, out, capacity);
+            }
+        } else {
+            n = select_keys<DType>(layers, out, capacity);
+        }
+
+        if (suppress_on.load(std::memory_order_acquire)) {
+            n = suppressor_for<Out>().run(out, n, suppress_iou.load(std::memory_order_relaxed));
+        }
+
+        if (xf) {
+            for (int i = 0; i < n; i++) unmap(*xf, out[i]);
+        }
+        return n;
+    }
+
+    template <typename Out>
+    auto& suppressor_for() {
+        if constexpr (std::is_same<Out, DetectionQ>::value) {
+            return suppressor_q;
+        } else {
+            return suppressor;
+        }
+    }
+
+    static void unmap(const Yolo26Transform& xf, Detection& d) {
+        yolo26_unmap_box(xf, d.x1, d.y1, d.x2, d.y2);
+    }
+
+    static void unmap(const Yolo26Transform& xf, DetectionQ& q) {
+        Detection d = yolo26_dequantize_detection(q);
+        unmap(xf, d);
+        q.x1 = yolo26_q_coord(d.x1);
+        q.y1 = yolo26_q_coord(d.y1);
+        q.x2 = yolo26_q_coord(d.x2);
+        q.y2 = yolo26_q_coord(d.y2);
+    }
+
+    /**
+     * @brief One box edge in YOLO_DETQ_FRAC_BITS fixed point: anchor2 / 2 cells +- raw box units.
+     */
+    static int16_t q_edge(const LayerScan& layer, int anchor2, int raw) {
+        int64_t v = ((int64_t)anchor2 << layer.q_anchor_shift) + (int64_t)raw * ((int64_t)1 << layer.q_raw_shift);
+        if (layer.q_round_shift > 0) v = (v + ((int64_t)1 << (layer.q_round_shift - 1))) >> layer.q_round_shift;
+        return (int16_t)std::clamp<int64_t>(v, -32768, 32767);
+    }
+
+    struct QuantizeJob {
+        Yolo26QuantizeFn fn;
+        const uint8_t* src;
+        int8_t* dst;
+        const int8_t* lut;
+        size_t begin[YOLO_EXECUTOR_PARTS];
+        size_t end[YOLO_EXECUTOR_PARTS];
+    };
+
+    static void quantize_job(void* ctx, int part) {
+        auto* job = static_cast<QuantizeJob*>(ctx);
+        job->fn(job->src + job->begin[part], job->dst + job->begin[part], job->end[part] - job->begin[part], job->lut);
+    }
+
+    struct ConvertJob {
+        const Yolo26CameraFrame* frame;
+        const Yolo26Transform* t;
+        const int* x_map;
+        const Yolo26ColorLut* lut;
+        int8_t* dst;
+        int dst_w;
+        int8_t pad_q;
+        int begin[YOLO_EXECUTOR_PARTS]; // roi rows
+        int end[YOLO_EXECUTOR_PARTS];
+    };
+
+    static void convert_rows(const ConvertJob& job, int begin, int end) {
+        const Yolo26CameraFrame& f = *job.frame;
+        const Yolo26Transform& t = *job.t;
+        size_t src_stride = (size_t)f.width * 2;
+        size_t dst_stride = (size_t)job.dst_w * 3;
+        for (int dy = begin; dy < end; dy++) {
+            const uint8_t* src_row = (const uint8_t*)f.data + (size_t)(dy * f.height / t.roi_h) * src_stride;
+            int8_t* line = job.dst + (size_t)(t.roi_y + dy) * dst_stride;
+            memset(line, job.pad_q, t.roi_x * 3);
+            memset(line + (t.roi_x + t.roi_w) * 3, job.pad_q, (job.dst_w - t.roi_x - t.roi_w) * 3);
+            yolo26_convert_row(f, src_row, job.x_map, t.roi_w, line + t.roi_x * 3, *job.lut);
+        }
+    }
+
+    static void convert_job(void* ctx, int part) {
+        auto* job = static_cast<ConvertJob*>(ctx);
+        convert_rows(*job, job->begin[part], job->end[part]);
+    }
+
+    // Grid rows [begin, end) of each stride layer covered by one scan
+    struct ScanRows {
+        int begin[3];
+        int end[3];
+    };
+
+    ScanRows all_rows() const {
+        return {{0, 0, 0}, {grid_h[0], grid_h[1], grid_h[2]}};
+    }
+
+    /**
+     * @brief Splits the grid into two parts of equal cell count: p3 rows until half of all cells,
+     * then the rest of p3 plus p4 and p5 (p3 alone holds 16/21 of the cells).
+     */
+    void split_rows(ScanRows* parts) const {
+        int total = grid_h[0] * grid_w[0] + grid_h[1] * grid_w[1] + grid_h[2] * grid_w[2];
+        int r = std::min(grid_h[0], (total / 2 + grid_w[0] - 1) / grid_w[0]);
+        parts[0] = {{0, 0, 0}, {r, 0, 0}};
+        parts[1] = {{r, 0, 0}, {grid_h[0], grid_h[1], grid_h[2]}};
+    }
+
+    template <typename Key>
+    Yolo26TopK<Key>& worker_heap() {
+        if constexpr (sizeof(Key) == 4) {
+            return worker_topk32;
+        } else {
+            return worker_topk64;
+        }
+    }
+
+    template <typename Key>
+    struct ScanJob {
+        Yolo26Processor* self;
+        const LayerScan* layers;
+        Yolo26TopK<Key>* heaps[YOLO_EXECUTOR_PARTS];
+        ScanRows rows[YOLO_EXECUTOR_PARTS];
+    };
+
+    template <typename T, typename Key, bool Masked>
+    static void scan_job(void* ctx, int part) {
+        auto* job = static_cast<ScanJob<Key>*>(ctx);
+        job->self->template scan_part<T, Key, Masked>(job->layers, *job->heaps[part], job->rows[part]);
+    }
+
+    template <typename T, typename Key, bool Masked>
+    void scan_part(const LayerScan* layers, Yolo26TopK<Key>& heap, const ScanRows& rows) {
+        if constexpr (Masked) {
+            for (int i = 0; i < 3; i++) scan_layer_masked<T>(layers[i], i, heap, rows.begin[i], rows.end[i]);
+        } else {
+            scan_layers<T>(layers, heap, rows);
+        }
+    }
+
+    /**
+     * @brief Scans the grid into `heap`, split across both cores when an executor runs.
+     * Each part fills its own top-K heap; the worker's keys are then offered to `heap`. Keys are
+     * unique, so the merged heap holds exactly the K best keys of the single-core scan.
+     */
+    template <typename T, typename Key, bool Masked>
+    void scan_grid(const LayerScan* layers, Yolo26TopK<Key>& heap) {
+        bool parallel = executor && executor->is_running();
+        if (exit_hits > 0) {
+            scan_coarse_to_fine<T, Key, Masked>(layers, heap, parallel && !exit_at_cell);
+            return;
+        }
+        scanned_cells = grid_h[0] * grid_w[0] + grid_h[1] * grid_w[1] + grid_h[2] * grid_w[2];
+        if (!parallel) {
+            scan_part<T, Key, Masked>(layers, heap, all_rows());
+            return;
+        }
+        ScanRows parts[YOLO_EXECUTOR_PARTS];
+        split_rows(parts);
+        scan_split<T, Key, Masked>(layers, heap, parts);
+    }
+
+    // Both parts on both cores, the worker's keys merged into `heap`
+    template <typename T, typename Key, bool Masked>
+    void scan_split(const LayerScan* layers, Yolo26TopK<Key>& heap, const ScanRows* parts) {
+        Yolo26TopK<Key>& other = worker_heap<Key>();
+        other.clear();
+        ScanJob<Key> job = {this, layers, {&heap, &other}, {parts[0], parts[1]}};
+        executor->run(scan_job<T, Key, Masked>, &job);
+        for (int i = 0; i < other.size(); i++) heap.push(other.begin()[i]);
+    }
+
+    /**
+     * @brief Early exit: p5, then p4, then p3, stopping after the first layer that leaves
+     * exit_hits keys in the heap. Only p3 is worth splitting across the cores.
+     * Keys are unique, so the layer order does not change which keys a full scan keeps. Ties
+     * do: a finer-layer cell with the K-th best score has the higher key, so in this mode the
+     * scan only rejects cells strictly below the heap (heap_tie_margin()).
+     */
+    // Amount taken off the heap-derived raw threshold. Anchor order: 0, a later cell tying the
+    // K-th score has a lower key. Coarse to fine: 1, the tying cell may rank above the K-th key.
+    int heap_tie_margin() const {
+        return exit_hits > 0 ? 1 : 0;
+    }
+
+    template <typename T, typename Key, bool Masked>
+    void scan_coarse_to_fine(const LayerScan* layers, Yolo26TopK<Key>& heap, bool parallel) {
+        scanned_cells = 0;
+        for (int i = 2; i >= 0; i--) {
+            scanned_cells += grid_h[i] * grid_w[i];
+            if (i == 0 && parallel) {
+                int r = grid_h[0] / 2;
+                ScanRows parts[YOLO_EXECUTOR_PARTS] = {{{0, 0, 0}, {r, 0, 0}}, {{r, 0, 0}, {grid_h[0], 0, 0}}};
+                scan_split<T, Key, Masked>(layers, heap, parts);
+            } else {
+                ScanRows rows = {{0, 0, 0}, {0, 0, 0}};
+                rows.end[i] = grid_h[i];
+                scan_part<T, Key, Masked>(layers, heap, rows);
+            }
+            if (heap.size() >= exit_hits) return;
+        }
+    }
+
+    /**
+     * @brief Picks the key width, runs the scan and decodes the survivors into `out`.
+     * 32-bit keys need int8 logits, an exponent spread of at most YOLO_KEY_MAX_SHIFT and a p3
+     * grid that fits YOLO_KEY_CELL_BITS (true for the shipped models); anything else uses 64-bit keys.
+     * Class rules switch to the masked scan.
+     */
+    template <typename T, typename Out>
+    int select_keys(const LayerScan* layers, Out* out, int capacity) {
+        bool masked = class_filter.active();
+        if (masked) {
+            int exps[3] = {layers[0].cls_exponent, layers[1].cls_exponent, layers[2].cls_exponent};
+            class_filter.prepare(num_classes, std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), exps, scan_conf);
+        }
+        bool narrow = sizeof(T) == 1 && grid_h[0] * grid_w[0] <= (1 << YOLO_KEY_CELL_BITS);
+        for (int i = 0; i < 3; i++) narrow = narrow && layers[i].key_shift <= YOLO_KEY_MAX_SHIFT;
+        if (narrow) return run_keys<T>(layers, topk32, masked, out, capacity);
+        return run_keys<T>(layers, topk64, masked, out, capacity);
+    }
+
+    template <typename T, typename Key, typename Out>
+    int run_keys(const LayerScan* layers, Yolo26TopK<Key>& heap, bool masked, Out* out, int capacity) {
+        heap.clear();
+        if (masked) {
+            scan_grid<T, Key, true>(layers, heap);
+            heap.sort_descending();
+            return decode_keys<T, Key, true>(layers, heap, out, capacity);
+        }
+        scan_grid<T, Key, false>(layers, heap);
+        heap.sort_descending();
+        return decode_keys<T, Key, false>(layers, heap, out, capacity);
+    }
+
+    /**
+     * @brief Decodes sorted keys into detections: class argmax, sigmoid and box, in model pixels.
+     * Drops a key whose score rounds below its class threshold. Without class rules all later
+     * keys rank lower and fail too, so decoding stops there.
+     *
+     * @tparam Masked Class rules active: argmax over allowed classes, per-class threshold
+     */
+    template <typename T, typename Key, bool Masked, typename Out>
+    int decode_keys(const LayerScan* layers, Yolo26TopK<Key>& heap, Out* out, int capacity) {
+        int count = std::min(heap.size(), std::max(capacity, 0));
+        int n = 0;
+        for (int i = 0; i < count; i++) {
+            Key key = heap.begin()[i];
+            int layer_idx, cell;
+            if constexpr (sizeof(Key) == 4) {
+                layer_idx = yolo26_key32_layer(key);
+                cell = yolo26_key32_cell(key);
+            } else {
+                layer_idx = yolo26_key64_layer(key);
+                cell = yolo26_key64_cell(key);
+            }
+            const LayerScan& layer = layers[layer_idx];
+            const int stride = strides[layer_idx];
+            const int grid_cols = grid_w[layer_idx];
+
+            // Integer argmax (sigmoid is monotonic, first maximum wins)
+            const T* cls = (const T*)layer.raw_cls + cell * num_classes;
+            int best_cls_id = 0;
+            T best_raw = cls[0];
+            if constexpr (Masked) {
+                const int* ids = class_filter.get_allowed_ids();
+                best_cls_id = ids[0];
+                best_raw = cls[ids[0]];
+                for (int j = 1; j < class_filter.get_allowed_count(); j++) {
+                    if (cls[ids[j]] > best_raw) {
+                        best_raw = cls[ids[j]];
+                        best_cls_id = ids[j];
+                    }
+                }
+            } else {
+                for (int c = 1; c < num_classes; c++) {
+                    if (cls[c] > best_raw) {
+                        best_raw = cls[c];
+                        best_cls_id = c;
                     }
+                }
+            }
+            float max_score = sigmoid(dequantize_val(best_raw, layer.cls_scale));
+            if constexpr (Masked) {
+                if (max_score < class_filter.get_conf(best_cls_id)) continue;
+            } else {
+                if (max_score < scan_conf) break;
+            }
+
+            // Decode Box
+            const T* ptr = (const T*)layer.raw_box + cell * 4;
+            if constexpr (std::is_same<Out, DetectionQ>::value) {
+                // Integer only: corners from shifts of the raw distances
+                int col2 = 2 * (cell % grid_cols) + 1;
+                int row2 = 2 * (cell / grid_cols) + 1;
+                out[n++] = {q_edge(layer, col2, -ptr[0]), q_edge(layer, row2, -ptr[1]), q_edge(layer, col2, ptr[2]),
+                            q_edge(layer, row2, ptr[3]), yolo26_q_score(max_score), (uint8_t)best_cls_id};
+            } else {
+                float d_l = dequantize_val(ptr[0], layer.box_scale);
+                float d_t = dequantize_val(ptr[1], layer.box_scale);
+                float d_r = dequantize_val(ptr[2], layer.box_scale);
+                float d_b = dequantize_val(ptr[3], layer.box_scale);
+
+                float cx = cell % grid_cols + 0.5f;
+                float cy = cell / grid_cols + 0.5f;
+                out[n++] = {(cx - d_l) * stride, (cy - d_t) * stride, (cx + d_r) * stride, (cy + d_b) * stride,
+                            max_score, best_cls_id};
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief scan_layer() under class rules. A cell's candidate is its best allowed class, kept
+     * if it clears that class's own threshold.
+     *
+     * int8 with many allowed classes: the SWAR test compares each class lane against its own
+     * threshold (disallowed lanes can never pass). Few allowed classes, or int16: only the
+     * allowed logits are read. Runs on the runtime grid; rules are a deployment choice, not a
+     * hot default, so this path is not shape-specialized.
+     */
+    template <typename T, typename Key>
+    void scan_layer_masked(const LayerScan& layer, int layer_idx, Yolo26TopK<Key>& heap, int h_begin, int h_end) {
+        constexpr int t_min = std::numeric_limits<T>::min();
+        constexpr int t_max = std::numeric_limits<T>::max();
+        const int grid_cols = grid_w[layer_idx];
+        const int nc = num_classes;
+        const int vec_classes = (nc / YOLO_SCAN_GROUP) * YOLO_SCAN_GROUP;
+        const T* raw_cls = (const T*)layer.raw_cls;
+        const int32_t* class_thresh = class_filter.get_int_thresh(layer_idx);
+        const int8_t* class_thresh8 = class_filter.get_int8_thresh(layer_idx);
+        const int* ids = class_filter.get_allowed_ids();
+        const int allowed = class_filter.get_allowed_count();
+        const bool sparse = sizeof(T) == 2 || class_filter.is_sparse() || nc > YOLO_MAX_SCAN_CLASSES;
+        if (heap.capacity() == 0 || allowed == 0 || h_begin >= h_end) return;
+
+        // Score floor from the heap (t_min - 1: none yet); SWAR lanes hold max(class, floor).
+        int floor_t = t_min - 1;
+        const int tie = heap_tie_margin();
+        uint32_t lane_words[(YOLO_MAX_SCAN_CLASSES + 3) / 4];
+        auto set_floor = [&]() {
+            if (heap.full() && heap.size() > 0) {
+                float t;
+                if constexpr (sizeof(Key) == 4) {
+                    t = (float)(yolo26_key32_norm(heap.min()) >> layer.key_shift);
+                } else {
+                    t = std::floor(yolo26_key64_logit(heap.min()) * layer.inv_cls_scale);
+                }
+                if (t - tie >= (float)t_max) return false;
+                floor_t = std::max(floor_t, (int)t - tie);
+            }
+            if (!sparse) {
+                int8_t lanes[YOLO_MAX_SCAN_CLASSES];
+                for (int c = 0; c < vec_classes; c++) lanes[c] = (int8_t)std::max((int)class_thresh8[c], floor_t);
+                memcpy(lane_words, lanes, vec_classes);
+            }
+            return true;
+        };
+        if (!set_floor()) return;
+
+        for (int h = h_begin; h < h_end; h++) {
+            for (int w = 0; w < grid_cols; w++) {
+                int pixel_idx = (h * grid_cols) + w; // NHWC
+                const T* cls = raw_cls + pixel_idx * nc;
 
-                    if (max_score < conf_thresh) continue;
-
-                    // Decode Box
-                    int box_offset = pixel_idx * 4;
-                    float d_l, d_t, d_r, d_b;
-
-                    if (dtype == dl::DATA_TYPE_INT8) {
-                        int8_t* ptr = (int8_t*)raw_box;
-                        d_l = dequantize_val(ptr[box_offset + 0], box_scale);
-                        d_t = dequantize_val(ptr[box_offset + 1], box_scale);
-                        d_r = dequantize_val(ptr[box_offset + 2], box_scale);
-                        d_b = dequantize_val(ptr[box_offset + 3], box_scale);
-                    } else {
-                        int16_t* ptr = (int16_t*)raw_box;
-                        d_l = dequantize_val(ptr[box_offset + 0], box_scale);
-                        d_t = dequantize_val(ptr[box_offset + 1], box_scale);
-                        d_r = dequantize_val(ptr[box_offset + 2], box_scale);
-                        d_b = dequantize_val(ptr[box_offset + 3], box_scale);
+                // 1. Reject cells where no allowed class clears its threshold
+                if (!sparse) {
+                    bool any = false;
+                    for (int c = 0; c < vec_classes && !any; c += YOLO_SCAN_GROUP) {
+                        any = yolo26_swar_any_gt_s8_16((const int8_t*)cls + c, lane_words + c / 4);
                     }
+                    for (int c = vec_classes; c < nc && !any; c++) {
+                        any = cls[c] > class_thresh[c] && cls[c] > floor_t;
+                    }
+                    if (!any) continue;
+                }
 
-                    float cx = w + 0.5f;
-                    float cy = h + 0.5f;
-                    float x1 = (cx - d_l) * stride;
-                    float y1 = (cy - d_t) * stride;
-                    float x2 = (cx + d_r) * stride;
-                    float y2 = (cy + d_b) * stride;
+                // 2. Best allowed class, which must clear its own threshold and the heap floor
+                int best_cls_id = ids[0];
+                T best_raw = cls[ids[0]];
+                for (int j = 1; j < allowed; j++) {
+                    if (cls[ids[j]] > best_raw) {
+                        best_raw = cls[ids[j]];
+                        best_cls_id = ids[j];
+                    }
+                }
+                if (best_raw <= class_thresh[best_cls_id] || best_raw <= floor_t) continue;
 
-                    candidates.push_back({x1, y1, x2, y2, max_score, best_cls_id});
+                if constexpr (sizeof(Key) == 4) {
+                    heap.push(yolo26_key32((int)best_raw << layer.key_shift, layer_idx, pixel_idx));
+                } else {
+                    heap.push(yolo26_key64(dequantize_val(best_raw, layer.cls_scale), layer_idx, pixel_idx));
                 }
+                if (exit_at_cell && heap.size() >= exit_hits) return;
+                if (heap.full() && !set_floor()) return;
             }
         }
+    }
 
-        // Global Sort
-        std::sort(candidates.begin(), candidates.end(), [](const Detection& a, const Detection& b) {
-            return a.score > b.score;
-        });
-
-        if (candidates.size() > target_k) {
-            candidates.resize(target_k);
+    /**
+     * @brief Chooses the shape specialization for the scan.
+     * Static processors use their own parameters; the facade routes the shipped
+     * 512x512 and 640x640 COCO models to specialized loops and everything else to the generic ones.
+     */
+    template <typename T, typename Key>
+    void scan_layers(const LayerScan* layers, Yolo26TopK<Key>& heap, const ScanRows& rows) {
+        if constexpr (is_static_shape && NumClasses > 0) {
+            scan_shape<T, Width, Height, NumClasses>(layers, heap, rows);
+        } else {
+            if (num_classes == 80 && grid_w[0] == 512 / 8 && grid_h[0] == 512 / 8) {
+                scan_shape<T, 512, 512, 80>(layers, heap, rows);
+            } else if (num_classes == 80 && grid_w[0] == 640 / 8 && grid_h[0] == 640 / 8) {
+                scan_shape<T, 640, 640, 80>(layers, heap, rows);
+            } else {
+                scan_shape<T, 0, 0, 0>(layers, heap, rows);
+            }
         }
+    }
+
+    template <typename T, int W, int H, int NC, typename Key>
+    void scan_shape(const LayerScan* layers, Yolo26TopK<Key>& heap, const ScanRows& rows) {
+        scan_layer<T, 0, W / 8, NC>(layers[0], heap, rows.begin[0], rows.end[0]);
+        scan_layer<T, 1, W / 16, NC>(layers[1], heap, rows.begin[1], rows.end[1]);
+        scan_layer<T, 2, W / 32, NC>(layers[2], heap, rows.begin[2], rows.end[2]);
+    }
+
+    /**
+     * @brief Scans grid rows [h_begin, h_end) of one stride layer and offers the key of each
+     * passing cell to the top-K heap.
+     *
+     * @tparam T Raw tensor element type (int8_t or int16_t)
+     * @tparam Layer Stride layer index (0 = p3, 1 = p4, 2 = p5)
+     * @tparam GW Grid width (0 = use the runtime grid)
+     * @tparam NC Class count (0 = use the runtime count)
+     * @tparam Key uint32_t or uint64_t, see select_keys()
+     */
+    template <typename T, int Layer, int GW, int NC, typename Key>
+    void scan_layer(const LayerScan& layer, Yolo26TopK<Key>& heap, int h_begin, int h_end) {
+        constexpr int t_min = std::numeric_limits<T>::min();
+        constexpr int t_max = std::numeric_limits<T>::max();
+        const int grid_cols = GW > 0 ? GW : grid_w[Layer];
+        const int nc = NC > 0 ? NC : num_classes;
+        const int vec_classes = (nc / YOLO_SCAN_GROUP) * YOLO_SCAN_GROUP;
+
+        const T* raw_cls = (const T*)layer.raw_cls;
+
+        // Values at or below t_min always fail; a threshold above t_max rejects everything.
+        T thresh = 0;
+        uint32_t thresh_words[YOLO_SCAN_GROUP / 4]; // Broadcast threshold for the SWAR compare (int8 only)
+        auto set_thresh = [&](float t) {
+            if (t >= (float)t_max) return false;
+            thresh = (T)std::max((float)t_min, t);
+            int8_t thresh_bytes[YOLO_SCAN_GROUP];
+            memset(thresh_bytes, (int8_t)thresh, sizeof(thresh_bytes));
+            yolo26_swar_pack_thresh(thresh_bytes, YOLO_SCAN_GROUP, thresh_words);
+            return true;
+        };
+        // Early reject: a full heap only accepts logits above its K-th best (a later cell with an
+        // equal score has a lower key). raw > floor(kth / scale)  <=>  raw * scale > kth
+        // Coarse to fine, equal scores are kept too (heap_tie_margin()).
+        const int tie = heap_tie_margin();
+        auto heap_thresh = [&]() {
+            float t = layer.int_thresh;
+            if (heap.full() && heap.size() > 0) {
+                if constexpr (sizeof(Key) == 4) {
+                    t = std::max(t, (float)((yolo26_key32_norm(heap.min()) >> layer.key_shift) - tie)); // Arithmetic shift floors
+                } else {
+                    t = std::max(t, std::floor(yolo26_key64_logit(heap.min()) * layer.inv_cls_scale) - tie);
+                }
+            }
+            return t;
+        };
+        if (heap.capacity() == 0 || h_begin >= h_end || !set_thresh(heap_thresh())) return;
+
+        for (int h = h_begin; h < h_end; h++) {
+            for (int w = 0; w < grid_cols; w++) {
+                int pixel_idx = (h * grid_cols) + w; // NHWC
+                const T* cls = raw_cls + pixel_idx * nc;
+
+                // 1. Reject background cells without per-class work
+                bool any = false;
+                if constexpr (sizeof(T) == 1) {
+                    for (int c = 0; c < vec_classes && !any; c += YOLO_SCAN_GROUP) {
+                        any = yolo26_swar_any_gt_s8_16((const int8_t*)cls + c, thresh_words);
+                    }
+                    for (int c = vec_classes; c < nc && !any; c++) {
+                        any = cls[c] > thresh;
+                    }
+                } else {
+                    for (int c = 0; c < nc && !any; c++) {
+                        any = cls[c] > thresh;
+                    }
+                }
+                if (!any) continue;
+
+                // 2. Max logit only: argmax, sigmoid and the box wait until the cell survives top-K
+                T best_raw = cls[0];
+                for (int c = 1; c < nc; c++) best_raw = std::max(best_raw, cls[c]);
 
-        return candidates;
+                if constexpr (sizeof(Key) == 4) {
+                    heap.push(yolo26_key32((int)best_raw << layer.key_shift, Layer, pixel_idx));
+                } else {
+                    heap.push(yolo26_key64(dequantize_val(best_raw, layer.cls_scale), Layer, pixel_idx));
+                }
+                if (exit_at_cell && heap.size() >= exit_hits) return; // query_presence()
+                // K-th best moved up (or the heap just filled): tighten the scan threshold
+                if (heap.full() && !set_thresh(heap_thresh())) return;
+            }
+        }
     }
 };
@@ -0,0 +1,202 @@
+#pragma once
+#include "sdkconfig.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "dl_model_base.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+
+// Default Profiler Configuration
+#define YOLO_PROFILE_WINDOW 128      // Rolling samples kept per stage for percentiles
+#define YOLO_PROFILE_MAX_LAYERS 16   // Slowest modules kept from a per-layer capture
+#define YOLO_PROFILE_NAME_LEN 32
+
+enum Yolo26Stage {
+    YOLO_STAGE_DECODE = 0,
+    YOLO_STAGE_RESIZE,
+    YOLO_STAGE_PREPROCESS,
+    YOLO_STAGE_INFERENCE,
+    YOLO_STAGE_POSTPROCESS,
+    YOLO_STAGE_FUSED,        // decode_preprocess_jpeg(): decode + resize + preprocess in one pass
+    YOLO_STAGE_COUNT,
+};
+
+inline const char* yolo26_stage_name(Yolo26Stage stage) {
+    static const char* names[YOLO_STAGE_COUNT] = {"decode", "resize", "preprocess", "inference", "postprocess", "fused"};
+    return stage < YOLO_STAGE_COUNT ? names[stage] : "?";
+}
+
+/**
+ * @brief Rolling latency statistics of one stage.
+ * min/mean/max cover every sample since reset(); percentiles cover the last YOLO_PROFILE_WINDOW.
+ */
+struct Yolo26StageProfile {
+    uint32_t window[YOLO_PROFILE_WINDOW]; // Microseconds, ring buffer
+    uint32_t count = 0;
+    uint32_t min_us = UINT32_MAX;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+    uint64_t total_cycles = 0;
+
+    void add(uint32_t us, uint32_t cycles) {
+        window[count % YOLO_PROFILE_WINDOW] = us;
+        count++;
+        min_us = std::min(min_us, us);
+        max_us = std::max(max_us, us);
+        total_us += us;
+        total_cycles += cycles;
+    }
+
+    /**
+     * @brief Nearest-rank percentile over the rolling window. `scratch` holds YOLO_PROFILE_WINDOW entries.
+     */
+    uint32_t percentile(int pct, uint32_t* scratch) const {
+        int n = (int)std::min<uint32_t>(count, YOLO_PROFILE_WINDOW);
+        if (n == 0) return 0;
+        memcpy(scratch, window, n * sizeof(uint32_t));
+        int rank = std::min(n - 1, std::max(0, (pct * n + 99) / 100 - 1));
+        std::nth_element(scratch, scratch + rank, scratch + n);
+        return scratch[rank];
+    }
+};
+
+struct Yolo26LayerProfile {
+    char name[YOLO_PROFILE_NAME_LEN];
+    char type[YOLO_PROFILE_NAME_LEN];
+    int64_t latency_us;
+};
+
+/**
+ * @brief Microsecond stage profiler (esp_timer) with CPU cycle counts.
+ *
+ * Stages are timed with Yolo26ProfileScope or begin()/end(). Each stage is written by a
+ * single task; print_json() may run anywhere. Nothing is allocated after construction.
+ * Emission is one JSON line per report, prefixed with "YOLO_PROF " so a host script can pick
+ * it out of the monitor log and diff runs (e.g. the 512 vs 640 model).
+ */
+class Yolo26Profiler {
+private:
+    Yolo26StageProfile stages[YOLO_STAGE_COUNT];
+    int64_t start_us[YOLO_STAGE_COUNT] = {};
+    uint32_t start_cycles[YOLO_STAGE_COUNT] = {};
+
+    Yolo26LayerProfile layers[YOLO_PROFILE_MAX_LAYERS];
+    int layer_count = 0;
+    int64_t layer_total_us = 0;
+
+public:
+    void begin(Yolo26Stage stage) {
+        start_cycles[stage] = (uint32_t)esp_cpu_get_cycle_count();
+        start_us[stage] = esp_timer_get_time();
+    }
+
+    /**
+     * @return Duration of the stage in microseconds
+     */
+    uint32_t end(Yolo26Stage stage) {
+        uint32_t us = (uint32_t)(esp_timer_get_time() - start_us[stage]);
+        uint32_t cycles = (uint32_t)esp_cpu_get_cycle_count() - start_cycles[stage]; // Wraps after ~12 s at 360 MHz
+        stages[stage].add(us, cycles);
+        return us;
+    }
+
+    void reset() {
+        for (auto& s : stages) s = Yolo26StageProfile();
+        layer_count = 0;
+        layer_total_us = 0;
+    }
+
+    const Yolo26StageProfile& get(Yolo26Stage stage) const { return stages[stage]; }
+
+    /**
+     * @brief Captures per-module latencies through esp-dl's module profiling.
+     * The model runs once more inside get_module_info(), so call it outside timed loops.
+     * Keeps the YOLO_PROFILE_MAX_LAYERS slowest modules.
+     */
+    void capture_layers(dl::Model* model) {
+        std::map<std::string, dl::module_info> info = model->get_module_info();
+        layer_count = 0;
+        layer_total_us = 0;
+        for (const auto& kv : info) {
+            layer_total_us += kv.second.latency;
+            int slot = layer_count;
+            if (layer_count == YOLO_PROFILE_MAX_LAYERS) {
+                // Replace the fastest kept module if this one is slower.
+                slot = 0;
+                for (int i = 1; i < layer_count; i++) {
+                    if (layers[i].latency_us < layers[slot].latency_us) slot = i;
+                }
+                if (layers[slot].latency_us >= kv.second.latency) continue;
+            } else {
+                layer_count++;
+            }
+            Yolo26LayerProfile& l = layers[slot];
+            snprintf(l.name, sizeof(l.name), "%s", kv.first.c_str());
+            snprintf(l.type, sizeof(l.type), "%s", kv.second.type.c_str());
+            l.latency_us = kv.second.latency;
+        }
+        std::sort(layers, layers + layer_count,
+                  [](const Yolo26LayerProfile& a, const Yolo26LayerProfile& b) { return a.latency_us > b.latency_us; });
+    }
+
+    /**
+     * @brief Prints one machine-readable record:
+     * YOLO_PROF {"tag":..,"stages":{"decode":{"n":,"min":,"mean":,"p50":,"p95":,"p99":,"max":,"cyc":},..},"layers":[..]}
+     * Times in microseconds; "cyc" is mean CPU cycles.
+     */
+    void print_json(const char* tag) const {
+        uint32_t scratch[YOLO_PROFILE_WINDOW];
+        printf("YOLO_PROF {\"tag\":\"%s\",\"stages\":{", tag);
+        bool first = true;
+        for (int i = 0; i < YOLO_STAGE_COUNT; i++) {
+            const Yolo26StageProfile& s = stages[i];
+            if (s.count == 0) continue;
+            printf("%s\"%s\":{\"n\":%lu,\"min\":%lu,\"mean\":%llu,\"p50\":%lu,\"p95\":%lu,\"p99\":%lu,\"max\":%lu,\"cyc\":%llu}",
+                   first ? "" : ",", yolo26_stage_name((Yolo26Stage)i), (unsigned long)s.count,
+                   (unsigned long)s.min_us, (unsigned long long)(s.total_us / s.count),
+                   (unsigned long)s.percentile(50, scratch), (unsigned long)s.percentile(95, scratch),
+                   (unsigned long)s.percentile(99, scratch), (unsigned long)s.max_us,
+                   (unsigned long long)(s.total_cycles / s.count));
+            first = false;
+        }
+        printf("},\"layers_total\":%lld,\"layers\":[", (long long)layer_total_us);
+        for (int i = 0; i < layer_count; i++) {
+            printf("%s{\"name\":\"%s\",\"type\":\"%s\",\"us\":%lld}", i ? "," : "",
+                   layers[i].name, layers[i].type, (long long)layers[i].latency_us);
+        }
+        printf("]}\n");
+    }
+
+    /**
+     * @brief Human-readable summary of the stage table.
+     */
+    void print_summary() const {
+        uint32_t scratch[YOLO_PROFILE_WINDOW];
+        printf("  %-11s %6s %9s %9s %9s %9s %9s\n", "stage", "n", "min us", "mean us", "p95 us", "p99 us", "max us");
+        for (int i = 0; i < YOLO_STAGE_COUNT; i++) {
+            const Yolo26StageProfile& s = stages[i];
+            if (s.count == 0) continue;
+            printf("  %-11s %6lu %9lu %9llu %9lu %9lu %9lu\n", yolo26_stage_name((Yolo26Stage)i),
+                   (unsigned long)s.count, (unsigned long)s.min_us, (unsigned long long)(s.total_us / s.count),
+                   (unsigned long)s.percentile(95, scratch), (unsigned long)s.percentile(99, scratch),
+                   (unsigned long)s.max_us);
+        }
+    }
+};
+
+/**
+ * @brief Times the enclosing scope as one sample of `stage`.
+ */
+class Yolo26ProfileScope {
+private:
+    Yolo26Profiler& profiler;
+    Yolo26Stage stage;
+
+public:
+    Yolo26ProfileScope(Yolo26Profiler& p, Yolo26Stage s) : profiler(p), stage(s) { profiler.begin(stage); }
+    ~Yolo26ProfileScope() { profiler.end(stage); }
+};
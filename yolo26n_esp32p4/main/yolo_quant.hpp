@@ -0,0 +1,142 @@
+#pragma once
+#include "sdkconfig.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+
+// Input quantization kernels (uint8 pixel -> int8, exponent -7).
+//
+// The LUT value round(p * 128 / 255) (clamped to 127) is exactly min(p + 1, 255) >> 1
+// for every p in [0, 255]: for even p the p/510 term never reaches 0.5, for odd p it
+// always pushes past it. That is a saturating add and a shift, which vectorizes cleanly.
+
+#if CONFIG_IDF_TARGET_ESP32P4 && CONFIG_YOLO_QUANT_PIE
+#define YOLO_QUANT_HAS_PIE 1
+// yolo_quant_esp32p4.S: 16 bytes per iteration, src and dst 16-byte aligned.
+extern "C" void yolo26_quantize_u8_pie(const uint8_t* src, int8_t* dst, int blocks);
+#else
+#define YOLO_QUANT_HAS_PIE 0
+#endif
+
+enum Yolo26QuantKernel {
+    YOLO_QUANT_KERNEL_LUT = 0,  // Scalar table lookup (reference)
+    YOLO_QUANT_KERNEL_SWAR,     // 4 bytes per 32-bit word, portable
+    YOLO_QUANT_KERNEL_PIE,      // ESP32-P4 PIE 128-bit vectors
+};
+
+typedef void (*Yolo26QuantizeFn)(const uint8_t* src, int8_t* dst, size_t n, const int8_t* lut);
+
+inline const char* yolo26_quant_kernel_name(Yolo26QuantKernel kernel) {
+    switch (kernel) {
+        case YOLO_QUANT_KERNEL_PIE: return "pie";
+        case YOLO_QUANT_KERNEL_SWAR: return "swar";
+        default: return "lut";
+    }
+}
+
+inline void yolo26_quantize_lut(const uint8_t* src, int8_t* dst, size_t n, const int8_t* lut) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+/**
+ * @brief Quantizes 4 packed pixels: per byte (x >> 1) + (x & 1), minus 1 where x == 0xFF.
+ */
+inline uint32_t yolo26_quantize_word(uint32_t x) {
+    uint32_t half = (x >> 1) & 0x7F7F7F7Fu;
+    uint32_t odd = x & 0x01010101u;
+    // High bit of ((x & 0x7F) + 1) is set only when the low 7 bits are all ones (no cross-byte carry).
+    uint32_t is_ff = ((((x & 0x7F7F7F7Fu) + 0x01010101u) & x) >> 7) & 0x01010101u;
+    return half + odd - is_ff;
+}
+
+inline void yolo26_quantize_swar(const uint8_t* src, int8_t* dst, size_t n, const int8_t* lut) {
+    size_t i = 0;
+    // Align the destination so the word stores are aligned.
+    for (; i < n && ((uintptr_t)(dst + i) & 3); i++) {
+        dst[i] = lut[src[i]];
+    }
+    for (; i + 16 <= n; i += 16) {
+        uint32_t w[4];
+        memcpy(w, src + i, sizeof(w));
+        w[0] = yolo26_quantize_word(w[0]);
+        w[1] = yolo26_quantize_word(w[1]);
+        w[2] = yolo26_quantize_word(w[2]);
+        w[3] = yolo26_quantize_word(w[3]);
+        memcpy(dst + i, w, sizeof(w));
+    }
+    for (; i + 4 <= n; i += 4) {
+        uint32_t w;
+        memcpy(&w, src + i, sizeof(w));
+        w = yolo26_quantize_word(w);
+        memcpy(dst + i, &w, sizeof(w));
+    }
+    for (; i < n; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+#if YOLO_QUANT_HAS_PIE
+inline void yolo26_quantize_pie(const uint8_t* src, int8_t* dst, size_t n, const int8_t* lut) {
+    // Vector loads/stores ignore the low 4 address bits, so both pointers must share alignment.
+    if (((uintptr_t)src ^ (uintptr_t)dst) & 15) {
+        yolo26_quantize_swar(src, dst, n, lut);
+        return;
+    }
+    size_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+    if (head > n) head = n;
+    yolo26_quantize_lut(src, dst, head, lut);
+
+    size_t blocks = (n - head) / 16;
+    if (blocks) {
+        yolo26_quantize_u8_pie(src + head, dst + head, (int)blocks);
+    }
+    size_t done = head + blocks * 16;
+    yolo26_quantize_lut(src + done, dst + done, n - done, lut);
+}
+#endif
+
+/**
+ * @brief Bit-exact comparison of a kernel against the LUT.
+ * Covers all 256 values at every alignment offset and odd lengths (head/tail paths).
+ */
+inline bool yolo26_quant_self_test(Yolo26QuantizeFn fn, const int8_t* lut) {
+    alignas(16) uint8_t src[256 + 48];
+    alignas(16) int8_t expected[256 + 48];
+    alignas(16) int8_t actual[256 + 48];
+
+    for (int offset = 0; offset < 20; offset++) {
+        size_t n = 256 + (offset * 7) % 29;
+        for (size_t i = 0; i < n; i++) {
+            src[offset + i] = (uint8_t)(i * 167 + offset); // 167 is odd: every value once per 256
+        }
+        yolo26_quantize_lut(src + offset, expected + offset, n, lut);
+        memset(actual, 0x55, sizeof(actual));
+        fn(src + offset, actual + offset, n, lut);
+        if (memcmp(expected + offset, actual + offset, n) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Picks the fastest kernel that passes the self-test (PIE -> SWAR -> LUT).
+ */
+inline Yolo26QuantKernel yolo26_select_quant_kernel(const int8_t* lut, Yolo26QuantizeFn* fn) {
+#if YOLO_QUANT_HAS_PIE
+    if (yolo26_quant_self_test(yolo26_quantize_pie, lut)) {
+        *fn = yolo26_quantize_pie;
+        return YOLO_QUANT_KERNEL_PIE;
+    }
+    printf("[Yolo26Processor] Warning: PIE quantize kernel failed self-test, falling back\n");
+#endif
+    if (yolo26_quant_self_test(yolo26_quantize_swar, lut)) {
+        *fn = yolo26_quantize_swar;
+        return YOLO_QUANT_KERNEL_SWAR;
+    }
+    *fn = yolo26_quantize_lut;
+    return YOLO_QUANT_KERNEL_LUT;
+}
@@ -0,0 +1,309 @@
+#pragma once
+#include "dl_tensor_base.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Raw tensor recordings (.y26t).
+//
+// One record holds a set of named tensors exactly as the model produced them (raw integers
+// plus exponent), e.g. the six one2one_p*_box / one2one_p*_cls outputs of one frame. A file
+// is a sequence of records, so a capture session can be appended frame by frame and replayed
+// record by record on the host. All fields are little endian (ESP32-P4 and x86 alike).
+//
+//   record  "Y26T" | u16 version | u16 tensor count
+//   tensor  u8 name length | name | u8 dtype | i8 exponent | u8 ndim | i32 dims[ndim] | u32 bytes | data
+//
+// Streams that may be interleaved with other bytes (a UART shared with the console log) wrap
+// each record in a frame, which a reader can find again after garbage:
+//
+//   frame   "Y26F" | u32 sequence | u32 time (ms) | u32 record bytes | record | u32 CRC-32 of record
+
+#define YOLO_RECORD_MAGIC "Y26T"
+#define YOLO_RECORD_VERSION 1
+#define YOLO_RECORD_MAX_DIMS 4
+#define YOLO_RECORD_MAX_TENSORS 16
+#define YOLO_FRAME_MAGIC "Y26F"
+#define YOLO_FRAME_MAX_BYTES (16u << 20) // Sanity bound on a frame's record length
+
+// Element type codes (stable on disk, independent of esp-dl's enum values)
+enum Yolo26RecordDType : uint8_t {
+    YOLO_RECORD_INT8 = 1,
+    YOLO_RECORD_INT16 = 2,
+    YOLO_RECORD_FLOAT32 = 3,
+};
+
+struct Yolo26FrameHeader {
+    char magic[4];
+    uint32_t seq;
+    uint32_t time_ms;
+    uint32_t length; // Record bytes following the header; the CRC-32 comes after them
+};
+static_assert(sizeof(Yolo26FrameHeader) == 16, "Frame header is packed on disk");
+
+typedef std::map<std::string, dl::TensorBase*> Yolo26TensorMap;
+
+inline bool yolo26_record_dtype(dl::dtype_t dtype, uint8_t* code) {
+    switch (dtype) {
+        case dl::DATA_TYPE_INT8: *code = YOLO_RECORD_INT8; return true;
+        case dl::DATA_TYPE_INT16: *code = YOLO_RECORD_INT16; return true;
+        case dl::DATA_TYPE_FLOAT: *code = YOLO_RECORD_FLOAT32; return true;
+        default: return false;
+    }
+}
+
+inline bool yolo26_tensor_dtype(uint8_t code, dl::dtype_t* dtype, int* elem_bytes) {
+    switch (code) {
+        case YOLO_RECORD_INT8: *dtype = dl::DATA_TYPE_INT8; *elem_bytes = 1; return true;
+        case YOLO_RECORD_INT16: *dtype = dl::DATA_TYPE_INT16; *elem_bytes = 2; return true;
+        case YOLO_RECORD_FLOAT32: *dtype = dl::DATA_TYPE_FLOAT; *elem_bytes = 4; return true;
+        default: return false;
+    }
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as zlib / Python's zlib.crc32). Chain calls by passing the previous result.
+ */
+inline uint32_t yolo26_crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    struct Table {
+        uint32_t v[256];
+        Table() {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                v[i] = c;
+            }
+        }
+    };
+    static const Table table; // Built on first use
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) crc = table.v[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/**
+ * @brief Serializes one record of `tensors` (plus `extra`, e.g. the input map) through `put`.
+ * `put(const void*, size_t)` returns false to abort.
+ */
+template <typename Put>
+bool yolo26_record_emit(const Yolo26TensorMap& tensors, const Yolo26TensorMap* extra, Put&& put) {
+    size_t total = tensors.size() + (extra ? extra->size() : 0);
+    if (total > YOLO_RECORD_MAX_TENSORS) return false;
+    uint16_t version = YOLO_RECORD_VERSION;
+    uint16_t count = (uint16_t)total;
+    if (!put(YOLO_RECORD_MAGIC, 4) || !put(&version, 2) || !put(&count, 2)) return false;
+
+    for (const Yolo26TensorMap* map : {&tensors, extra}) {
+        if (!map) continue;
+        for (const auto& kv : *map) {
+            dl::TensorBase* t = kv.second;
+            uint8_t code;
+            if (kv.first.size() > 255 || t->shape.size() > YOLO_RECORD_MAX_DIMS || !yolo26_record_dtype(t->dtype, &code)) {
+                printf("[Yolo26Record] Error: Cannot record tensor '%s'\n", kv.first.c_str());
+                return false;
+            }
+            uint8_t name_len = (uint8_t)kv.first.size();
+            int8_t exponent = (int8_t)t->exponent;
+            uint8_t ndim = (uint8_t)t->shape.size();
+            int32_t dims[YOLO_RECORD_MAX_DIMS];
+            for (int i = 0; i < ndim; i++) dims[i] = t->shape[i];
+            uint32_t bytes = (uint32_t)t->get_bytes();
+
+            if (!put(&name_len, 1) || !put(kv.first.data(), name_len) || !put(&code, 1) || !put(&exponent, 1) ||
+                !put(&ndim, 1) || !put(dims, ndim * sizeof(int32_t)) || !put(&bytes, 4) || !put(t->data, bytes)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Serialized size of one record, in bytes.
+ */
+inline size_t yolo26_record_size(const Yolo26TensorMap& tensors, const Yolo26TensorMap* extra = nullptr) {
+    size_t n = 0;
+    bool ok = yolo26_record_emit(tensors, extra, [&](const void*, size_t len) {
+        n += len;
+        return true;
+    });
+    return ok ? n : 0;
+}
+
+/**
+ * @brief Serializes one record into `dst`.
+ * @return Bytes written, 0 if it does not fit or a tensor cannot be recorded
+ */
+inline size_t yolo26_record_serialize(const Yolo26TensorMap& tensors, const Yolo26TensorMap* extra, uint8_t* dst, size_t capacity) {
+    size_t n = 0;
+    bool ok = yolo26_record_emit(tensors, extra, [&](const void* src, size_t len) {
+        if (n + len > capacity) return false;
+        memcpy(dst + n, src, len);
+        n += len;
+        return true;
+    });
+    return ok ? n : 0;
+}
+
+/**
+ * @brief Completes a frame in place: `buf` holds a serialized record at
+ * buf + sizeof(Yolo26FrameHeader) and 4 spare bytes after it for the CRC.
+ * @return Total frame bytes
+ */
+inline size_t yolo26_frame_finish(uint8_t* buf, size_t record_len, uint32_t seq, uint32_t time_ms) {
+    Yolo26FrameHeader h;
+    memcpy(h.magic, YOLO_FRAME_MAGIC, 4);
+    h.seq = seq;
+    h.time_ms = time_ms;
+    h.length = (uint32_t)record_len;
+    memcpy(buf, &h, sizeof(h));
+    uint8_t* record = buf + sizeof(h);
+    uint32_t crc = yolo26_crc32(0, record, record_len);
+    memcpy(record + record_len, &crc, 4);
+    return sizeof(h) + record_len + 4;
+}
+
+/**
+ * @brief Appends one record holding every tensor of `tensors` to `f`.
+ * Works with any stdio stream: a file on SD card / SPIFFS on the device, a file on the host.
+ * @return false on an unsupported tensor or a write error
+ */
+inline bool yolo26_record_write(FILE* f, const Yolo26TensorMap& tensors, const Yolo26TensorMap* extra = nullptr) {
+    if (!f) return false;
+    bool ok = yolo26_record_emit(tensors, extra, [&](const void* src, size_t len) {
+        return len == 0 || fwrite(src, 1, len, f) == len;
+    });
+    if (!ok) printf("[Yolo26Record] Error: Write failed\n");
+    return ok;
+}
+
+/**
+ * @brief One record read back from a .y26t stream or a framed capture. Owns its tensors.
+ *
+ * get() returns a map shaped like model->get_outputs(), so a recording feeds
+ * Yolo26Processor::postprocess() directly.
+ */
+class Yolo26Recording {
+private:
+    std::vector<std::unique_ptr<dl::TensorBase>> owned;
+    Yolo26TensorMap tensors;
+    std::vector<uint8_t> frame_buf;
+    uint32_t frame_seq = 0;
+    uint32_t frame_time_ms = 0;
+
+    bool fail(const char* what) {
+        printf("[Yolo26Record] Error: %s\n", what);
+        owned.clear();
+        tensors.clear();
+        return false;
+    }
+
+    // `read(void*, size_t)` returns false on a short read.
+    template <typename Read>
+    bool parse(Read&& read) {
+        owned.clear();
+        tensors.clear();
+
+        char magic[4];
+        uint16_t version, count;
+        if (!read(magic, 4)) return false; // Clean end of stream
+        if (memcmp(magic, YOLO_RECORD_MAGIC, 4) != 0 || !read(&version, 2) || !read(&count, 2)) {
+            return fail("Not a tensor record");
+        }
+        if (version != YOLO_RECORD_VERSION || count > YOLO_RECORD_MAX_TENSORS) {
+            return fail("Unsupported record version or tensor count");
+        }
+
+        std::vector<uint8_t> data;
+        for (int i = 0; i < count; i++) {
+            uint8_t name_len, code, ndim;
+            int8_t exponent;
+            char name[256];
+            int32_t dims[YOLO_RECORD_MAX_DIMS];
+            uint32_t bytes;
+            dl::dtype_t dtype;
+            int elem_bytes;
+            bool ok = read(&name_len, 1) && read(name, name_len) && read(&code, 1) && read(&exponent, 1) &&
+                      read(&ndim, 1) && ndim <= YOLO_RECORD_MAX_DIMS && read(dims, ndim * sizeof(int32_t)) &&
+                      read(&bytes, 4) && yolo26_tensor_dtype(code, &dtype, &elem_bytes);
+
+            std::vector<int> shape(dims, dims + (ok ? ndim : 0));
+            size_t elems = 1;
+            for (int d : shape) elems *= (size_t)(d > 0 ? d : 0);
+            if (!ok || elems * elem_bytes != bytes) return fail("Malformed tensor");
+            data.resize(bytes);
+            if (!read(data.data(), bytes)) return fail("Truncated tensor data");
+            owned.emplace_back(new dl::TensorBase(shape, data.data(), exponent, dtype));
+            tensors[std::string(name, name_len)] = owned.back().get();
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @brief Reads the next record of a .y26t stream, replacing the current contents.
+     * @return false at end of stream or on a malformed record
+     */
+    bool read(FILE* f) {
+        return parse([&](void* dst, size_t len) { return len == 0 || fread(dst, 1, len, f) == len; });
+    }
+
+    /**
+     * @brief Parses one record from memory.
+     */
+    bool read(const uint8_t* data, size_t len) {
+        size_t pos = 0;
+        return parse([&](void* dst, size_t n) {
+            if (pos + n > len) return false;
+            memcpy(dst, data + pos, n);
+            pos += n;
+            return true;
+        });
+    }
+
+    /**
+     * @brief Reads the next framed record of a capture stream, skipping any bytes between frames
+     * (console log text) and frames whose CRC does not match.
+     * @return false at end of stream
+     */
+    bool read_frame(FILE* f) {
+        uint32_t window = 0;
+        uint32_t magic;
+        memcpy(&magic, YOLO_FRAME_MAGIC, 4);
+        int seen = 0;
+        for (int c; (c = fgetc(f)) != EOF;) {
+            window = (window >> 8) | ((uint32_t)c << 24); // Little endian: last 4 bytes read
+            if (++seen < 4 || window != magic) continue;
+
+            Yolo26FrameHeader h;
+            uint32_t crc;
+            memcpy(h.magic, YOLO_FRAME_MAGIC, 4);
+            if (fread(&h.seq, 4, 3, f) != 3) return false;
+            if (h.length > YOLO_FRAME_MAX_BYTES) {
+                seen = 0;
+                continue; // Magic bytes inside log text or payload: keep scanning
+            }
+            frame_buf.resize(h.length);
+            if (fread(frame_buf.data(), 1, h.length, f) != h.length || fread(&crc, 4, 1, f) != 1) return false;
+            if (yolo26_crc32(0, frame_buf.data(), h.length) != crc) {
+                printf("[Yolo26Record] Warning: Frame %lu failed CRC, skipped\n", (unsigned long)h.seq);
+                seen = 0;
+                continue;
+            }
+            frame_seq = h.seq;
+            frame_time_ms = h.time_ms;
+            if (read(frame_buf.data(), h.length)) return true;
+            seen = 0;
+        }
+        return false;
+    }
+
+    const Yolo26TensorMap& get() const { return tensors; }
+    bool empty() const { return tensors.empty(); }
+    uint32_t get_frame_seq() const { return frame_seq; }         // Last read_frame() only
+    uint32_t get_frame_time_ms() const { return frame_time_ms; }
+};
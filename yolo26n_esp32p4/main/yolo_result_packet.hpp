@@ -0,0 +1,123 @@
+#pragma once
+#include "dl_image_define.hpp"
+#include "yolo_processor.hpp"
+#include "yolo_record.hpp"
+#include <cstdint>
+#include <cstring>
+
+// Detection result packets (.y26r).
+//
+// One packet carries the detections of one frame as DetectionQ (10 bytes each, corners in
+// 1/4 source pixels) and an optional thumbnail, sized for a single UDP datagram or MQTT /
+// WebSocket message. All fields are little endian.
+//
+//   packet  header (28 B) | count x DetectionQ | thumbnail | u32 CRC-32 of everything before
+//   header  "Y26R" | u8 version | u8 thumb format | u16 count | u32 sequence | u32 time (ms)
+//           | u16 frame w | u16 frame h | u16 thumb w | u16 thumb h | u32 thumb bytes
+//
+// Sequence numbers count published frames, so a receiver sees frames superseded on a slow
+// link as gaps.
+
+#define YOLO_RESULT_MAGIC "Y26R"
+#define YOLO_RESULT_VERSION 1
+
+// Thumbnail encoding (stable on the wire)
+enum Yolo26ThumbFormat : uint8_t {
+    YOLO_THUMB_NONE = 0,
+    YOLO_THUMB_RGB565 = 1, // Little endian, row-major, thumb_w * thumb_h * 2 bytes
+    YOLO_THUMB_JPEG = 2,
+};
+
+struct Yolo26ResultHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t thumb_format; // Yolo26ThumbFormat
+    uint16_t count;
+    uint32_t seq;
+    uint32_t time_ms;
+    uint16_t frame_w; // Source frame the boxes refer to (0: model pixels)
+    uint16_t frame_h;
+    uint16_t thumb_w;
+    uint16_t thumb_h;
+    uint32_t thumb_bytes;
+};
+static_assert(sizeof(Yolo26ResultHeader) == 28, "Result header is packed on the wire");
+
+/**
+ * @brief Packet bytes for `count` detections and a `thumb_bytes` thumbnail.
+ */
+inline size_t yolo26_result_packet_size(int count, size_t thumb_bytes) {
+    return sizeof(Yolo26ResultHeader) + (size_t)count * sizeof(DetectionQ) + thumb_bytes + 4;
+}
+
+/**
+ * @brief Where the detections of a packet being built go: postprocess_into() can write there directly.
+ */
+inline DetectionQ* yolo26_result_detections(uint8_t* packet) {
+    return reinterpret_cast<DetectionQ*>(packet + sizeof(Yolo26ResultHeader));
+}
+
+/**
+ * @brief Completes a packet whose detections are already in place: writes the header from
+ * `h` (count and thumbnail fields included) and the CRC. The thumbnail, if any, must follow
+ * the `h.count` detections.
+ * @return Packet bytes
+ */
+inline size_t yolo26_result_finish(uint8_t* packet, const Yolo26ResultHeader& h) {
+    Yolo26ResultHeader out = h;
+    memcpy(out.magic, YOLO_RESULT_MAGIC, 4);
+    out.version = YOLO_RESULT_VERSION;
+    memcpy(packet, &out, sizeof(out));
+    size_t body = yolo26_result_packet_size(h.count, h.thumb_bytes) - 4;
+    uint32_t crc = yolo26_crc32(0, packet, body);
+    memcpy(packet + body, &crc, 4);
+    return body + 4;
+}
+
+/**
+ * @brief A received packet. Pointers refer into the packet bytes.
+ */
+struct Yolo26ResultView {
+    Yolo26ResultHeader header;
+    const DetectionQ* detections;
+    const uint8_t* thumbnail; // nullptr without one
+};
+
+/**
+ * @brief Validates a packet (magic, version, lengths, CRC) and points `view` into it.
+ * @return false for anything but a complete, intact packet
+ */
+inline bool yolo26_result_parse(const uint8_t* data, size_t len, Yolo26ResultView* view) {
+    if (len < yolo26_result_packet_size(0, 0)) return false;
+    Yolo26ResultHeader h;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, YOLO_RESULT_MAGIC, 4) != 0 || h.version != YOLO_RESULT_VERSION) return false;
+    if (h.thumb_bytes > YOLO_FRAME_MAX_BYTES || yolo26_result_packet_size(h.count, h.thumb_bytes) != len) return false;
+    uint32_t crc;
+    memcpy(&crc, data + len - 4, 4);
+    if (yolo26_crc32(0, data, len - 4) != crc) return false;
+
+    view->header = h;
+    view->detections = reinterpret_cast<const DetectionQ*>(data + sizeof(h));
+    view->thumbnail = h.thumb_bytes ? data + sizeof(h) + (size_t)h.count * sizeof(DetectionQ) : nullptr;
+    return true;
+}
+
+/**
+ * @brief Nearest-neighbour RGB565 thumbnail of an RGB888 frame, written to `dst` (w * h * 2 bytes).
+ * @return Bytes written, 0 for an unsupported source
+ */
+inline size_t yolo26_make_thumbnail(const dl::image::img_t& src, uint8_t* dst, int w, int h) {
+    if (src.pix_type != dl::image::DL_IMAGE_PIX_TYPE_RGB888 || !src.data || w <= 0 || h <= 0) return 0;
+    const uint8_t* pixels = static_cast<const uint8_t*>(src.data);
+    for (int y = 0; y < h; y++) {
+        const uint8_t* row = pixels + (size_t)(y * src.height / h) * src.width * 3;
+        for (int x = 0; x < w; x++) {
+            const uint8_t* p = row + (size_t)(x * src.width / w) * 3;
+            uint16_t v = (uint16_t)(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3));
+            *dst++ = (uint8_t)v;
+            *dst++ = (uint8_t)(v >> 8);
+        }
+    }
+    return (size_t)w * h * 2;
+}
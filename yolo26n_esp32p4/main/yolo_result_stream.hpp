@@ -0,0 +1,357 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "lwip/sockets.h"
+#include "lwip/netdb.h"
+#include "yolo_result_packet.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// Default Result Stream Configuration
+#define YOLO_RESULT_DEPTH 1         // Packets waiting for the sender; older ones are superseded
+#define YOLO_RESULT_STACK_SIZE 4096
+#define YOLO_RESULT_PRIORITY 2      // Below every pipeline stage: a slow link never preempts them
+#define YOLO_RESULT_CORE 0
+#define YOLO_RESULT_UDP_PORT 5626
+
+/**
+ * @brief Sends one packet. Runs on the sender task.
+ * @return false on a send error (the packet is counted as failed)
+ */
+typedef bool (*Yolo26ResultSendFn)(const uint8_t* data, size_t len, void* ctx);
+
+struct Yolo26ResultStreamConfig {
+    Yolo26ResultSendFn send = nullptr; // Required, e.g. yolo26_result_udp_send
+    void* ctx = nullptr;
+    int depth = YOLO_RESULT_DEPTH;
+    int max_detections = YOLO_TARGET_K;
+    size_t max_thumb_bytes = 0;        // Thumbnail capacity per packet (0: none)
+    uint32_t stack_size = YOLO_RESULT_STACK_SIZE;
+    UBaseType_t priority = YOLO_RESULT_PRIORITY;
+    BaseType_t core = YOLO_RESULT_CORE;
+};
+
+struct Yolo26ResultStreamStats {
+    uint32_t published;  // Packets committed
+    uint32_t sent;
+    uint32_t superseded; // Replaced by a newer packet before the sender reached them
+    uint32_t busy;       // acquire() found no slot: every slot was held by the caller
+    uint32_t failed;     // Send errors
+    uint64_t bytes;
+};
+
+/**
+ * @brief A packet being filled in place. Write up to `capacity` detections and, optionally,
+ * a thumbnail of up to `thumb_capacity` bytes, then commit() or cancel() it.
+ */
+struct Yolo26ResultSlot {
+    DetectionQ* detections;
+    int capacity;
+    uint8_t* thumbnail;
+    size_t thumb_capacity;
+    int index;
+};
+
+/**
+ * @brief What commit() needs to know about a filled slot besides the detections.
+ */
+struct Yolo26ResultInfo {
+    int frame_w = 0; // Image the boxes refer to (0: not given)
+    int frame_h = 0;
+    Yolo26ThumbFormat thumb_format = YOLO_THUMB_NONE;
+    int thumb_w = 0;
+    int thumb_h = 0;
+    size_t thumb_bytes = 0;
+};
+
+/**
+ * @brief Sends detection packets (yolo_result_packet.hpp) from a background task.
+ *
+ * The producer fills packets in place: acquire() hands out a preallocated slot, the
+ * detections (down to postprocess_into(DetectionQ*)) and the thumbnail are written straight
+ * into it, and commit() adds the header and CRC and queues the slot. Nothing is copied
+ * between the producer and the network and nothing is allocated per frame.
+ *
+ * Latest value wins: at most `depth` packets wait for the sender. When the link is slower
+ * than the frame rate, a committed packet replaces the oldest waiting one instead of
+ * blocking the producer or building up latency; the replaced packets are counted.
+ * Slots: `depth` waiting, one being sent and one being filled.
+ */
+class Yolo26ResultStream {
+private:
+    struct Slot {
+        uint8_t* buf;
+        size_t len;
+    };
+
+    Yolo26ResultStreamConfig config;
+    std::vector<Slot> slots;
+    std::vector<int> free_slots;
+    std::vector<int> waiting; // Ring of committed slots, oldest at waiting_head
+    int waiting_head = 0;
+    int waiting_count = 0;
+    std::mutex mutex;
+    TaskHandle_t task = nullptr;
+    SemaphoreHandle_t exit_sem = nullptr;
+    std::atomic<bool> stopping{false};
+    uint32_t next_seq = 0;
+
+    std::atomic<uint32_t> published{0};
+    std::atomic<uint32_t> sent{0};
+    std::atomic<uint32_t> superseded{0};
+    std::atomic<uint32_t> busy{0};
+    std::atomic<uint32_t> failed{0};
+    std::atomic<uint64_t> bytes{0};
+
+    int pop_waiting() {
+        if (waiting_count == 0) return -1;
+        int idx = waiting[waiting_head];
+        waiting_head = (waiting_head + 1) % (int)waiting.size();
+        waiting_count--;
+        return idx;
+    }
+
+    void sender_loop() {
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            for (;;) {
+                int idx;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    idx = pop_waiting();
+                }
+                if (idx < 0) break;
+
+                Slot& s = slots[idx];
+                if (config.send(s.buf, s.len, config.ctx)) {
+                    sent++;
+                    bytes += s.len;
+                } else {
+                    failed++;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                free_slots.push_back(idx);
+            }
+            if (stopping) break; // Only once everything committed before stop() is sent
+        }
+    }
+
+    static void task_entry(void* arg) {
+        Yolo26ResultStream* self = static_cast<Yolo26ResultStream*>(arg);
+        self->sender_loop();
+        xSemaphoreGive(self->exit_sem);
+        vTaskDelete(nullptr);
+    }
+
+public:
+    Yolo26ResultStream(const Yolo26ResultStreamConfig& cfg) : config(cfg) {}
+
+    ~Yolo26ResultStream() { deinit(); }
+
+    Yolo26ResultStream(const Yolo26ResultStream&) = delete;
+    Yolo26ResultStream& operator=(const Yolo26ResultStream&) = delete;
+
+    /**
+     * @brief Allocates depth + 2 packet slots and starts the sender.
+     */
+    bool init() {
+        if (task || !config.send || config.depth <= 0 || config.max_detections < 0 ||
+            config.max_detections > UINT16_MAX) {
+            return false;
+        }
+        size_t slot_bytes = yolo26_result_packet_size(config.max_detections, config.max_thumb_bytes);
+        int count = config.depth + 2;
+        for (int i = 0; i < count; i++) {
+            uint8_t* buf = (uint8_t*)heap_caps_malloc(slot_bytes, MALLOC_CAP_8BIT);
+            if (!buf) {
+                printf("[Yolo26ResultStream] Error: Failed to allocate %u byte slot\n", (unsigned)slot_bytes);
+                deinit();
+                return false;
+            }
+            slots.push_back({buf, 0});
+            free_slots.push_back(i);
+        }
+        waiting.assign(config.depth, -1);
+        waiting_head = waiting_count = 0;
+        stopping = false;
+
+        exit_sem = xSemaphoreCreateBinary();
+        if (!exit_sem || xTaskCreatePinnedToCore(task_entry, "yolo_results", config.stack_size, this, config.priority,
+                                                 &task, config.core) != pdPASS) {
+            printf("[Yolo26ResultStream] Error: Failed to create sender task\n");
+            task = nullptr;
+            deinit();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Sends the packets already committed, then stops the sender and frees the slots.
+     */
+    void deinit() {
+        if (task) {
+            stopping = true;
+            xTaskNotifyGive(task);
+            xSemaphoreTake(exit_sem, portMAX_DELAY);
+            task = nullptr;
+        }
+        if (exit_sem) vSemaphoreDelete(exit_sem);
+        exit_sem = nullptr;
+        for (Slot& s : slots) heap_caps_free(s.buf);
+        slots.clear();
+        free_slots.clear();
+        waiting.clear();
+        waiting_count = 0;
+    }
+
+    /**
+     * @brief Hands out a slot to fill. Never blocks: with no free slot, the oldest waiting
+     * packet is superseded and its slot reused.
+     * @return false only while the caller itself holds every other slot
+     */
+    bool acquire(Yolo26ResultSlot* slot) {
+        if (!task) return false;
+        int idx = -1;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!free_slots.empty()) {
+                idx = free_slots.back();
+                free_slots.pop_back();
+            } else if ((idx = pop_waiting()) >= 0) {
+                superseded++;
+            }
+        }
+        if (idx < 0) {
+            busy++;
+            return false;
+        }
+        uint8_t* buf = slots[idx].buf;
+        *slot = {yolo26_result_detections(buf), config.max_detections,
+                 buf + sizeof(Yolo26ResultHeader) + (size_t)config.max_detections * sizeof(DetectionQ),
+                 config.max_thumb_bytes, idx};
+        return true;
+    }
+
+    /**
+     * @brief Returns an acquired slot unsent.
+     */
+    void cancel(const Yolo26ResultSlot& slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free_slots.push_back(slot.index);
+    }
+
+    /**
+     * @brief Completes `slot` with `count` detections and queues it, replacing the oldest
+     * waiting packet if `depth` are already waiting.
+     */
+    void commit(const Yolo26ResultSlot& slot, int count, const Yolo26ResultInfo& info = Yolo26ResultInfo()) {
+        Slot& s = slots[slot.index];
+        count = std::clamp(count, 0, config.max_detections);
+        size_t thumb_bytes = std::min(info.thumb_bytes, config.max_thumb_bytes);
+        // The thumbnail follows the detections actually sent
+        uint8_t* thumb = (uint8_t*)(slot.detections + count);
+        if (thumb_bytes && thumb != slot.thumbnail) memmove(thumb, slot.thumbnail, thumb_bytes);
+
+        Yolo26ResultHeader h = {};
+        h.thumb_format = thumb_bytes ? info.thumb_format : YOLO_THUMB_NONE;
+        h.count = (uint16_t)count;
+        h.time_ms = (uint32_t)(esp_timer_get_time() / 1000);
+        h.frame_w = (uint16_t)info.frame_w;
+        h.frame_h = (uint16_t)info.frame_h;
+        h.thumb_w = thumb_bytes ? (uint16_t)info.thumb_w : 0;
+        h.thumb_h = thumb_bytes ? (uint16_t)info.thumb_h : 0;
+        h.thumb_bytes = (uint32_t)thumb_bytes;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            h.seq = next_seq++;
+            s.len = yolo26_result_finish(s.buf, h);
+            if (waiting_count == (int)waiting.size()) {
+                free_slots.push_back(pop_waiting());
+                superseded++;
+            }
+            waiting[(waiting_head + waiting_count) % (int)waiting.size()] = slot.index;
+            waiting_count++;
+        }
+        published++;
+        xTaskNotifyGive(task);
+    }
+
+    /**
+     * @brief acquire() + commit() for float detections, e.g. from postprocess() or a pipeline
+     * callback. Copies the optional thumbnail.
+     */
+    bool publish(const Detection* dets, int count, const Yolo26ResultInfo& info = Yolo26ResultInfo(),
+                 const uint8_t* thumb = nullptr) {
+        Yolo26ResultSlot slot;
+        if (!acquire(&slot)) return false;
+        count = std::clamp(count, 0, slot.capacity);
+        for (int i = 0; i < count; i++) slot.detections[i] = yolo26_quantize_detection(dets[i]);
+        Yolo26ResultInfo copy = info;
+        copy.thumb_bytes = thumb ? std::min(info.thumb_bytes, slot.thumb_capacity) : 0;
+        if (copy.thumb_bytes) memcpy(slot.thumbnail, thumb, copy.thumb_bytes);
+        commit(slot, count, copy);
+        return true;
+    }
+
+    Yolo26ResultStreamStats get_stats() const {
+        return {published.load(), sent.load(), superseded.load(), busy.load(), failed.load(), bytes.load()};
+    }
+};
+
+// --- Destinations ---
+// The transport only needs a Yolo26ResultSendFn: an MQTT or WebSocket client publishes the
+// packet as one binary message the same way.
+
+struct Yolo26UdpSink {
+    int sock = -1;
+    struct sockaddr_storage addr;
+    socklen_t addr_len = 0;
+};
+
+/**
+ * @brief Resolves `host` (name or address) and opens a UDP socket to it. The network
+ * interface (Wi-Fi, Ethernet) must already be up.
+ */
+inline bool yolo26_udp_open(Yolo26UdpSink* sink, const char* host, uint16_t port) {
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo* res = nullptr;
+    char service[8];
+    snprintf(service, sizeof(service), "%u", (unsigned)port);
+    if (getaddrinfo(host, service, &hints, &res) != 0 || !res) {
+        printf("[Yolo26ResultStream] Error: Cannot resolve %s\n", host);
+        return false;
+    }
+    sink->sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (sink->sock >= 0) {
+        memcpy(&sink->addr, res->ai_addr, res->ai_addrlen);
+        sink->addr_len = res->ai_addrlen;
+    }
+    freeaddrinfo(res);
+    if (sink->sock < 0) {
+        printf("[Yolo26ResultStream] Error: Cannot create UDP socket\n");
+        return false;
+    }
+    return true;
+}
+
+inline void yolo26_udp_close(Yolo26UdpSink* sink) {
+    if (sink->sock >= 0) close(sink->sock);
+    sink->sock = -1;
+}
+
+/**
+ * @brief UDP destination; ctx is a Yolo26UdpSink opened by yolo26_udp_open(). One datagram per packet.
+ */
+inline bool yolo26_result_udp_send(const uint8_t* data, size_t len, void* ctx) {
+    Yolo26UdpSink* sink = static_cast<Yolo26UdpSink*>(ctx);
+    return sendto(sink->sock, data, len, 0, (const struct sockaddr*)&sink->addr, sink->addr_len) == (ssize_t)len;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// SWAR (SIMD within a register) helpers for the class-score scan in postprocess().
+//
+// A 16-byte group of int8 class logits is compared against 16 int8 thresholds as four
+// 32-bit words. Cells where no lane exceeds its threshold are rejected without touching
+// individual bytes, which is the common case (>99% of cells are background).
+
+#define YOLO_SCAN_GROUP 16 // Class bytes compared per step
+
+/**
+ * @brief Per-byte unsigned x > y. Returns 0x80 in every byte lane where it holds.
+ *
+ * d's high bit is (x_lo >= y_lo + 1) computed without cross-lane borrow, then combined
+ * with the high bits: x > y iff (x_hi & !y_hi) or (x_hi == y_hi and x_lo > y_lo).
+ */
+inline uint32_t yolo26_swar_gt_u8(uint32_t x, uint32_t y) {
+    const uint32_t H = 0x80808080u;
+    const uint32_t L = 0x7F7F7F7Fu;
+    uint32_t d = ((x & L) | H) - ((y & L) + 0x01010101u); // high bit: x_lo > y_lo
+    return ((x & ~y) | (~(x ^ y) & d)) & H;
+}
+
+/**
+ * @brief Per-byte signed x > y (int8 lanes). Bias both to unsigned by flipping the sign bit.
+ */
+inline uint32_t yolo26_swar_gt_s8(uint32_t x, uint32_t y) {
+    return yolo26_swar_gt_u8(x ^ 0x80808080u, y ^ 0x80808080u);
+}
+
+/**
+ * @brief True if any of the 16 int8 lanes at `vals` exceeds the matching lane of `thresh`.
+ * `thresh` holds 16 bytes packed as 4 words (see yolo26_swar_pack_thresh()).
+ */
+inline bool yolo26_swar_any_gt_s8_16(const int8_t* vals, const uint32_t* thresh) {
+    uint32_t w[4];
+    memcpy(w, vals, sizeof(w));
+    uint32_t hit = yolo26_swar_gt_s8(w[0], thresh[0]) | yolo26_swar_gt_s8(w[1], thresh[1]) |
+                   yolo26_swar_gt_s8(w[2], thresh[2]) | yolo26_swar_gt_s8(w[3], thresh[3]);
+    return hit != 0;
+}
+
+/**
+ * @brief Packs `n` int8 thresholds into words for the SWAR compare.
+ */
+inline void yolo26_swar_pack_thresh(const int8_t* thresh, int n, uint32_t* out) {
+    memcpy(out, thresh, n);
+}
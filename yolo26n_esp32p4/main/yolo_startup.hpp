@@ -0,0 +1,191 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "dl_model_base.hpp"
+#include "driver/rtc_io.h"
+#include "esp_partition.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include <cstdio>
+#include <cstring>
+
+// Cold start: the model mapped from its own flash partition, built on a background task while
+// the camera comes up, and a timeline from boot to the first detection.
+
+// Default Startup Configuration
+#define YOLO_MODEL_PARTITION_LABEL "model_a" // Data partition holding the .espdl (partitions.csv, slot A)
+#define YOLO_STARTUP_MAX_MARKS 12
+#define YOLO_LOADER_STACK_SIZE 8192
+#define YOLO_LOADER_PRIORITY 5
+#define YOLO_LOADER_CORE 1                 // Away from the task that initializes the camera
+
+/**
+ * @brief Named timestamps since esp_timer start (early in app startup; the bootloader is not included).
+ */
+class Yolo26StartupTimer {
+private:
+    struct Mark {
+        const char* name;
+        int64_t us;
+    };
+    Mark marks[YOLO_STARTUP_MAX_MARKS];
+    int count = 0;
+
+public:
+    void mark(const char* name) {
+        if (count < YOLO_STARTUP_MAX_MARKS) marks[count++] = {name, esp_timer_get_time()};
+    }
+
+    /**
+     * @brief Time of the mark `name` in us, -1 if it was never set.
+     */
+    int64_t get(const char* name) const {
+        for (int i = 0; i < count; i++) {
+            if (strcmp(marks[i].name, name) == 0) return marks[i].us;
+        }
+        return -1;
+    }
+
+    void print(const char* title) const {
+        printf("%s (ms since esp_timer start):\n", title);
+        for (int i = 0; i < count; i++) {
+            printf("  %-18s %8.1f  (+%.1f)\n", marks[i].name, marks[i].us / 1000.0f,
+                   (marks[i].us - (i > 0 ? marks[i - 1].us : 0)) / 1000.0f);
+        }
+    }
+};
+
+/**
+ * @brief Checks that the model partition exists and has been flashed.
+ * Data partitions are only guaranteed 4 KB alignment (64 KB applies to app partitions), which
+ * still exceeds esp-dl's 16-byte requirement: esp_partition_mmap() always hands it an aligned
+ * model and the FbsLoader alignment warning cannot occur.
+ */
+inline const esp_partition_t* yolo26_find_model_partition(const char* label = YOLO_MODEL_PARTITION_LABEL) {
+    const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part) {
+        printf("[Yolo26Startup] Error: No '%s' data partition in the partition table\n", label);
+        return nullptr;
+    }
+    uint32_t head = 0xFFFFFFFF;
+    if (esp_partition_read(part, 0, &head, sizeof(head)) != ESP_OK || head == 0xFFFFFFFF) {
+        printf("[Yolo26Startup] Error: Partition '%s' is empty (run idf.py flash)\n", label);
+        return nullptr;
+    }
+    return part;
+}
+
+struct Yolo26ModelLoaderConfig {
+    int max_internal_size = 0; // dl::Model internal SRAM budget for tensors (0 = esp-dl default)
+    bool param_copy = true;    // Copy weights from flash to PSRAM during the background build
+    uint32_t stack_size = YOLO_LOADER_STACK_SIZE;
+    UBaseType_t priority = YOLO_LOADER_PRIORITY;
+    BaseType_t core = YOLO_LOADER_CORE;
+};
+
+/**
+ * @brief Builds a dl::Model on a background task so the weight copy to PSRAM and the memory
+ * planning overlap with other startup work (camera and sensor init, the first capture).
+ *
+ * start() returns at once; wait() blocks until the model is built and hands it over.
+ * The destructor waits for an unfinished build and deletes a model that was never taken.
+ */
+class Yolo26ModelLoader {
+private:
+    const char* address = nullptr;
+    fbs::model_location_type_t location = fbs::MODEL_LOCATION_IN_FLASH_RODATA;
+    Yolo26ModelLoaderConfig config;
+    dl::Model* model = nullptr;
+    SemaphoreHandle_t done_sem = nullptr;
+    bool finished = false;
+    int64_t start_us = 0;
+    int64_t end_us = 0;
+
+    static void task_entry(void* arg) {
+        auto* self = static_cast<Yolo26ModelLoader*>(arg);
+        dl::Model* m = new dl::Model(self->address, self->location, self->config.max_internal_size,
+                                     dl::MEMORY_MANAGER_GREEDY, nullptr, self->config.param_copy);
+        if (m->get_inputs().empty()) {
+            printf("[Yolo26ModelLoader] Error: Model failed to load\n");
+            delete m;
+            m = nullptr;
+        }
+        self->model = m;
+        self->end_us = esp_timer_get_time();
+        xSemaphoreGive(self->done_sem);
+        vTaskDelete(nullptr);
+    }
+
+public:
+    Yolo26ModelLoader(const Yolo26ModelLoaderConfig& cfg = Yolo26ModelLoaderConfig()) : config(cfg) {}
+
+    ~Yolo26ModelLoader() {
+        delete wait();
+        if (done_sem) vSemaphoreDelete(done_sem);
+    }
+
+    Yolo26ModelLoader(const Yolo26ModelLoader&) = delete;
+    Yolo26ModelLoader& operator=(const Yolo26ModelLoader&) = delete;
+
+    /**
+     * @brief Starts building the model at `address` (rodata pointer or partition label).
+     * @return false if a build was already started or the task could not be created
+     */
+    bool start(const char* addr, fbs::model_location_type_t loc = fbs::MODEL_LOCATION_IN_FLASH_RODATA) {
+        if (done_sem) return false;
+        address = addr;
+        location = loc;
+        done_sem = xSemaphoreCreateBinary();
+        if (!done_sem) return false;
+        start_us = esp_timer_get_time();
+        TaskHandle_t task;
+        if (xTaskCreatePinnedToCore(task_entry, "yolo_loader", config.stack_size, this, config.priority, &task, config.core) != pdPASS) {
+            printf("[Yolo26ModelLoader] Error: Failed to create loader task\n");
+            vSemaphoreDelete(done_sem);
+            done_sem = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Waits for the build and transfers ownership of the model to the caller.
+     * @return The model, or nullptr on timeout, build failure or if it was already taken
+     */
+    dl::Model* wait(TickType_t timeout = portMAX_DELAY) {
+        if (!done_sem) return nullptr;
+        if (!finished) {
+            if (xSemaphoreTake(done_sem, timeout) != pdTRUE) return nullptr;
+            finished = true;
+        }
+        dl::Model* m = model;
+        model = nullptr;
+        return m;
+    }
+
+    uint32_t get_build_us() const { return finished ? (uint32_t)(end_us - start_us) : 0; }
+};
+
+inline const char* yolo26_wake_cause_name() {
+    switch (esp_sleep_get_wakeup_cause()) {
+    case ESP_SLEEP_WAKEUP_UNDEFINED: return "power-on / reset";
+    case ESP_SLEEP_WAKEUP_EXT1: return "ext1 (PIR)";
+    case ESP_SLEEP_WAKEUP_TIMER: return "timer";
+    default: return "other";
+    }
+}
+
+/**
+ * @brief Enters deep sleep until `gpio` (an LP GPIO, e.g. a PIR sensor output) goes high.
+ * Does not return. The next wake-up is a cold boot: PSRAM content is lost, so the model is
+ * built again from flash.
+ */
+inline void yolo26_sleep_until_motion(int gpio) {
+    rtc_gpio_pullup_dis((gpio_num_t)gpio);
+    rtc_gpio_pulldown_en((gpio_num_t)gpio);
+    esp_sleep_enable_ext1_wakeup_io(1ULL << gpio, ESP_EXT1_WAKEUP_ANY_HIGH);
+    printf("Deep sleep until GPIO %d goes high\n", gpio);
+    fflush(stdout);
+    esp_deep_sleep_start();
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "yolo_memory.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Optional duplicate suppression on the final top-K list.
+//
+// The one-to-one head is trained to emit one box per object, but neighbouring strides still
+// produce the occasional near-duplicate, and tile seams add more. This pass runs on at most K
+// selected detections, never on the scan candidates, so its cost is bounded by K alone:
+// 1. Boxes are rounded to integer model pixels and each one gets a row of a K x K bitmask, one
+//    bit per lower-ranked box of the same class that overlaps it above the IoU threshold. The
+//    IoU test is exact integer arithmetic (inter * DEN > num * union).
+// 2. A greedy sweep in rank order ORs the row of every kept box into a removed mask, 32 boxes
+//    per word: O(K^2 / 32).
+// The list is best first, so the higher-scoring box of each group survives.
+
+#define YOLO_SUPPRESS_IOU 0.70f   // Default overlap above which the lower-ranked box is dropped
+#define YOLO_SUPPRESS_IOU_DEN 256 // IoU threshold resolution (1/256)
+
+/**
+ * @brief Class-aware bitmask suppression with storage for up to `capacity` boxes, sized once.
+ * Not thread-safe; owned by the postprocess() caller.
+ */
+template <typename Det>
+class Yolo26SuppressorT {
+private:
+    struct Box {
+        int32_t x1, y1, x2, y2;
+        int32_t area;
+        int class_id;
+    };
+
+    Yolo26HotVector<Box> boxes;
+    Yolo26HotVector<uint32_t> masks;   // capacity rows of `words` words
+    Yolo26HotVector<uint32_t> removed; // `words` words
+    int capacity = 0;
+    int words = 0;
+
+public:
+    /**
+     * @brief Sizes the storage for `k` boxes (about K^2 / 8 bytes). No-op if already large enough.
+     */
+    void reserve(int k) {
+        if (k <= capacity) return;
+        capacity = k;
+        words = (k + 31) / 32;
+        boxes.resize(k);
+        masks.resize((size_t)k * words);
+        removed.resize(words);
+    }
+
+    int get_capacity() const { return capacity; }
+    const void* get_storage() const { return masks.data(); }
+    size_t get_storage_bytes() const {
+        return boxes.capacity() * sizeof(Box) + (masks.capacity() + removed.capacity()) * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Drops lower-ranked same-class boxes that overlap a kept one by more than
+     * `iou_num / YOLO_SUPPRESS_IOU_DEN`. `dets` is compacted in place, order preserved.
+     * @return Number of detections kept (boxes beyond get_capacity() are kept unchecked)
+     */
+    int run(Det* dets, int n, uint32_t iou_num) {
+        int m = std::min(n, capacity);
+        if (m < 2) return n;
+        for (int i = 0; i < m; i++) {
+            Box& b = boxes[i];
+            b.x1 = (int32_t)std::lround(dets[i].x1);
+            b.y1 = (int32_t)std::lround(dets[i].y1);
+            b.x2 = std::max(b.x1, (int32_t)std::lround(dets[i].x2));
+            b.y2 = std::max(b.y1, (int32_t)std::lround(dets[i].y2));
+            b.area = (b.x2 - b.x1) * (b.y2 - b.y1);
+            b.class_id = dets[i].class_id;
+        }
+
+        int row_words = (m + 31) / 32;
+        for (int i = 0; i < m; i++) {
+            uint32_t* row = &masks[(size_t)i * words];
+            std::fill(row, row + row_words, 0u);
+            const Box& a = boxes[i];
+            for (int j = i + 1; j < m; j++) {
+                const Box& b = boxes[j];
+                if (b.class_id != a.class_id) continue;
+                int32_t iw = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+                int32_t ih = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+                if (iw <= 0 || ih <= 0) continue;
+                int64_t inter = (int64_t)iw * ih;
+                int64_t uni = (int64_t)a.area + b.area - inter;
+                if (inter * YOLO_SUPPRESS_IOU_DEN > (int64_t)iou_num * uni) row[j >> 5] |= 1u << (j & 31);
+            }
+        }
+
+        std::fill(removed.begin(), removed.begin() + row_words, 0u);
+        int kept = 0;
+        for (int i = 0; i < m; i++) {
+            if (removed[i >> 5] & (1u << (i & 31))) continue;
+            const uint32_t* row = &masks[(size_t)i * words];
+            for (int w = i >> 5; w < row_words; w++) removed[w] |= row[w];
+            dets[kept++] = dets[i];
+        }
+        for (int i = m; i < n; i++) dets[kept++] = dets[i];
+        return kept;
+    }
+};
+
+/**
+ * @brief IoU threshold in YOLO_SUPPRESS_IOU_DEN steps, as Yolo26SuppressorT::run() takes it.
+ */
+inline uint32_t yolo26_suppress_iou_num(float iou) {
+    return (uint32_t)std::lround(std::clamp(iou, 0.0f, 1.0f) * YOLO_SUPPRESS_IOU_DEN);
+}
@@ -0,0 +1,244 @@
+#pragma once
+#include "dl_model_base.hpp"
+#include "yolo_processor.hpp"
+#include "yolo_motion.hpp"
+#include <algorithm>
+#include <vector>
+
+// Default Tiling Configuration
+#define YOLO_TILER_MAX_TILES 32
+#define YOLO_TILER_OVERLAP 0.2f       // Fraction of a tile shared with its neighbour
+#define YOLO_TILER_MERGE_IOU 0.5f     // Cross-tile duplicates: IoU above this ...
+#define YOLO_TILER_MERGE_IOS 0.7f     // ... or intersection over the smaller box above this
+#define YOLO_TILER_MOTION_THRESH 4    // Mean abs luma difference (0..255) that counts as motion
+#define YOLO_TILER_MAX_STALE 8        // Frames a tile may be skipped before it is re-run anyway
+
+struct Yolo26TilerConfig {
+    int tile_w = 0;                          // Tile size in frame pixels (0 = model input size, 1:1 pixels)
+    int tile_h = 0;
+    float overlap = YOLO_TILER_OVERLAP;
+    float merge_iou = YOLO_TILER_MERGE_IOU;
+    float merge_ios = YOLO_TILER_MERGE_IOS;
+    bool motion_skip = true;                 // Re-emit cached results for tiles without motion
+    int motion_thresh = YOLO_TILER_MOTION_THRESH;
+    int max_stale_frames = YOLO_TILER_MAX_STALE;
+    int max_tiles_per_frame = 0;             // Inference budget per process() call (0 = unlimited)
+};
+
+/**
+ * @brief Tiled / ROI inference for frames larger than the model input.
+ *
+ * Each tile is cropped, resized and quantized straight into the model input
+ * (Yolo26Processor::preprocess_region()), inferred, and its detections are mapped back to
+ * frame pixels. The one-to-one head is NMS-free only within one tile, so objects on a seam
+ * show up once per tile: detections from different tiles of the same class that overlap are
+ * merged into their union, keeping the best score.
+ *
+ * Scheduling: a tile runs when its luma signature moved past motion_thresh since the frame it
+ * was last inferred on, or when it has been skipped max_stale_frames times. Other tiles re-emit
+ * their cached detections. max_tiles_per_frame bounds the cost of a frame; stale tiles go first,
+ * then the largest motion.
+ *
+ * All buffers are sized in set_grid() / set_rois(); process() does not allocate.
+ */
+template <typename Processor>
+class Yolo26TilerT {
+private:
+    struct TileState {
+        Yolo26Rect rect;
+        Yolo26LumaSignature ref;   // Signature of the frame this tile was last inferred on
+        Yolo26LumaSignature cur;
+        int age = 0;               // Frames since last inference
+        int motion = 0;
+        int count = 0;             // Cached detections
+        bool run = false;
+    };
+
+    struct TileDet {
+        Detection det;
+        int tile;
+    };
+
+    dl::Model* model;
+    Processor& processor;
+    Yolo26TilerConfig config;
+    int k;
+
+    std::vector<TileState> tiles;
+    std::vector<Detection> cache;   // tiles.size() * k, tile i at [i * k]
+    std::vector<TileDet> merged;
+    std::vector<int> order;
+    int tiles_run = 0;
+
+    bool allocate(int n) {
+        if (n <= 0 || n > YOLO_TILER_MAX_TILES) {
+            printf("[Yolo26Tiler] Error: %d tiles (max %d)\n", n, YOLO_TILER_MAX_TILES);
+            return false;
+        }
+        tiles.assign(n, TileState());
+        cache.assign((size_t)n * k, Detection());
+        merged.resize((size_t)n * k);
+        order.resize(n);
+        return true;
+    }
+
+    static float area(const Detection& d) {
+        return std::max(0.0f, d.x2 - d.x1) * std::max(0.0f, d.y2 - d.y1);
+    }
+
+    bool is_duplicate(const Detection& a, const Detection& b) const {
+        float iw = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+        float ih = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+        if (iw <= 0.0f || ih <= 0.0f) return false;
+        float inter = iw * ih;
+        float area_a = area(a);
+        float area_b = area(b);
+        float uni = area_a + area_b - inter;
+        float smaller = std::min(area_a, area_b);
+        return (uni > 0.0f && inter > config.merge_iou * uni) ||
+               (smaller > 0.0f && inter > config.merge_ios * smaller);
+    }
+
+    // Chooses the tiles to infer this frame (sets TileState::run).
+    void schedule(const dl::image::img_t& frame) {
+        int n = (int)tiles.size();
+        int wanted = 0;
+        for (int i = 0; i < n; i++) {
+            TileState& t = tiles[i];
+            yolo26_luma_signature(frame, t.rect, t.cur);
+            t.motion = yolo26_signature_diff(t.cur, t.ref);
+            bool stale = !t.ref.valid || t.age >= config.max_stale_frames;
+            t.run = !config.motion_skip || stale || t.motion >= config.motion_thresh;
+            if (t.run) order[wanted++] = i;
+        }
+
+        int budget = config.max_tiles_per_frame;
+        if (budget <= 0 || wanted <= budget) return;
+
+        // Over budget: oldest first (never-run tiles have age 0 but no reference), then most motion.
+        auto priority = [&](int i) {
+            const TileState& t = tiles[i];
+            return !t.ref.valid ? (1 << 30) : t.age * 256 + t.motion;
+        };
+        std::sort(order.begin(), order.begin() + wanted, [&](int a, int b) { return priority(a) > priority(b); });
+        for (int j = budget; j < wanted; j++) tiles[order[j]].run = false;
+    }
+
+public:
+    /**
+     * @param m Loaded model (not owned)
+     * @param proc Processor (not owned); its resize mode applies to tiles whose aspect differs from the model
+     */
+    Yolo26TilerT(dl::Model* m, Processor& proc, const Yolo26TilerConfig& cfg = Yolo26TilerConfig())
+        : model(m), processor(proc), config(cfg), k(std::max(proc.get_target_k(), 0)) {}
+
+    /**
+     * @brief Covers a frame_w x frame_h frame with evenly spread, overlapping tiles.
+     * A frame no larger than a tile yields a single tile.
+     */
+    bool set_grid(int frame_w, int frame_h) {
+        auto& inputs = model->get_inputs();
+        if (inputs.empty()) return false;
+        int tw = config.tile_w > 0 ? config.tile_w : inputs.begin()->second->shape[2];
+        int th = config.tile_h > 0 ? config.tile_h : inputs.begin()->second->shape[1];
+        tw = std::min(tw, frame_w);
+        th = std::min(th, frame_h);
+
+        auto count = [&](int frame, int tile) {
+            int step = std::max(1, (int)(tile * (1.0f - config.overlap)));
+            return frame <= tile ? 1 : (frame - tile + step - 1) / step + 1;
+        };
+        int cols = count(frame_w, tw);
+        int rows = count(frame_h, th);
+        if (!allocate(cols * rows)) return false;
+
+        for (int r = 0; r < rows; r++) {
+            int y = rows > 1 ? r * (frame_h - th) / (rows - 1) : 0;
+            for (int c = 0; c < cols; c++) {
+                int x = cols > 1 ? c * (frame_w - tw) / (cols - 1) : 0;
+                tiles[r * cols + c].rect = {x, y, tw, th};
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Uses caller-supplied regions instead of a grid.
+     */
+    bool set_rois(const Yolo26Rect* rois, int n) {
+        if (!allocate(n)) return false;
+        for (int i = 0; i < n; i++) tiles[i].rect = rois[i];
+        return true;
+    }
+
+    /**
+     * @brief Runs the scheduled tiles on `frame` (RGB888) and writes merged detections, best first.
+     *
+     * @param out Destination in frame pixels
+     * @param capacity Entries available at `out`
+     * @return Number of detections written
+     */
+    int process(const dl::image::img_t& frame, Detection* out, int capacity) {
+        if (tiles.empty()) return 0;
+        schedule(frame);
+
+        tiles_run = 0;
+        auto& inputs = model->get_inputs();
+        for (int i = 0; i < (int)tiles.size(); i++) {
+            TileState& t = tiles[i];
+            if (!t.run) {
+                t.age++;
+                continue;
+            }
+            Yolo26Transform xf;
+            if (!processor.preprocess_region(frame, t.rect, inputs, &xf)) {
+                t.count = 0;
+                continue;
+            }
+            model->run();
+            t.count = processor.postprocess_into(model->get_outputs(), &cache[(size_t)i * k], k, &xf);
+            t.ref = t.cur;
+            t.age = 0;
+            tiles_run++;
+        }
+
+        // Seam dedup: greedy by score, only across tiles (within a tile the head is already NMS-free).
+        int total = 0;
+        for (int i = 0; i < (int)tiles.size(); i++) {
+            for (int j = 0; j < tiles[i].count; j++) {
+                merged[total++] = {cache[(size_t)i * k + j], i};
+            }
+        }
+        std::sort(merged.begin(), merged.begin() + total,
+                  [](const TileDet& a, const TileDet& b) { return a.det.score > b.det.score; });
+
+        int kept = 0;
+        for (int i = 0; i < total; i++) {
+            const TileDet& cand = merged[i];
+            bool dup = false;
+            for (int j = 0; j < kept; j++) {
+                TileDet& keep = merged[j];
+                if (keep.tile == cand.tile || keep.det.class_id != cand.det.class_id) continue;
+                if (!is_duplicate(keep.det, cand.det)) continue;
+                // Seam-cut object: each tile saw part of it
+                keep.det.x1 = std::min(keep.det.x1, cand.det.x1);
+                keep.det.y1 = std::min(keep.det.y1, cand.det.y1);
+                keep.det.x2 = std::max(keep.det.x2, cand.det.x2);
+                keep.det.y2 = std::max(keep.det.y2, cand.det.y2);
+                dup = true;
+                break;
+            }
+            if (!dup) merged[kept++] = cand;
+        }
+
+        int n = std::min(kept, std::max(capacity, 0));
+        for (int i = 0; i < n; i++) out[i] = merged[i].det;
+        return n;
+    }
+
+    int get_tile_count() const { return (int)tiles.size(); }
+    const Yolo26Rect& get_tile(int i) const { return tiles[i].rect; }
+    int get_tiles_run() const { return tiles_run; } // Inferred during the last process() call
+};
+
+using Yolo26Tiler = Yolo26TilerT<Yolo26Processor<>>;
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+/**
+ * @brief Fixed-capacity top-K selector backed by a binary min-heap over caller storage.
+ *
+ * The root is always the worst of the kept entries, so a new entry is either rejected with
+ * a single compare or replaces the root in O(log K). Nothing is allocated: the storage is
+ * provided once (e.g. by Yolo26Processor at construction) and reused for every frame.
+ *
+ * @tparam Entry Stored element
+ * @tparam Less Strict ordering, Less(a, b) == "a ranks below b"
+ */
+template <typename Entry, typename Less = std::less<Entry>>
+class Yolo26TopK {
+private:
+    Entry* data = nullptr;
+    int cap = 0;
+    int count = 0;
+    Less less;
+
+    void sift_up(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!less(data[i], data[parent])) break;
+            std::swap(data[i], data[parent]);
+            i = parent;
+        }
+    }
+
+    void sift_down(int i, int n) {
+        for (;;) {
+            int smallest = i;
+            int l = 2 * i + 1;
+            int r = l + 1;
+            if (l < n && less(data[l], data[smallest])) smallest = l;
+            if (r < n && less(data[r], data[smallest])) smallest = r;
+            if (smallest == i) break;
+            std::swap(data[i], data[smallest]);
+            i = smallest;
+        }
+    }
+
+public:
+    Yolo26TopK() = default;
+    Yolo26TopK(Entry* storage, int capacity) : data(storage), cap(capacity) {}
+
+    void reset(Entry* storage, int capacity) {
+        data = storage;
+        cap = capacity;
+        count = 0;
+    }
+
+    void clear() { count = 0; }
+    int size() const { return count; }
+    int capacity() const { return cap; }
+    const Entry* get_storage() const { return data; }
+    bool full() const { return count >= cap; }
+
+    /**
+     * @brief Worst kept entry (the current K-th best once full). Requires size() > 0.
+     */
+    const Entry& min() const { return data[0]; }
+
+    /**
+     * @brief Offers an entry.
+     * @return true if it was kept (possibly evicting the previous K-th best)
+     */
+    bool push(const Entry& e) {
+        if (count < cap) {
+            data[count] = e;
+            sift_up(count);
+            count++;
+            return true;
+        }
+        if (cap == 0 || !less(data[0], e)) return false;
+        data[0] = e;
+        sift_down(0, count);
+        return true;
+    }
+
+    /**
+     * @brief Heap-sorts the kept entries in place, best first.
+     * Heap order is destroyed: call clear() before pushing again.
+     */
+    void sort_descending() {
+        for (int n = count - 1; n > 0; n--) {
+            std::swap(data[0], data[n]); // Current worst goes to the back
+            sift_down(0, n);
+        }
+    }
+
+    Entry* begin() { return data; }
+    Entry* end() { return data + count; }
+    const Entry* begin() const { return data; }
+    const Entry* end() const { return data + count; }
+};
+
+// --- Candidate Keys ---
+//
+// postprocess() ranks candidates by a packed integer key instead of a decoded Detection:
+// the score in the high bits, the anchor position (layer, cell) in the low bits. Boxes,
+// class ids and sigmoid() are computed for the K survivors only.
+//
+// Low bits hold the inverted position, so on equal scores the earlier anchor (lower layer,
+// then lower cell) wins, like a stable sort in scan order. Every key is therefore unique.
+
+#define YOLO_KEY_CELL_BITS 14 // 32-bit keys: up to 128x128 cells on p3 (1024x1024 input)
+#define YOLO_KEY_MAX_SHIFT 8  // 32-bit keys: int8 logits shifted to a common exponent fit 16 bits
+
+/**
+ * @brief 32-bit key for int8 logits.
+ * @param norm Raw logit shifted to the smallest class exponent of all layers, in [-32768, 32767]
+ */
+inline uint32_t yolo26_key32(int norm, int layer, int cell) {
+    uint32_t pos = ((uint32_t)layer << YOLO_KEY_CELL_BITS) | (uint32_t)cell;
+    return ((uint32_t)(norm + 32768) << 16) | (0xFFFFu - pos);
+}
+
+inline int yolo26_key32_norm(uint32_t key) { return (int)(key >> 16) - 32768; }
+inline int yolo26_key32_layer(uint32_t key) { return (int)((0xFFFFu - (key & 0xFFFFu)) >> YOLO_KEY_CELL_BITS); }
+inline int yolo26_key32_cell(uint32_t key) { return (int)((0xFFFFu - (key & 0xFFFFu)) & ((1u << YOLO_KEY_CELL_BITS) - 1)); }
+
+/**
+ * @brief 64-bit key for int16 logits, wide exponent spreads or large grids.
+ * The high word is the dequantized logit (exact: raw * 2^exponent) with its bits flipped so
+ * that unsigned order matches float order.
+ */
+inline uint64_t yolo26_key64(float logit, int layer, int cell) {
+    uint32_t f;
+    memcpy(&f, &logit, 4);
+    f = (f & 0x80000000u) ? ~f : (f | 0x80000000u);
+    uint32_t pos = ((uint32_t)layer << 30) | (uint32_t)cell;
+    return ((uint64_t)f << 32) | (0xFFFFFFFFu - pos);
+}
+
+inline float yolo26_key64_logit(uint64_t key) {
+    uint32_t f = (uint32_t)(key >> 32);
+    f = (f & 0x80000000u) ? (f & 0x7FFFFFFFu) : ~f;
+    float logit;
+    memcpy(&logit, &f, 4);
+    return logit;
+}
+
+inline int yolo26_key64_layer(uint64_t key) { return (int)((0xFFFFFFFFu - (uint32_t)key) >> 30); }
+inline int yolo26_key64_cell(uint64_t key) { return (int)((0xFFFFFFFFu - (uint32_t)key) & 0x3FFFFFFFu); }
@@ -0,0 +1,294 @@
+#pragma once
+#include "yolo_processor.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Multi-object tracking on top of postprocess(): stable IDs across inferences and boxes predicted
+// at camera frame rate in between, so the model can run far less often than the output rate.
+//
+// ByteTrack-style association with a fixed-capacity track pool:
+// 1. Every track is predicted to the detection timestamp (constant-velocity Kalman filter,
+//    one decoupled position/velocity filter per box coordinate: cx, cy, w, h).
+// 2. Confident detections are matched to all tracks by IoU (same class only).
+// 3. Low-score detections (below high_thresh) may then rescue still-tracked boxes, which keeps
+//    IDs through occlusion and motion blur instead of dropping them with the detection.
+// 4. Unmatched confident detections start tentative tracks, confirmed after min_hits updates;
+//    a track missed for more than max_lost updates is freed.
+// Matching is greedy by best IoU instead of ByteTrack's Hungarian step: no cost matrix, and with
+// a few dozen boxes per frame the two rarely disagree. Nothing is allocated after construction.
+
+// Default Tracker Configuration
+#define YOLO_TRACK_MAX 32             // Track pool capacity
+#define YOLO_TRACK_MAX_DETS 64        // Detections considered per update (postprocess order: best first)
+#define YOLO_TRACK_HIGH_THRESH 0.50f  // First association stage / new tracks
+#define YOLO_TRACK_NEW_THRESH 0.60f   // Minimum score to start a track
+#define YOLO_TRACK_HIGH_IOU 0.20f     // Minimum IoU for a confident match
+#define YOLO_TRACK_LOW_IOU 0.50f      // Minimum IoU for a low-score rescue
+#define YOLO_TRACK_MIN_HITS 2         // Updates before a tentative track is reported
+#define YOLO_TRACK_MAX_LOST 3         // Missed updates before a track is freed
+#define YOLO_TRACK_MEAS_STD 0.05f     // Detection noise, in box heights
+#define YOLO_TRACK_ACCEL_STD 0.50f    // Motion noise, in box heights per s^2
+#define YOLO_TRACK_MAX_EXTRAPOLATE_MS 2000 // Predictions freeze this long after a track's last match
+
+struct Yolo26TrackerConfig {
+    float high_thresh = YOLO_TRACK_HIGH_THRESH;
+    float new_thresh = YOLO_TRACK_NEW_THRESH;
+    float high_iou = YOLO_TRACK_HIGH_IOU;
+    float low_iou = YOLO_TRACK_LOW_IOU;
+    int min_hits = YOLO_TRACK_MIN_HITS;
+    int max_lost = YOLO_TRACK_MAX_LOST;
+    float meas_std = YOLO_TRACK_MEAS_STD;
+    float accel_std = YOLO_TRACK_ACCEL_STD;
+    int max_extrapolate_ms = YOLO_TRACK_MAX_EXTRAPOLATE_MS;
+};
+
+/**
+ * @brief A tracked box: `det` holds the estimated box, the last matched score and the class.
+ */
+struct Yolo26TrackedBox {
+    Detection det;
+    int track_id;
+    float vx, vy; // Centre velocity, pixels per second
+};
+
+inline float yolo26_iou(const Detection& a, const Detection& b) {
+    float iw = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+    float ih = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+    if (iw <= 0.0f || ih <= 0.0f) return 0.0f;
+    float inter = iw * ih;
+    float uni = (a.x2 - a.x1) * (a.y2 - a.y1) + (b.x2 - b.x1) * (b.y2 - b.y1) - inter;
+    return uni > 0.0f ? inter / uni : 0.0f;
+}
+
+/**
+ * @brief Position/velocity Kalman filter for one box coordinate, covariance [[p00, p01], [p01, p11]].
+ */
+struct Yolo26Kalman1D {
+    float pos, vel;
+    float p00, p01, p11;
+
+    void init(float z, float pos_var, float vel_var) {
+        pos = z;
+        vel = 0.0f;
+        p00 = pos_var;
+        p01 = 0.0f;
+        p11 = vel_var;
+    }
+
+    // Constant velocity over dt seconds, white acceleration noise of variance q
+    void predict(float dt, float q) {
+        pos += vel * dt;
+        float dt2 = dt * dt;
+        p00 += 2.0f * dt * p01 + dt2 * p11 + q * dt2 * dt / 3.0f;
+        p01 += dt * p11 + q * dt2 / 2.0f;
+        p11 += q * dt;
+    }
+
+    void update(float z, float r) {
+        float s = p00 + r;
+        float k0 = p00 / s;
+        float k1 = p01 / s;
+        float y = z - pos;
+        pos += k0 * y;
+        vel += k1 * y;
+        p11 -= k1 * p01;
+        p01 *= 1.0f - k0;
+        p00 *= 1.0f - k0;
+    }
+};
+
+/**
+ * @brief Fixed-capacity ByteTrack-style tracker. Not thread-safe: call update() and predict()
+ * from one task, or guard them with a mutex.
+ *
+ * update() is fed the detections of each inference with its capture timestamp; predict() serves
+ * the confirmed tracks at any later timestamp (e.g. every camera frame) without changing them.
+ */
+template <int MaxTracks = YOLO_TRACK_MAX>
+class Yolo26TrackerT {
+private:
+    enum { COORD_CX = 0, COORD_CY, COORD_W, COORD_H, COORDS };
+
+    struct Track {
+        Yolo26Kalman1D kf[COORDS];
+        int id;
+        int class_id;
+        float score;
+        int hits;
+        int lost;       // Consecutive updates without a match
+        int64_t t_us;   // Filter time (last predict / update)
+        int64_t seen_us; // Last matched detection
+        bool active;
+    };
+
+    Yolo26TrackerConfig config;
+    Track tracks[MaxTracks];
+    int next_id = 1;
+
+    static float height_of(const Track& t) {
+        return std::max(t.kf[COORD_H].pos, 1.0f);
+    }
+
+    void predict_track(Track& t, int64_t t_us) const {
+        float dt = (t_us - t.t_us) * 1e-6f;
+        if (dt <= 0.0f) return;
+        float ha = config.accel_std * height_of(t);
+        for (auto& kf : t.kf) kf.predict(dt, ha * ha);
+        t.kf[COORD_W].pos = std::max(t.kf[COORD_W].pos, 1.0f);
+        t.kf[COORD_H].pos = std::max(t.kf[COORD_H].pos, 1.0f);
+        t.t_us = t_us;
+    }
+
+    void correct_track(Track& t, const Detection& d) {
+        float z[COORDS] = {(d.x1 + d.x2) * 0.5f, (d.y1 + d.y2) * 0.5f, d.x2 - d.x1, d.y2 - d.y1};
+        float hr = config.meas_std * std::max(z[COORD_H], 1.0f);
+        for (int c = 0; c < COORDS; c++) t.kf[c].update(z[c], hr * hr);
+        t.score = d.score;
+        t.hits++;
+        t.lost = 0;
+        t.seen_us = t.t_us;
+    }
+
+    void start_track(Track& t, const Detection& d, int64_t t_us) {
+        float z[COORDS] = {(d.x1 + d.x2) * 0.5f, (d.y1 + d.y2) * 0.5f, d.x2 - d.x1, d.y2 - d.y1};
+        float h = std::max(z[COORD_H], 1.0f);
+        float pos_std = 2.0f * config.meas_std * h;
+        float vel_std = h; // Up to about one box height per second before the second match
+        for (int c = 0; c < COORDS; c++) t.kf[c].init(z[c], pos_std * pos_std, vel_std * vel_std);
+        t.id = next_id++;
+        t.class_id = d.class_id;
+        t.score = d.score;
+        t.hits = 1;
+        t.lost = 0;
+        t.t_us = t.seen_us = t_us;
+        t.active = true;
+    }
+
+    static Detection box_of(const Track& t) {
+        float cx = t.kf[COORD_CX].pos, cy = t.kf[COORD_CY].pos;
+        float hw = t.kf[COORD_W].pos * 0.5f, hh = t.kf[COORD_H].pos * 0.5f;
+        return {cx - hw, cy - hh, cx + hw, cy + hh, t.score, t.class_id};
+    }
+
+    bool is_confirmed(const Track& t) const {
+        return t.active && t.hits >= config.min_hits;
+    }
+
+    /**
+     * @brief Greedy IoU matching of detections with score in [lo, hi) against the tracks that pass
+     * `tracked_only`. Matched tracks are corrected and the detection is marked as used.
+     */
+    void associate(const Detection* dets, int n, bool* used, bool* matched, float lo, float hi, float min_iou, bool tracked_only) {
+        for (;;) {
+            float best = min_iou;
+            int best_t = -1, best_d = -1;
+            for (int ti = 0; ti < MaxTracks; ti++) {
+                const Track& t = tracks[ti];
+                if (!t.active || matched[ti] || (tracked_only && t.lost > 0)) continue;
+                Detection pred = box_of(t);
+                for (int di = 0; di < n; di++) {
+                    const Detection& d = dets[di];
+                    if (used[di] || d.score < lo || d.score >= hi || d.class_id != t.class_id) continue;
+                    float iou = yolo26_iou(pred, d);
+                    if (iou >= best) {
+                        best = iou;
+                        best_t = ti;
+                        best_d = di;
+                    }
+                }
+            }
+            if (best_t < 0) return;
+            correct_track(tracks[best_t], dets[best_d]);
+            matched[best_t] = true;
+            used[best_d] = true;
+        }
+    }
+
+public:
+    Yolo26TrackerT(const Yolo26TrackerConfig& cfg = Yolo26TrackerConfig()) : config(cfg) {
+        reset();
+    }
+
+    void reset() {
+        for (auto& t : tracks) t.active = false;
+        next_id = 1;
+    }
+
+    /**
+     * @brief Associates the detections of one inference (postprocess() order) with the tracks.
+     * @param t_us Capture timestamp of the inferred frame (e.g. esp_timer_get_time() at capture)
+     * @return Number of confirmed tracks matched in this update
+     */
+    int update(const Detection* dets, int n, int64_t t_us) {
+        n = std::min(n, YOLO_TRACK_MAX_DETS);
+        bool used[YOLO_TRACK_MAX_DETS] = {};
+        bool matched[MaxTracks] = {};
+        for (auto& t : tracks) {
+            if (t.active) predict_track(t, t_us);
+        }
+
+        associate(dets, n, used, matched, config.high_thresh, 2.0f, config.high_iou, false);
+        associate(dets, n, used, matched, -1.0f, config.high_thresh, config.low_iou, true);
+
+        for (int ti = 0; ti < MaxTracks; ti++) {
+            Track& t = tracks[ti];
+            if (!t.active || matched[ti]) continue;
+            // Tentative tracks get no second chance; confirmed ones coast up to max_lost updates
+            if (t.hits < config.min_hits || ++t.lost > config.max_lost) t.active = false;
+        }
+
+        for (int di = 0; di < n; di++) {
+            if (used[di] || dets[di].score < config.new_thresh) continue;
+            Track* slot = nullptr;
+            for (auto& t : tracks) {
+                if (!t.active) {
+                    slot = &t;
+                    break;
+                }
+            }
+            if (!slot) break; // Pool full: the rest wait for a free slot
+            start_track(*slot, dets[di], t_us);
+        }
+
+        int visible = 0;
+        for (int ti = 0; ti < MaxTracks; ti++) {
+            if (matched[ti] && is_confirmed(tracks[ti])) visible++;
+        }
+        return visible;
+    }
+
+    int update(const std::vector<Detection>& dets, int64_t t_us) {
+        return update(dets.data(), (int)dets.size(), t_us);
+    }
+
+    /**
+     * @brief Confirmed tracks extrapolated to `t_us`, which may lie between inferences.
+     * Tracks missed in the last update are included while they coast; extrapolation stops
+     * max_extrapolate_ms after a track's last matched detection.
+     * @return Number of boxes written to `out` (at most `cap`)
+     */
+    int predict(int64_t t_us, Yolo26TrackedBox* out, int cap) const {
+        int count = 0;
+        int64_t horizon_us = (int64_t)config.max_extrapolate_ms * 1000;
+        for (const Track& src : tracks) {
+            if (count >= cap) break;
+            if (!is_confirmed(src)) continue;
+            Track t = src;
+            predict_track(t, std::min(t_us, t.seen_us + horizon_us));
+            out[count++] = {box_of(t), t.id, t.kf[COORD_CX].vel, t.kf[COORD_CY].vel};
+        }
+        return count;
+    }
+
+    /**
+     * @brief Number of occupied pool slots (tentative, confirmed and coasting tracks).
+     */
+    int get_active_count() const {
+        int n = 0;
+        for (const Track& t : tracks) n += t.active ? 1 : 0;
+        return n;
+    }
+};
+
+using Yolo26Tracker = Yolo26TrackerT<>;
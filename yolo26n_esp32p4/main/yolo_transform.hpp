@@ -0,0 +1,85 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+// Source frame <-> model input geometry.
+//
+// Stretch fills the whole model input and distorts the aspect ratio. Letterbox scales the
+// frame uniformly so it fits, centres it and pads the remaining border with a neutral grey
+// (the value the model was trained with), so a 16:9 camera frame keeps its proportions.
+
+#define YOLO_LETTERBOX_PAD 114 // Neutral pad value (uint8, before quantization)
+
+enum Yolo26ResizeMode {
+    YOLO_RESIZE_STRETCH = 0,  // Scale each axis independently to the model input
+    YOLO_RESIZE_LETTERBOX,    // Preserve aspect ratio, pad the border
+};
+
+/**
+ * @brief Rectangle in source frame pixels (tile / region of interest).
+ */
+struct Yolo26Rect {
+    int x, y, w, h;
+};
+
+/**
+ * @brief Where one source frame (or a region of it) landed inside the model input.
+ * model = roi_x + source * scale_x (same for y). Produced by resize() / decode_preprocess_jpeg()
+ * and passed to postprocess() to map boxes back to source pixels.
+ */
+struct Yolo26Transform {
+    int src_w = 0;          // Source frame / region size (0 = unmapped, boxes stay in model coordinates)
+    int src_h = 0;
+    int src_x = 0;          // Region origin in the full frame (tiles), added after clipping
+    int src_y = 0;
+    int roi_x = 0;          // Image region inside the model input; the rest is padding
+    int roi_y = 0;
+    int roi_w = 0;
+    int roi_h = 0;
+    float scale_x = 1.0f;   // Model pixels per source pixel (roi_w / src_w)
+    float scale_y = 1.0f;
+};
+
+inline Yolo26Transform yolo26_make_transform(int src_w, int src_h, int model_w, int model_h, Yolo26ResizeMode mode) {
+    Yolo26Transform xf;
+    xf.src_w = src_w;
+    xf.src_h = src_h;
+    if (src_w <= 0 || src_h <= 0) return xf;
+
+    if (mode == YOLO_RESIZE_LETTERBOX) {
+        float s = std::min((float)model_w / src_w, (float)model_h / src_h);
+        xf.roi_w = std::min(model_w, std::max(1, (int)std::lround(src_w * s)));
+        xf.roi_h = std::min(model_h, std::max(1, (int)std::lround(src_h * s)));
+        xf.roi_x = (model_w - xf.roi_w) / 2;
+        xf.roi_y = (model_h - xf.roi_h) / 2;
+    } else {
+        xf.roi_w = model_w;
+        xf.roi_h = model_h;
+    }
+    xf.scale_x = (float)xf.roi_w / src_w;
+    xf.scale_y = (float)xf.roi_h / src_h;
+    return xf;
+}
+
+/**
+ * @brief Transform for region `r` of a larger frame: boxes map back to full-frame pixels.
+ */
+inline Yolo26Transform yolo26_make_region_transform(const Yolo26Rect& r, int model_w, int model_h, Yolo26ResizeMode mode) {
+    Yolo26Transform xf = yolo26_make_transform(r.w, r.h, model_w, model_h, mode);
+    xf.src_x = r.x;
+    xf.src_y = r.y;
+    return xf;
+}
+
+/**
+ * @brief Maps a model-space box back to source pixels and clips it to the source frame (or region).
+ */
+inline void yolo26_unmap_box(const Yolo26Transform& xf, float& x1, float& y1, float& x2, float& y2) {
+    if (xf.src_w <= 0 || xf.src_h <= 0) return;
+    float inv_x = 1.0f / xf.scale_x;
+    float inv_y = 1.0f / xf.scale_y;
+    x1 = std::clamp((x1 - xf.roi_x) * inv_x, 0.0f, (float)xf.src_w) + xf.src_x;
+    x2 = std::clamp((x2 - xf.roi_x) * inv_x, 0.0f, (float)xf.src_w) + xf.src_x;
+    y1 = std::clamp((y1 - xf.roi_y) * inv_y, 0.0f, (float)xf.src_h) + xf.src_y;
+    y2 = std::clamp((y2 - xf.roi_y) * inv_y, 0.0f, (float)xf.src_h) + xf.src_y;
+}